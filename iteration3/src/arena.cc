@@ -13,25 +13,57 @@
 
 #include "src/arena.h"
 #include "src/arena_params.h"
+#include "src/controller_server.h"
+#include "src/metrics_recorder.h"
 
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
 NAMESPACE_BEGIN(csci3081);
 
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+/**
+ * @brief Add the far field of a sensor with a numerator of 1 to sensor.
+ */
+void AddFarField(Sensor * const sensor, double far_field) {
+  sensor->set_reading(sensor->get_reading() +
+    far_field * sensor->get_numerator_value());
+}
+
+}  // namespace
+
 /*******************************************************************************
  * Constructors/Destructor
  ******************************************************************************/
 Arena::Arena(const struct arena_params *const params)
     : x_dim_(params->x_dim),
       y_dim_(params->y_dim),
-      factory_(new EntityFactory),
+      factory_(new EntityFactory(params->seed)),
       robots_(),
       foods_(),
+      food_index_(x_dim_, y_dim_, FOOD_INDEX_CELL_SIZE),
+      nearby_foods_(),
+      light_sensor_range_(params->light_sensor_range),
+      food_sensor_range_(params->food_sensor_range),
+      analytic_lights_(params->analytic_lights),
+      far_field_correction_(params->far_field_correction),
+      light_index_(x_dim_, y_dim_, LIGHT_INDEX_CELL_SIZE),
       entities_(),
       mobile_entities_(),
       light_entities_(),
-      game_status_(PLAYING) {
+      engine_(&robots_, &light_entities_, &foods_),
+      game_status_(PLAYING),
+      light_occlusion_(params->light_occlusion),
+      occlusion_cache_(params->occlusion_tolerance) {
+  engine_.set_ghosts(ghost_robots_.get_ghosts(), ghost_lights_.get_ghosts(),
+    ghost_foods_.get_ghosts());
+  engine_.set_broadphase(params->broadphase);
+  set_obstacles(params->obstacles);
+  SetFarFields(LightSensor().get_falloff());
   AddRobot();
   AddEntity(kFood, params->n_Foods);
   AddEntity(kLight, params->n_Lights);
@@ -41,18 +73,18 @@ Arena::~Arena() {
   for (auto ent : entities_) {
     delete ent;
   } /* for(ent..) */
+  delete factory_;
 }
 
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
 void Arena::AddRobot() {
+  size_t first = entities_.size();
   for (int i = 0; i < N_ROBOTS; i++) {
-    Robot * robot_ = dynamic_cast<Robot *>(factory_->CreateEntity(kRobot));
-    robots_.push_back(robot_);
-    entities_.push_back(robot_);
-    mobile_entities_.push_back(robot_);
+    RegisterRobot(dynamic_cast<Robot *>(factory_->CreateEntity(kRobot)));
   }
+  PlaceEntities(first);
 
   // Now set the robot behaviors
   int i = 0;  // index into robot array
@@ -67,26 +99,126 @@ void Arena::AddRobot() {
   }
 }
 
+void Arena::RegisterRobot(Robot * robot) {
+  robots_.push_back(robot);
+  entities_.push_back(robot);
+  mobile_entities_.push_back(robot);
+
+  // a starving robot ends the simulation as soon as its starved event fires
+  robot->set_starved_callback([this](Robot *) { game_status_ = LOST; });
+  robot->set_timer_wheel(&timer_wheel_);
+  if (set_falloff_) {
+    set_falloff_(robot);
+  }
+}
+
 void Arena::AddEntity(EntityType type, int quantity) {
+  size_t first = entities_.size();
   for (int i = 0; i < quantity; i++) {
     ArenaEntity* entity = factory_->CreateEntity(type);
-    entities_.push_back(entity);
 
     if (type == kLight) {  // Lights are now mobile entities
-      Light * Light = dynamic_cast<csci3081::Light *>(entity);
-      mobile_entities_.push_back(Light);
-      light_entities_.push_back(Light);
-    } else if (type == kFood) {
-      Food * food = dynamic_cast<csci3081::Food *>(entity);
-      foods_.push_back(food);
+      Light * light = dynamic_cast<csci3081::Light *>(entity);
+      light->set_analytic(analytic_lights_);
+      RegisterLight(light);
+    } else {
+      entities_.push_back(entity);
     }
+    if (type == kFood) {
+      foods_.push_back(dynamic_cast<csci3081::Food *>(entity));
+    }
+  }
+  PlaceEntities(first);
+  // food is indexed where it was placed
+  if (type == kFood) {
+    for (size_t i = first; i < entities_.size(); ++i) {
+      food_index_.Insert(dynamic_cast<csci3081::Food *>(entities_[i]));
+    }
+  }
+}
+
+void Arena::PlaceEntities(size_t first) {
+  factory_->PlaceEntities(entities_, first, x_dim_, y_dim_, obstacles_);
+  // the sensors move with the robots
+  for (size_t i = first; i < entities_.size(); ++i) {
+    if (entities_[i]->get_type() == kRobot) {
+      Robot * robot = dynamic_cast<Robot *>(entities_[i]);
+      const Pose &pose = robot->get_pose();
+      robot->get_left_lightsensor()->setSensorPositionBasedOnRobotPosition(
+        pose);
+      robot->get_right_lightsensor()->setSensorPositionBasedOnRobotPosition(
+        pose);
+      robot->get_left_foodsensor()->setSensorPositionBasedOnRobotPosition(
+        pose);
+      robot->get_right_foodsensor()->setSensorPositionBasedOnRobotPosition(
+        pose);
+    }
+  }
+}
+
+void Arena::RegisterLight(Light * light) {
+  entities_.push_back(light);
+  mobile_entities_.push_back(light);
+  light_entities_.push_back(light);
+}
+
+void Arena::ReleaseRobot(Robot * robot) {
+  robots_.erase(std::remove(robots_.begin(), robots_.end(), robot),
+    robots_.end());
+  entities_.erase(std::remove(entities_.begin(), entities_.end(), robot),
+    entities_.end());
+  mobile_entities_.erase(std::remove(mobile_entities_.begin(),
+    mobile_entities_.end(), robot), mobile_entities_.end());
+  robot->set_starved_callback(nullptr);
+}
+
+void Arena::ReleaseLight(Light * light) {
+  light_entities_.erase(std::remove(light_entities_.begin(),
+    light_entities_.end(), light), light_entities_.end());
+  entities_.erase(std::remove(entities_.begin(), entities_.end(), light),
+    entities_.end());
+  mobile_entities_.erase(std::remove(mobile_entities_.begin(),
+    mobile_entities_.end(), light), mobile_entities_.end());
+}
+
+void Arena::AddGhost(EntityType type, const Pose &pose, double radius) {
+  switch (type) {
+    case kRobot:
+      ghost_robots_.Add(pose, radius);
+      break;
+    case kLight:
+      ghost_lights_.Add(pose, radius);
+      break;
+    case kFood:
+      // ghost food is indexed so robots near the border can eat it
+      food_index_.Insert(ghost_foods_.Add(pose, radius));
+      break;
+    default:
+      break;
+  }
+}
+
+void Arena::ClearGhosts() {
+  for (auto food : *ghost_foods_.get_ghosts()) {
+    food_index_.Remove(food);
   }
+  ghost_robots_.Clear();
+  ghost_lights_.Clear();
+  ghost_foods_.Clear();
+}
+
+size_t Arena::get_ghost_count() {
+  return ghost_robots_.get_ghosts()->size() +
+    ghost_lights_.get_ghosts()->size() + ghost_foods_.get_ghosts()->size();
 }
 
 void Arena::Reset() {
   for (auto ent : entities_) {
     ent->Reset();
   } /* for(ent..) */
+  PlaceEntities(0);
+  // resetting food moves it
+  food_index_.Rebuild(foods_);
   game_status_ = PLAYING;
 } /* reset() */
 
@@ -100,81 +232,74 @@ void Arena::AdvanceTime(double dt) {
   }
   for (size_t i = 0; i < 1; ++i) {
     UpdateEntitiesTimestep();
+    if (metrics_recorder_) {
+      metrics_recorder_->Record(this);
+    }
   } /* for(i..) */
 } /* AdvanceTime() */
 
 void Arena::UpdateEntitiesTimestep() {
+  step_stats_.collisions = 0;
+  step_stats_.meals = 0;
+  step_stats_.occlusion_rays = 0;
+  step_stats_.occlusion_cache_hits = 0;
+  step_stats_.occluded_readings = 0;
+
+  // fire any timed events (e.g. hunger transitions) that are due this step
+  timer_wheel_.Advance(step_size_);
+
+  if (light_sensor_range_ > 0) {
+    // the lights moved last timestep, and the ghosts were replaced
+    light_index_.Rebuild(light_entities_);
+    for (auto ghost : *ghost_lights_.get_ghosts()) {
+      light_index_.Insert(ghost);
+    }
+  }
+
   // notify all the sensors within the robots of all the items they
   // are supposed to sense
-  for (auto &robot : robots_) {
-    for (auto light : light_entities_) {
-      robot->get_left_lightsensor()->Notify(light->get_pose());
-      robot->get_right_lightsensor()->Notify(light->get_pose());
-    }
-    for (auto food : foods_) {
-      robot->get_left_foodsensor()->Notify(food->get_pose());
-      robot->get_right_foodsensor()->Notify(food->get_pose());
-    }
+  engine_.Sense(this);
+  if (controller_server_) {
+    controller_server_->Exchange(this);
   }
 
   /*
-   * First, update the position of all entities, according to their current
-   * velocities.
-   * @TODO: Should this be just the mobile entities ??
+   * First, update the position of all mobile entities, according to their
+   * current velocities. Immobile entities (food) never change, and entities
+   * that are asleep are skipped until they wake up.
    */
-  for (auto ent : entities_) {
-    ent->TimestepUpdate(1);
-  }
-
-  for (auto ent : entities_) {
-    if (ent->get_type() == kLight) {
-      Light * Light = dynamic_cast<csci3081::Light *>(ent);
-      Light->set_time(Light->get_time() + time_);
-    }
+  step_stats_.active_entities = 0;
+  step_stats_.deferred_entities = 0;
+  step_stats_.sleeping_entities = 0;
+  step_stats_.static_entities = 0;
+  engine_.Update(step_size_, &step_stats_);
+
+  for (auto light : light_entities_) {
+    light->set_time(light->get_time() + time_);
   }
 
-  // Check if any robots are starved
-  for (auto &robot : robots_) {
-    if (robot->get_starved())
-      game_status_ = LOST;   // loss is indicated by game_status_ == 1
-  }
+  // Move entities back to the first contact along their motion this step
+  SweepCollisions();
 
-   /* Determine if any mobile entity is colliding with wall.
-   * Adjust the position accordingly so it doesn't overlap.
+  /* Determine if any mobile entity that moved is still colliding with wall
+   * or with an entity it collides with (e.g. it started the step
+   * overlapping). Adjust the position accordingly so they don't overlap.
    */
-  for (auto &ent1 : mobile_entities_) {
-    EntityType wall = GetCollisionWall(ent1);
-    if (kUndefined != wall) {
-      AdjustWallOverlap(ent1, wall);
-      if (ent1->get_type() == kRobot) {
-        Robot * robot = dynamic_cast<Robot *>(ent1);
-        robot->HandleCollision(wall);
-      } else if (ent1->get_type() == kLight) {
-        // Light* Light = ;
-        dynamic_cast<Light *>(ent1)->HandleCollision(wall);
-      }
-    }
-    /* Determine if that mobile entity is colliding with any other entity.
-    * Adjust the position accordingly so they don't overlap.
-    */
-    for (auto &ent2 : entities_) {
-      if (ent2 == ent1) { continue; }
-      if (ent1->get_type() == kRobot && ent2->get_type() == kFood) {
-        // if robot is within 5 pixels (distance) of a food object, hunger
-        // should be reset
-        Robot * robot = dynamic_cast<Robot *>(ent1);
-        checkRobotCollideFood(robot, ent2);
-      }
-      if (IsColliding(ent1, ent2)) {
-        AdjustEntityOverlap(ent1, ent2);
-        if (ent1->get_type() == kRobot) {
-          Robot * robot = dynamic_cast<Robot *>(ent1);
-          robot->HandleCollision(ent2->get_type(), ent2);
-        } else if (ent1->get_type() == kLight) {
-          dynamic_cast<Light *>(ent1)->
-            HandleCollision(ent2->get_type(), ent2);
-        }
-      }
+  engine_.ResolveOverlaps(this, &step_stats_);
+
+  // if robot is within 5 pixels (distance) of a food object, hunger should
+  // be reset. Sleeping robots still eat. Only the food near the robot's
+  // motion this step is checked.
+  for (auto &robot : robots_) {
+    const Pose &start = robot->get_step_start_pose();
+    const Pose &end = robot->get_pose();
+    double reach = robot->get_radius() + Food_RADIUS + PIXEL_OFFSET;
+    nearby_foods_.clear();
+    food_index_.QueryBox(std::min(start.x, end.x) - reach,
+      std::min(start.y, end.y) - reach, std::max(start.x, end.x) + reach,
+      std::max(start.y, end.y) + reach, &nearby_foods_);
+    for (auto &food : nearby_foods_) {
+      checkRobotCollideFood(robot, food);
     }
   }
 }  // UpdateEntitiesTimestep()
@@ -182,62 +307,214 @@ void Arena::UpdateEntitiesTimestep() {
 void Arena::checkRobotCollideFood(Robot * robot, ArenaEntity * food) {
   Pose robotPos = robot->get_pose();
   Pose foodPos = food->get_pose();
-
-  double distance = sqrt(pow(robotPos.x - foodPos.x, 2) +
-    pow(robotPos.y - foodPos.y, 2));
-
-  if (distance <= robot->get_radius() + food->get_radius() + PIXEL_OFFSET) {
-    robot->set_hungry(false);
-    robot->set_starving(false);
+  double reach = robot->get_radius() + food->get_radius() + PIXEL_OFFSET;
+
+  double delta_x = robotPos.x - foodPos.x;
+  double delta_y = robotPos.y - foodPos.y;
+  bool eaten = delta_x * delta_x + delta_y * delta_y <= reach * reach;
+  if (!eaten) {
+    // the robot may have passed over the food during the step
+    eaten = SweptCircleTimeOfImpact(robot->get_step_start_pose(), robotPos,
+      foodPos, foodPos, reach) >= 0;
+  }
+  // a robot that is not hungry only tops up; lingering at the food is
+  // not a meal on every step
+  if (eaten && robot->Eat()) {
+    ++step_stats_.meals;
   }
 }  // checkRobotCollideFood()
 // Determine if the entity is colliding with a wall.
 // Always returns an entity type. If not collision, returns kUndefined.
 EntityType Arena::GetCollisionWall(ArenaMobileEntity *const ent) {
-  if (ent->get_pose().x + ent->get_radius() >= x_dim_) {
+  if (get_wall_enabled(kRightWall) &&
+      ent->get_pose().x + ent->get_radius() >= x_dim_) {
     return kRightWall;  // at x = x_dim_
-  } else if (ent->get_pose().x - ent->get_radius() <= 0) {
+  } else if (get_wall_enabled(kLeftWall) &&
+      ent->get_pose().x - ent->get_radius() <= 0) {
     return kLeftWall;  // at x = 0
-  } else if (ent->get_pose().y + ent->get_radius() >= y_dim_) {
+  } else if (get_wall_enabled(kBottomWall) &&
+      ent->get_pose().y + ent->get_radius() >= y_dim_) {
     return kBottomWall;  // at y = y_dim
-  } else if (ent->get_pose().y - ent->get_radius() <= 0) {
+  } else if (get_wall_enabled(kTopWall) &&
+      ent->get_pose().y - ent->get_radius() <= 0) {
     return kTopWall;  // at y = 0
+  } else if (obstacles_ && IsTouchingObstacle(ent)) {
+    return kObstacle;
   } else {
     return kUndefined;
   }
 }  /* GetCollisionWall() */
 
+unsigned int Arena::GetCollisionWalls(ArenaMobileEntity *const ent) {
+  const Pose &pose = ent->get_pose();
+  double radius = ent->get_radius();
+  unsigned int walls = 0;
+  if (get_wall_enabled(kRightWall) && pose.x + radius >= x_dim_) {
+    walls |= 1u << kRightWall;
+  }
+  if (get_wall_enabled(kLeftWall) && pose.x - radius <= 0) {
+    walls |= 1u << kLeftWall;
+  }
+  if (get_wall_enabled(kBottomWall) && pose.y + radius >= y_dim_) {
+    walls |= 1u << kBottomWall;
+  }
+  if (get_wall_enabled(kTopWall) && pose.y - radius <= 0) {
+    walls |= 1u << kTopWall;
+  }
+  if (obstacles_ && IsTouchingObstacle(ent)) {
+    walls |= 1u << kObstacle;
+  }
+  return walls;
+}  /* GetCollisionWalls() */
+
+bool Arena::IsTouchingObstacle(ArenaMobileEntity *const ent) const {
+  std::vector<uint32_t> touched;
+  obstacles_->QueryCircle(ent->get_pose().x, ent->get_pose().y,
+    ent->get_radius(), &touched);
+  return !touched.empty();
+}
+
+EntityType Arena::GetSweptCollisionWall(ArenaMobileEntity *const ent,
+    double * toi) {
+  const Pose &start = ent->get_step_start_pose();
+  const Pose &end = ent->get_pose();
+  double radius = ent->get_radius();
+  // the limits of the entity's center for each wall, as in GetCollisionWall
+  double limits[] = {x_dim_ - radius, radius, y_dim_ - radius, radius};
+  EntityType walls[] = {kRightWall, kLeftWall, kBottomWall, kTopWall};
+
+  EntityType first_wall = kUndefined;
+  *toi = 2;
+  for (int i = 0; i < 4; ++i) {
+    if (!get_wall_enabled(walls[i])) {
+      continue;
+    }
+    bool horizontal = (i < 2);
+    double t = SweptLimitTimeOfImpact(
+      horizontal ? start.x : start.y, horizontal ? end.x : end.y,
+      limits[i], i % 2 == 0);
+    if (t >= 0 && t < *toi) {
+      *toi = t;
+      first_wall = walls[i];
+    }
+  }
+
+  if (obstacles_) {
+    size_t segment;
+    double t = obstacles_->SweepCircle(start, end, radius, &segment);
+    if (t >= 0 && t < *toi) {
+      *toi = t;
+      first_wall = kObstacle;
+    }
+  }
+  return first_wall;
+}  /* GetSweptCollisionWall() */
+
 /* The entity type indicates which wall the entity is colliding with.
 * This determines which way to move the entity to set it slightly off the wall. */
 void Arena::AdjustWallOverlap(ArenaMobileEntity *const ent, EntityType object) {
   Pose entity_pos = ent->get_pose();
   switch (object) {
     case (kRightWall):  // at x = x_dim_
-    ent->set_position(x_dim_-(ent->get_radius()+5), entity_pos.y);
+    ent->set_position(x_dim_-(ent->get_radius()+COLLISION_SKIN),
+      entity_pos.y);
     break;
     case (kLeftWall):  // at x = 0
-    ent->set_position(ent->get_radius()+5, entity_pos.y);
+    ent->set_position(ent->get_radius()+COLLISION_SKIN, entity_pos.y);
     break;
     case (kTopWall):  // at y = 0
-    ent->set_position(entity_pos.x, ent->get_radius()+5);
+    ent->set_position(entity_pos.x, ent->get_radius()+COLLISION_SKIN);
     break;
     case (kBottomWall):  // at y = y_dim_
-    ent->set_position(entity_pos.x, y_dim_-(ent->get_radius()+5));
+    ent->set_position(entity_pos.x,
+      y_dim_-(ent->get_radius()+COLLISION_SKIN));
+    break;
+    case (kObstacle):
+    obstacles_->Separate(&entity_pos, ent->get_radius(), COLLISION_SKIN);
+    ent->set_position(entity_pos.x, entity_pos.y);
     break;
     default:
     {}
   }
 }
 
-/* Calculates the distance between the center points to determine overlap */
+/* Compares the squared distance between the center points with the squared
+ * sum of the radii, which avoids a sqrt for every pair */
 bool Arena::IsColliding(
   ArenaMobileEntity * const mobile_e,
   ArenaEntity * const other_e) {
     double delta_x = other_e->get_pose().x - mobile_e->get_pose().x;
     double delta_y = other_e->get_pose().y - mobile_e->get_pose().y;
-    double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
-    return
-    (distance_between <= (mobile_e->get_radius() + other_e->get_radius()));
+    double reach = mobile_e->get_radius() + other_e->get_radius();
+    return delta_x*delta_x + delta_y*delta_y <= reach*reach;
+}
+
+bool Arena::IsSensing(Robot * const robot, Light * const) const {
+  return robot->IsUpdateDue() &&
+    (controller_server_ != nullptr || robot->IsSensingLight());
+}
+
+bool Arena::IsSensing(Robot * const robot, Food * const) const {
+  return robot->IsUpdateDue() &&
+    (controller_server_ != nullptr || robot->IsSensingFood());
+}
+
+void Arena::Sense(Robot * const robot, Light * const light) {
+  Sensor *left = robot->get_left_lightsensor();
+  Sensor *right = robot->get_right_lightsensor();
+  bool left_visible = true;
+  bool right_visible = true;
+  if (obstacles_ && light_occlusion_) {
+    occlusion_cache_.GetVisibility(*obstacles_, robot, light,
+      left->get_position(), right->get_position(), light->get_pose(),
+      &left_visible, &right_visible, &step_stats_);
+  }
+  if (left_visible) {
+    left->Notify(light->get_pose());
+  }
+  if (right_visible) {
+    right->Notify(light->get_pose());
+  }
+}
+
+void Arena::Sense(Robot * const robot, Food * const food) {
+  robot->get_left_foodsensor()->Notify(food->get_pose());
+  robot->get_right_foodsensor()->Notify(food->get_pose());
+}
+
+bool Arena::SenseInRange(Robot * const robot, Light * const) {
+  if (!(light_sensor_range_ > 0)) {
+    return false;
+  }
+  nearby_lights_.clear();
+  light_index_.QueryRange(robot->get_pose(), light_sensor_range_,
+    &nearby_lights_);
+  for (auto light : nearby_lights_) {
+    Sense(robot, light);
+  }
+  double far_field = light_far_field_ * (light_entities_.size() +
+    ghost_lights_.get_ghosts()->size() - nearby_lights_.size());
+  AddFarField(robot->get_left_lightsensor(), far_field);
+  AddFarField(robot->get_right_lightsensor(), far_field);
+  return true;
+}
+
+bool Arena::SenseInRange(Robot * const robot, Food * const) {
+  if (!(food_sensor_range_ > 0)) {
+    return false;
+  }
+  nearby_foods_.clear();
+  food_index_.QueryRange(robot->get_pose(), food_sensor_range_,
+    &nearby_foods_);
+  for (auto food : nearby_foods_) {
+    Sense(robot, food);
+  }
+  // the index holds the food and the ghost food
+  double far_field = food_far_field_ *
+    (food_index_.get_size() - nearby_foods_.size());
+  AddFarField(robot->get_left_foodsensor(), far_field);
+  AddFarField(robot->get_right_foodsensor(), far_field);
+  return true;
 }
 
 /* This is called when it is known that the two entities overlap.
@@ -246,43 +523,31 @@ bool Arena::IsColliding(
 */
 /* @TODO: Add functionality to Pose to determine the distance distance_between
    two instances (e.g. overload operator -) */
-/* @BUG: The robot will pass through the home Food on occasion. The problem
- * is likely due to the adjustment being in the wrong direction. This could
- * be because the cos/sin generate the wrong sign of the distance_to_move
- * when the collision is in a specific quadrant relative to the center of the
- * colliding entities..
+/* Contacts made during a step are already resolved by SweepCollisions(), so
+ * this only separates entities that were overlapping to begin with.
  */
 void Arena::AdjustEntityOverlap(ArenaMobileEntity * const mobile_e,
   ArenaEntity *const other_e) {
-    bool adjustOverlap = true;  // whether to adjust overlap or not
-    /* Lights only collide with other lights and the wall,
-       Robots only collide with other robots and the wall */
-    if (mobile_e->get_type() == kLight && !(other_e->get_type() == kLight ||
-        other_e->get_type() == kTopWall ||
-        other_e->get_type() == kBottomWall ||
-        other_e->get_type() == kLeftWall ||
-        other_e->get_type() == kRightWall)) {
-      adjustOverlap = false;
-    } else if (mobile_e->get_type() == kRobot &&
-        !(other_e->get_type() == kRobot ||
-        other_e->get_type() == kTopWall ||
-        other_e->get_type() == kBottomWall ||
-        other_e->get_type() == kLeftWall ||
-        other_e->get_type() == kRightWall)) {
-      adjustOverlap = false;
+    /* Only entities that collide per the interaction table (e.g. robots
+       with robots and walls) are moved */
+    if (GetInteraction(mobile_e->get_type(), other_e->get_type()) ==
+        kCollide) {
+      SeparateEntities(mobile_e, other_e);
     }
+}
 
-    if (adjustOverlap) {
-      double delta_x = mobile_e->get_pose().x - other_e->get_pose().x;
-      double delta_y = mobile_e->get_pose().y - other_e->get_pose().y;
-      double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
-      double distance_to_move =
-        mobile_e->get_radius() + other_e->get_radius() - distance_between + 5;
-      double angle = atan2(delta_y, delta_x);
-      mobile_e->set_position(
-        mobile_e->get_pose().x+cos(angle)*distance_to_move,
-        mobile_e->get_pose().y+sin(angle)*distance_to_move);
-    }
+void Arena::SeparateEntities(ArenaMobileEntity * const mobile_e,
+    ArenaEntity * const other_e) {
+  double delta_x = mobile_e->get_pose().x - other_e->get_pose().x;
+  double delta_y = mobile_e->get_pose().y - other_e->get_pose().y;
+  double distance_between = sqrt(delta_x*delta_x + delta_y*delta_y);
+  double distance_to_move =
+    mobile_e->get_radius() + other_e->get_radius() - distance_between +
+    COLLISION_SKIN;
+  double angle = atan2(delta_y, delta_x);
+  mobile_e->set_position(
+    mobile_e->get_pose().x+cos(angle)*distance_to_move,
+    mobile_e->get_pose().y+sin(angle)*distance_to_move);
 }
 
 // Accept communication from the controller. Dispatching as appropriate.
@@ -384,6 +649,7 @@ void Arena::AcceptGUIParameters(int robotFearCount, int robotExploreCount,
 
       Food * food = foods_.front();  // food to remove, keep ptr
       foods_.erase(foods_.begin());
+      food_index_.Remove(food);
 
       // remove this food from entities and mobileentities vector
       for (unsigned int j = 0; j < entities_.size() && !removed; j++)
@@ -447,23 +713,17 @@ void Arena::AcceptGUIParameters(int robotFearCount, int robotExploreCount,
           removed = true;
         }
 
-      delete fearRobot->get_left_lightsensor();
-      delete fearRobot->get_right_lightsensor();
-      delete fearRobot->get_left_foodsensor();
-      delete fearRobot->get_right_foodsensor();
+      // the robot deletes its sensors
       delete fearRobot;
     }
   } else if (numFearRobots < robotFearCount) {  // need to add robots
     int numAddFearRobots = robotFearCount - numFearRobots;
 
+    size_t first = entities_.size();
     for (int i = 0; i < numAddFearRobots; i++) {
-      ArenaEntity* entity = factory_->CreateEntity(kRobot);
-      entities_.push_back(entity);
-
-      Robot * fearRobot = dynamic_cast<csci3081::Robot *>(entity);
-      mobile_entities_.push_back(fearRobot);
-      robots_.push_back(fearRobot);
+      RegisterRobot(dynamic_cast<Robot *>(factory_->CreateEntity(kRobot)));
     }
+    PlaceEntities(first);
   }
 
   // update explore robots
@@ -501,23 +761,17 @@ void Arena::AcceptGUIParameters(int robotFearCount, int robotExploreCount,
           removed = true;
         }
 
-      delete ExploreRobot->get_left_lightsensor();
-      delete ExploreRobot->get_right_lightsensor();
-      delete ExploreRobot->get_left_foodsensor();
-      delete ExploreRobot->get_right_foodsensor();
+      // the robot deletes its sensors
       delete ExploreRobot;
     }
   } else if (numExploreRobots < robotExploreCount) {  // need to add robots
     int numAddExploreRobots = robotExploreCount - numExploreRobots;
 
+    size_t first = entities_.size();
     for (int i = 0; i < numAddExploreRobots; i++) {
-      ArenaEntity* entity = factory_->CreateEntity(kRobot);
-      entities_.push_back(entity);
-
-      Robot * exploreRobot = dynamic_cast<csci3081::Robot *>(entity);
-      mobile_entities_.push_back(exploreRobot);
-      robots_.push_back(exploreRobot);
+      RegisterRobot(dynamic_cast<Robot *>(factory_->CreateEntity(kRobot)));
     }
+    PlaceEntities(first);
   }
 }
 
@@ -11,15 +11,26 @@
  * Includes
  ******************************************************************************/
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <vector>
 
 #include "src/common.h"
+#include "src/entity_index.h"
 #include "src/food.h"
+#include "src/food_index.h"
+#include "src/ghost_pool.h"
 #include "src/entity_factory.h"
+#include "src/interaction_table.h"
+#include "src/obstacle_map.h"
+#include "src/occlusion_cache.h"
 #include "src/robot.h"
 #include "src/communication.h"
 #include "src/robot_type.h"
+#include "src/step_engine.h"
+#include "src/step_stats.h"
+#include "src/swept_collision.h"
+#include "src/timer_wheel.h"
 
 /*******************************************************************************
  * Namespaces
@@ -30,6 +41,8 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 struct arena_params;
+class ControllerServer;
+class MetricsRecorder;
 
 /**
  * @brief The main class for the simulation of a 2D world with many entities
@@ -77,8 +90,62 @@ class Arena {
 
   void AddRobot();
 
+  /**
+   * @brief Put a newly created robot in the arena's robot, entity and mobile
+   * entity vectors and schedule its hunger events on the arena's TimerWheel.
+   */
+  void RegisterRobot(Robot * robot);
+
+  /**
+   * @brief Put a newly created light in the arena's light, entity and mobile
+   * entity vectors.
+   */
+  void RegisterLight(Light * light);
+
+  /**
+   * @brief Take a robot out of the arena without deleting it, e.g. to move it
+   * to another arena with RegisterRobot(). Its hunger events stay pending
+   * until it is registered again.
+   */
+  void ReleaseRobot(Robot * robot);
+
+  /**
+   * @brief Take a light out of the arena without deleting it.
+   */
+  void ReleaseLight(Light * light);
+
   void AddEntity(EntityType type, int quantity);
 
+  /**
+   * @brief Add a read-only copy of an entity owned by another arena (e.g. a
+   * neighboring tile). The arena's entities sense ghosts, are kept from
+   * overlapping them and robots can eat ghost food, but ghosts never move.
+   *
+   * @param type kRobot, kLight or kFood. Other types are ignored.
+   * @param pose Where the entity is, in this arena's coordinates.
+   * @param radius The entity's radius.
+   */
+  void AddGhost(EntityType type, const Pose &pose, double radius);
+
+  /**
+   * @brief Remove all ghosts.
+   */
+  void ClearGhosts();
+
+  size_t get_ghost_count();
+
+  /**
+   * @brief Turn a wall on or off. Entities pass through a wall that is off
+   * and leave the arena, e.g. into a neighboring tile. All walls are on by
+   * default.
+   *
+   * @param wall kRightWall, kLeftWall, kTopWall or kBottomWall.
+   */
+  void set_wall_enabled(EntityType wall, bool enabled) {
+    walls_enabled_[wall - kRightWall] = enabled; }
+  bool get_wall_enabled(EntityType wall) const {
+    return walls_enabled_[wall - kRightWall]; }
+
   /**
    * @brief
    */
@@ -94,7 +161,12 @@ class Arena {
    *
    * @return A vector of pointers to the Robots.
    */
-  std::vector<class Robot *> get_robots() const { return robots_; }
+  const std::vector<class Robot *> &get_robots() const { return robots_; }
+
+  const std::vector<class Light *> &get_lights() const {
+    return light_entities_; }
+
+  const std::vector<class Food *> &get_foods() const { return foods_; }
 
   /**
    * @brief Under certain circumstance, the compiler requires that the
@@ -123,8 +195,9 @@ class Arena {
     ArenaMobileEntity * const mobile_e, ArenaEntity * const other_e);
 
   /**
-  * @brief Checks if a robot is within 5 pixels of a food entity object
-  *        Then sets robot's flags accordingly.
+  * @brief Checks if a robot is within 5 pixels of a food entity object at any
+  *        point of its motion this timestep (not just where it ended up).
+  *        If it is, the robot eats, which reschedules its hunger events.
   **/
   void checkRobotCollideFood(Robot * robot, ArenaEntity * food);
 
@@ -140,8 +213,8 @@ class Arena {
    * the simulation (i.e. has collided with any one of the walls).
    *
    * @param ent The entity to check.
-   * @param [out] An entity type signifying wall (e.g. kRightWall). kUndefined
-   * if no collision.
+   * @param [out] An entity type signifying wall (e.g. kRightWall), or
+   * kObstacle if it overlaps only an obstacle. kUndefined if no collision.
    *
    * The checked entity's position will be updated to a "back-off position" so
    * that it won't get stuck into a wall. The calculation of the "back-off
@@ -149,19 +222,42 @@ class Arena {
    */
   EntityType GetCollisionWall(ArenaMobileEntity * const ent);
 
+  /**
+   * @brief Every wall the entity touches, where GetCollisionWall() only
+   * gives the first: an entity in a corner touches two walls, and one at
+   * the edge may touch an obstacle as well.
+   *
+   * @return A mask with bit (1 << wall) set for each wall touched (kObstacle
+   * for any obstacles), 0 if none.
+   */
+  unsigned int GetCollisionWalls(ArenaMobileEntity * const ent);
+
   /**
   * @brief Move the entity to the edge of the wall without overlap.
-  * Without this, entities tend to get stuck in walls.
+  * Without this, entities tend to get stuck in walls. For kObstacle, the
+  * entity is pushed out of every obstacle segment it touches.
   **/
   void AdjustWallOverlap(ArenaMobileEntity * const ent, EntityType wall);
 
+  /**
+   * @brief Continuous collision detection for the motion of this timestep.
+   *
+   * Every mobile entity is swept in a straight line from its step start pose
+   * to its current pose. The first wall it reaches and every robot-robot and
+   * light-light contact are found by time of impact, the entities are moved
+   * back to where the contact happened and the collision is handled. Fast
+   * entities (or large timesteps) therefore cannot tunnel through each other.
+   */
+  void SweepCollisions() { engine_.SweepCollisions(this, &step_stats_); }
+
   /**
    * @brief Update all entities for a single timestep.
    *
-   * First calls each entity's TimestepUpdate method to update their speed,
+   * First advances the TimerWheel, which fires any timed events that are due
+   * (a robot starving ends the game from its starved event). Then calls each
+   * awake mobile entity's TimestepUpdate method to update their speed,
    * heading angle, and position. Then check for collisions between entities
    * or between an entity and a wall.
-   * This function also checks for win/loss conditions.
    * Also passes the time_ to the robot by getting current time in robot and 
    * adding the current time so it could calculate invincibility.
    */
@@ -179,10 +275,160 @@ class Arena {
   double get_x_dim() { return x_dim_; }
   double get_y_dim() { return y_dim_; }
 
+  TimerWheel * get_timer_wheel() { return &timer_wheel_; }
+
+  /**
+   * @brief Counts of the work done in the last timestep (e.g. how many
+   * entities were active or asleep).
+   */
+  const StepStats &get_step_stats() const { return step_stats_; }
+
+  /**
+   * @brief Set the # of timesteps each call to UpdateEntitiesTimestep()
+   * advances entities by. Collisions are swept, so large steps do not let
+   * entities pass through each other.
+   */
+  void set_step_size(unsigned int step_size) { step_size_ = step_size; }
+  unsigned int get_step_size() const { return step_size_; }
+
+  /**
+   * @brief Set how the pairs of entities that may collide are found (see
+   * StepEngine::set_broadphase()). It does not change the results, only how
+   * long finding the collisions takes.
+   */
+  void set_broadphase(Broadphase broadphase) {
+    engine_.set_broadphase(broadphase); }
+  Broadphase get_broadphase() const { return engine_.get_broadphase(); }
+
+  /**
+   * @brief Measure the arena with recorder after every update. The recorder
+   * is not owned by the arena; pass NULL to stop recording.
+   */
+  void set_metrics_recorder(MetricsRecorder * recorder) {
+    metrics_recorder_ = recorder; }
+
+  /**
+   * @brief Let server exchange readings and wheel velocities with an
+   * external controller every update, between sensing and moving. The
+   * server is not owned by the arena; pass NULL to stop.
+   */
+  void set_controller_server(ControllerServer * server) {
+    controller_server_ = server; }
+
+  /**
+   * @brief Have the light and food sensors of every robot, also of robots
+   * added later, respond with falloff (see sensor_falloff.h) instead of the
+   * default PowerFalloff, and base the far field correction on it.
+   */
+  template <typename Falloff>
+  void set_sensor_falloff(const Falloff &falloff) {
+    set_falloff_ = [falloff](Robot *robot) {
+      robot->set_sensor_falloff(falloff); };
+    for (auto robot : robots_) {
+      set_falloff_(robot);
+    }
+    SetFarFields(falloff);
+  }
+
+  /**
+   * @brief Keep robots and lights out of the static obstacles, as they are
+   * kept in by the walls. The obstacles are not owned by the arena, are in
+   * arena coordinates and must be built; pass NULL to remove them.
+   */
+  void set_obstacles(const ObstacleMap * obstacles) {
+    obstacles_ = obstacles;
+    occlusion_cache_.Clear();
+  }
+  const ObstacleMap * get_obstacles() const { return obstacles_; }
+
+  /**
+   * @brief Whether the obstacles cast shadows: a light sensor is not
+   * notified of a light the obstacles block its line of sight to. On by
+   * default; it has no effect without obstacles.
+   */
+  void set_light_occlusion(bool occlusion) { light_occlusion_ = occlusion; }
+  bool get_light_occlusion() const { return light_occlusion_; }
+
   int get_game_status() const { return game_status_; }
   void set_game_status(int status) { game_status_ = status; }
 
  private:
+  template <typename... Types> friend class StepEngine;
+
+  /**
+   * @brief Move the mobile entity to the edge of the other, which it is
+   * known to overlap and to collide with.
+   */
+  void SeparateEntities(ArenaMobileEntity * const mobile_e,
+    ArenaEntity * const other_e);
+
+  /**
+   * @brief Whether the robot reads its light (food) sensors this step, so
+   * they need to be notified: it is due for an update and uses them (an
+   * external controller may read them all).
+   */
+  bool IsSensing(Robot * const robot, Light * const) const;
+  bool IsSensing(Robot * const robot, Food * const) const;
+
+  /**
+   * @brief Pass the position of an entity the robot senses to its sensors.
+   */
+  void Sense(Robot * const robot, Light * const light);
+  void Sense(Robot * const robot, Food * const food);
+
+  /**
+   * @brief Pass the lights (food) within the sensor range of the robot to
+   * its sensors, found with a neighbor query, plus the far field of the rest
+   * if corrected for.
+   *
+   * @return false if there is no range, so every light (food) is to be
+   * passed to Sense() instead.
+   */
+  bool SenseInRange(Robot * const robot, Light * const);
+  bool SenseInRange(Robot * const robot, Food * const);
+
+  /**
+   * @brief With far field correction, set the reading expected from each
+   * light (food) out of range for sensors that respond with falloff.
+   */
+  template <typename Falloff>
+  void SetFarFields(const Falloff &falloff) {
+    if (!far_field_correction_) {
+      return;
+    }
+    if (light_sensor_range_ > 0) {
+      light_far_field_ = MeanFarReading(falloff, x_dim_, y_dim_,
+        light_sensor_range_);
+    }
+    if (food_sensor_range_ > 0) {
+      food_far_field_ = MeanFarReading(falloff, x_dim_, y_dim_,
+        food_sensor_range_);
+    }
+  }
+
+  /**
+   * @brief The first wall reached by the entity's motion this timestep.
+   *
+   * @param ent The entity to sweep.
+   * @param[out] toi The time of impact, as a fraction of the step.
+   *
+   * @return The wall, kObstacle if an obstacle is reached first, or
+   * kUndefined if neither is reached.
+   */
+  EntityType GetSweptCollisionWall(ArenaMobileEntity * const ent,
+    double * toi);
+
+  /**
+   * @brief Whether the entity touches any segment of obstacles_.
+   */
+  bool IsTouchingObstacle(ArenaMobileEntity * const ent) const;
+
+  /**
+   * @brief Spawn entities_[first, end) where they overlap neither each
+   * other, the entities before them, nor the obstacles.
+   */
+  void PlaceEntities(size_t first);
+
   // Dimensions of graphics window inside which entities must operate
   double x_dim_;
   double y_dim_;
@@ -196,6 +442,35 @@ class Arena {
   // All the food entities to notify the food sensors of
   std::vector<class Food *> foods_;
 
+  // The same food, by position, to find the food a robot can reach
+  FoodIndex food_index_;
+
+  // Scratch space for food index queries, reused every timestep
+  std::vector<class Food *> nearby_foods_;
+
+  // Robots only sense the lights (food) this close to them, if non-zero
+  double light_sensor_range_;
+  double food_sensor_range_;
+
+  // New lights move along closed-form segments
+  bool analytic_lights_;
+
+  // Whether to add the readings of the lights (food) out of range
+  bool far_field_correction_;
+
+  // Gives a robot the sensors chosen with set_sensor_falloff(), if any
+  std::function<void(Robot *)> set_falloff_{};
+
+  // The reading of a sensor with a numerator of 1 expected from a light
+  // (food) out of range, or 0 to add none
+  double light_far_field_{0};
+  double food_far_field_{0};
+
+  // The lights and ghost lights by position, rebuilt every timestep when
+  // light sensors have a range
+  EntityIndex<Light> light_index_;
+  std::vector<class Light *> nearby_lights_{};
+
   // All entities mobile and immobile.
   std::vector<class ArenaEntity *> entities_;
 
@@ -205,9 +480,42 @@ class Arena {
   // A subset of the entities -- only Light objects
   std::vector<class Light *> light_entities_;
 
+  // Copies of entities owned by other arenas, near this one
+  GhostPool<Robot> ghost_robots_{};
+  GhostPool<Light> ghost_lights_{};
+  GhostPool<Food> ghost_foods_{};
+
+  // Whether each wall (indexed from kRightWall) keeps entities in
+  bool walls_enabled_[4]{true, true, true, true};
+
+  // Moves the robots and lights and handles their collisions, with a loop
+  // per type (and per pair of colliding types)
+  StepEngine<Robot, Light, Food> engine_;
+
   // win/lose/playing state
   int game_status_;
 
+  // Timed events for all entities, advanced once per timestep
+  TimerWheel timer_wheel_{};
+
+  // # of timesteps entities are advanced by per update
+  unsigned int step_size_{1};
+
+  StepStats step_stats_{};
+
+  // measures the arena after every update, if set
+  MetricsRecorder * metrics_recorder_{nullptr};
+
+  // drives robots from another process, if set
+  ControllerServer * controller_server_{nullptr};
+
+  // static obstacles entities collide with, if set
+  const ObstacleMap * obstacles_{nullptr};
+
+  // whether the obstacles block light, and the lines of sight last cast
+  bool light_occlusion_;
+  OcclusionCache occlusion_cache_;
+
   // current time within the simulation, no getters or setters
   double time_{0.0};
 };
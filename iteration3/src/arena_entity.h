@@ -79,7 +79,10 @@ class ArenaEntity {
 
 
   const Pose &get_pose() const { return pose_; }
-  void set_pose(const Pose &pose) { pose_ = pose; }
+  void set_pose(const Pose &pose) {
+    pose_ = pose;
+    ++pose_changes_;
+  }
 
   /**
    * @brief Setter method for position within entity pose variable.
@@ -87,12 +90,16 @@ class ArenaEntity {
   void set_position(const double inx, const double iny) {
     pose_.x = inx;
     pose_.y = iny;
+    ++pose_changes_;
   }
 
   /**
    * @brief Setter method for heading within entity pose variable.
    */
-  void set_heading(const double t) { pose_.theta = t; }
+  void set_heading(const double t) {
+    pose_.theta = t;
+    ++pose_changes_;
+  }
 
   /**
    * @brief Getter method for heading within entity pose variable.
@@ -108,8 +115,15 @@ class ArenaEntity {
    */
   void RelativeChangeHeading(const double delta) {
     pose_.theta += delta;
+    ++pose_changes_;
   }
 
+  /**
+   * @brief # of times the pose was set (wrapping around), so an entity can
+   * tell whether anything else moved it since it last set its pose.
+   */
+  unsigned int get_pose_changes() const { return pose_changes_; }
+
   const RgbColor &get_color() const { return color_; }
 
   void set_color(const RgbColor &color) { color_ = color; }
@@ -136,8 +150,8 @@ class ArenaEntity {
 
 
   /**
-  * @brief An attempt to not overlap any of the entities after starting a
-  * new game.
+  * @brief A random position on a 1024 x 768 grid, for an entity reset on its
+  * own. Arena::Reset() then places its entities without overlap.
   */
   Pose SetPoseRandomly() {
   // Dividing arena into 19x14 grid. Each grid square is 50x50
@@ -149,6 +163,7 @@ class ArenaEntity {
  private:
   double radius_{DEFAULT_RADIUS};
   Pose pose_;
+  unsigned int pose_changes_{0};
   RgbColor color_;
   EntityType type_{kEntity};
   int id_{-1};
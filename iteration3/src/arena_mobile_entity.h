@@ -58,8 +58,62 @@ class ArenaMobileEntity : public ArenaEntity {
   */
   SensorTouch * get_touch_sensor() { return sensor_touch_; }
 
+  /**
+   * @brief Getter for the pose the entity had at the start of the current
+   * timestep. Arena records it so it can sweep the entity's motion for
+   * collisions.
+   */
+  const Pose &get_step_start_pose() const { return step_start_pose_; }
+
+  void set_step_start_pose(const Pose &pose) { step_start_pose_ = pose; }
+
+  /**
+   * @brief Whether the entity can skip its update this timestep.
+   *
+   * An entity that is standing still and has nothing new to react to can
+   * sleep, and Arena then neither updates it nor checks it for collisions
+   * until it wakes up. Entities never sleep unless they override this.
+   */
+  virtual bool CanSkipTimestep() { return false; }
+
+  /**
+   * @brief Update the entity only once every `interval` timesteps, by the
+   * time of all of them (a lower level of detail, e.g. far from the view).
+   * 1, the default, updates it every timestep.
+   */
+  void set_update_interval(unsigned int interval) {
+    update_interval_ = interval > 0 ? interval : 1; }
+  unsigned int get_update_interval() const { return update_interval_; }
+
+  /**
+   * @brief Whether the entity is updated (and sensed) this timestep under
+   * its update interval.
+   */
+  bool IsUpdateDue() const { return deferred_steps_ + 1 >= update_interval_; }
+
+  /**
+   * @brief Count a timestep the entity was not updated in.
+   */
+  void DeferTimestep() { ++deferred_steps_; }
+
+  /**
+   * @brief The # of timesteps to update the entity by now: this one and the
+   * ones deferred since its last update.
+   */
+  unsigned int TakeDeferredSteps() {
+    unsigned int steps = deferred_steps_ + 1;
+    deferred_steps_ = 0;
+    return steps;
+  }
+
+  unsigned int get_deferred_steps() const { return deferred_steps_; }
+
  private:
   double speed_;
+  Pose step_start_pose_{};
+  unsigned int update_interval_{1};
+  // timesteps since the entity was last updated
+  unsigned int deferred_steps_{0};
 
  protected:
   // Using protected allows for direct access to sensor within entity.
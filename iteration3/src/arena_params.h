@@ -13,7 +13,9 @@
  ******************************************************************************/
 #include "src/common.h"
 #include "src/light.h"
+#include "src/obstacle_map.h"
 #include "src/params.h"
+#include "src/sweep_and_prune.h"
 
 /*******************************************************************************
  * Namespaces
@@ -34,6 +36,26 @@ struct arena_params {
   size_t n_Foods{N_FoodS};
   uint x_dim{ARENA_X_DIM};
   uint y_dim{ARENA_Y_DIM};
+  // seed for placing entities; 0 seeds from the clock
+  unsigned int seed{0};
+  // robots only sense the lights (food) within this distance of them; 0
+  // senses them at any distance
+  double light_sensor_range{0};
+  double food_sensor_range{0};
+  // with a range, add the reading expected from the lights (food) out of
+  // range, as if they were spread evenly over the arena
+  bool far_field_correction{false};
+  // how the pairs of entities that may collide are found
+  Broadphase broadphase{kBruteForce};
+  // lights move along closed-form segments (see Light::set_analytic())
+  bool analytic_lights{false};
+  // static obstacles, built and in arena coordinates, if any (see
+  // Arena::set_obstacles())
+  const ObstacleMap *obstacles{nullptr};
+  // whether the obstacles block light sensors' lines of sight, which are
+  // only cast again once an end moved further than occlusion_tolerance
+  bool light_occlusion{true};
+  double occlusion_tolerance{OCCLUSION_TOLERANCE};
 };
 
 NAMESPACE_END(csci3081);
@@ -0,0 +1,286 @@
+/**
+ * @file behavior_optimizer.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/behavior_optimizer.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+const int kParameters = ParametricBehavior::kParameters;
+// parameters 4 and 5 of a behavior are its biases
+bool IsBias(int gene) { return gene % kParameters >= 4; }
+
+// the largest light reading, which is also the bias of explore/love
+const double kMaxReading = 60.0;
+
+}  // namespace
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+BehaviorOptimizer::BehaviorOptimizer(const evolution_params &params)
+    : params_(params),
+      pool_(params.n_threads),
+      rng_(params.seed) {
+  params_.population_size = std::max(params_.population_size, 2u);
+  params_.elite_count = std::min(params_.elite_count,
+    params_.population_size);
+  params_.tournament_size = std::max(params_.tournament_size, 1u);
+  params_.trials = std::max(params_.trials, 1u);
+  best_.fitness = -1;
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void BehaviorOptimizer::Run(const GenerationCallback &callback) {
+  if (population_.empty()) {
+    Initialize();
+  }
+  while (generations_done_ < params_.generations) {
+    EvaluatePopulation();
+    std::stable_sort(population_.begin(), population_.end(),
+      [](const Individual &a, const Individual &b) {
+        return a.fitness > b.fitness; });
+    if (population_.front().fitness > best_.fitness) {
+      best_ = population_.front();
+    }
+    ++generations_done_;
+    if (callback) {
+      callback(generations_done_, population_);
+    }
+
+    // the checkpoint holds the next, not yet evaluated, population
+    Breed();
+    if (!params_.checkpoint_path.empty()) {
+      SaveCheckpoint(params_.checkpoint_path);
+    }
+  }
+}
+
+void BehaviorOptimizer::Initialize() {
+  population_.clear();
+  Individual fear;
+  fear.genome = FearGenome();
+  population_.push_back(fear);
+  while (population_.size() < params_.population_size) {
+    Individual individual;
+    individual.genome = RandomGenome();
+    population_.push_back(individual);
+  }
+}
+
+void BehaviorOptimizer::EvaluatePopulation() {
+  // genomes not in the cache, each only once
+  std::vector<Genome> unseen;
+  for (auto &individual : population_) {
+    if (fitness_cache_.count(individual.genome) == 0 &&
+        std::find(unseen.begin(), unseen.end(), individual.genome) ==
+        unseen.end()) {
+      unseen.push_back(individual.genome);
+    }
+  }
+
+  // every (genome, trial) pair is an independent arena
+  unsigned int trials = params_.trials;
+  std::vector<unsigned int> steps(unseen.size() * trials);
+  pool_.ParallelFor(steps.size(), [&](size_t i) {
+    steps[i] = EvaluateGenome(unseen[i / trials],
+      params_.seed + static_cast<unsigned int>(i % trials),
+      params_.max_steps);
+  });
+
+  for (size_t g = 0; g < unseen.size(); ++g) {
+    double total = 0;
+    for (unsigned int t = 0; t < trials; ++t) {
+      total += steps[g * trials + t];
+    }
+    fitness_cache_[unseen[g]] = total / trials;
+  }
+  for (auto &individual : population_) {
+    individual.fitness = fitness_cache_[individual.genome];
+  }
+}
+
+void BehaviorOptimizer::Breed() {
+  // population_ is sorted, best first
+  std::vector<Individual> next(population_.begin(),
+    population_.begin() + params_.elite_count);
+
+  std::uniform_real_distribution<double> chance(0.0, 1.0);
+  std::normal_distribution<double> mutation(0.0, params_.mutation_scale);
+  while (next.size() < params_.population_size) {
+    Individual child = SelectParent();
+    if (chance(rng_) < params_.crossover_rate) {
+      const Individual &other = SelectParent();
+      for (int gene = 0; gene < kGenes; ++gene) {
+        if (chance(rng_) < 0.5) {
+          child.genome[gene] = other.genome[gene];
+        }
+      }
+    }
+    for (int gene = 0; gene < kGenes; ++gene) {
+      if (chance(rng_) < params_.mutation_rate) {
+        child.genome[gene] += mutation(rng_) * (IsBias(gene) ? 10 : 1);
+      }
+    }
+    next.push_back(child);
+  }
+  population_.swap(next);
+}
+
+const BehaviorOptimizer::Individual &BehaviorOptimizer::SelectParent() {
+  std::uniform_int_distribution<size_t> pick(0, population_.size() - 1);
+  const Individual *winner = &population_[pick(rng_)];
+  for (unsigned int i = 1; i < params_.tournament_size; ++i) {
+    const Individual &contender = population_[pick(rng_)];
+    if (contender.fitness > winner->fitness) {
+      winner = &contender;
+    }
+  }
+  return *winner;
+}
+
+BehaviorOptimizer::Genome BehaviorOptimizer::RandomGenome() {
+  std::uniform_real_distribution<double> weight(-1.0, 1.0);
+  std::uniform_real_distribution<double> bias(0.0, kMaxReading);
+  Genome genome;
+  for (int gene = 0; gene < kGenes; ++gene) {
+    genome[gene] = IsBias(gene) ? bias(rng_) : weight(rng_);
+  }
+  return genome;
+}
+
+BehaviorOptimizer::Genome BehaviorOptimizer::FearGenome() {
+  return Genome{{1, 0, 0, 1, 0, 0,    // light: + direct
+                 0, 1, 1, 0, 0, 0}};  // food: + crossed
+}
+
+unsigned int BehaviorOptimizer::EvaluateGenome(const Genome &genome,
+    unsigned int seed, unsigned int max_steps) {
+  arena_params aparams;
+  aparams.seed = seed;
+  Arena arena(&aparams);
+
+  ParametricBehavior::Parameters light, food;
+  std::copy(genome.begin(), genome.begin() + kParameters, light.begin());
+  std::copy(genome.begin() + kParameters, genome.end(), food.begin());
+  for (auto robot : arena.get_robots()) {
+    robot->set_robot_behavior(new ParametricBehavior(light));
+    robot->set_food_behavior(new ParametricBehavior(food));
+  }
+
+  unsigned int step = 0;
+  while (step < max_steps && arena.get_game_status() == PLAYING) {
+    arena.AdvanceTime(0.05);
+    ++step;
+  }
+  return step;
+}
+
+bool BehaviorOptimizer::SaveCheckpoint(const std::string &path) const {
+  // write a new file and then replace the old one, so a run that is killed
+  // while saving still leaves the previous checkpoint
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream file(temp_path);
+    if (!file) {
+      return false;
+    }
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << "evolution-checkpoint 1\n"
+         << "generations_done " << generations_done_ << "\n"
+         << "rng " << rng_ << "\n"
+         << "best " << best_.fitness;
+    for (double gene : best_.genome) {
+      file << " " << gene;
+    }
+    file << "\npopulation " << population_.size() << "\n";
+    for (auto &individual : population_) {
+      for (double gene : individual.genome) {
+        file << gene << " ";
+      }
+      file << "\n";
+    }
+    file << "cache " << fitness_cache_.size() << "\n";
+    for (auto &entry : fitness_cache_) {
+      file << entry.second;
+      for (double gene : entry.first) {
+        file << " " << gene;
+      }
+      file << "\n";
+    }
+    if (!file) {
+      return false;
+    }
+  }
+  return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+bool BehaviorOptimizer::LoadCheckpoint(const std::string &path) {
+  std::ifstream file(path);
+  std::string label;
+  int version = 0;
+  file >> label >> version;
+  if (!file || label != "evolution-checkpoint" || version != 1) {
+    return false;
+  }
+
+  unsigned int generations_done = 0;
+  Individual best;
+  size_t population_size = 0;
+  file >> label >> generations_done >> label >> rng_ >> label >> best.fitness;
+  for (double &gene : best.genome) {
+    file >> gene;
+  }
+  file >> label >> population_size;
+  std::vector<Individual> population(population_size);
+  for (auto &individual : population) {
+    for (double &gene : individual.genome) {
+      file >> gene;
+    }
+  }
+  size_t cache_size = 0;
+  file >> label >> cache_size;
+  std::map<Genome, double> cache;
+  for (size_t i = 0; i < cache_size && file; ++i) {
+    double fitness;
+    Genome genome;
+    file >> fitness;
+    for (double &gene : genome) {
+      file >> gene;
+    }
+    cache[genome] = fitness;
+  }
+  if (!file) {
+    return false;
+  }
+
+  generations_done_ = generations_done;
+  best_ = best;
+  population_.swap(population);
+  fitness_cache_.swap(cache);
+  return true;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,172 @@
+/**
+ * @file behavior_optimizer.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_BEHAVIOR_OPTIMIZER_H_
+#define SRC_BEHAVIOR_OPTIMIZER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <array>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/parametric_behavior.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Parameters of an evolutionary run.
+ */
+struct evolution_params {
+  unsigned int population_size{32};
+  unsigned int generations{20};
+  // best individuals copied unchanged into the next generation
+  unsigned int elite_count{2};
+  // individuals competing for each parent slot
+  unsigned int tournament_size{3};
+  // chance that a child mixes two parents instead of copying one
+  double crossover_rate{0.7};
+  // chance that each gene of a child is mutated
+  double mutation_rate{0.15};
+  // standard deviation of a mutation of a weight; biases use 10 times this
+  double mutation_scale{0.2};
+  // arenas (with different entity placements) each genome is evaluated in
+  unsigned int trials{3};
+  // an arena is stopped after this many steps if no robot has starved
+  unsigned int max_steps{5000};
+  // seeds the optimizer; the arenas of trial t are seeded with seed + t
+  unsigned int seed{1};
+  // # of threads evaluating genomes, 0 for one per core
+  unsigned int n_threads{0};
+  // file the state is saved to after each generation, if not empty
+  std::string checkpoint_path{};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A genetic algorithm that evolves ParametricBehaviors for robots.
+ *
+ * A genome holds the parameters of two ParametricBehaviors: genes 0-5 for
+ * reacting to light and genes 6-11 for reacting to food when hungry. Every
+ * robot of an arena is given the genome's behaviors, and the genome's
+ * fitness is the mean # of steps until a robot starves (up to max_steps)
+ * over several headless arenas. Each generation, the genomes are evaluated
+ * in parallel on a WorkerPool; genomes that were evaluated before (e.g. the
+ * elites) are looked up in a fitness cache instead.
+ */
+class BehaviorOptimizer {
+ public:
+  static const int kGenes = 2 * ParametricBehavior::kParameters;
+  typedef std::array<double, kGenes> Genome;
+
+  struct Individual {
+    Genome genome{};
+    double fitness{0};
+  };
+
+  /**
+   * @brief Called after each generation with the # of generations done and
+   * the evaluated population, best first.
+   */
+  typedef std::function<void(unsigned int,
+    const std::vector<Individual> &)> GenerationCallback;
+
+  explicit BehaviorOptimizer(const evolution_params &params);
+
+  BehaviorOptimizer(const BehaviorOptimizer &other) = delete;
+  BehaviorOptimizer &operator=(const BehaviorOptimizer &other) = delete;
+
+  /**
+   * @brief Evolve until params.generations generations are done, saving a
+   * checkpoint after each one if a checkpoint path is set.
+   */
+  void Run(const GenerationCallback &callback = GenerationCallback());
+
+  /**
+   * @brief Save the generation count, random state, next population and
+   * fitness cache.
+   *
+   * @return false if the file could not be written.
+   */
+  bool SaveCheckpoint(const std::string &path) const;
+
+  /**
+   * @brief Continue from a checkpoint written by SaveCheckpoint().
+   *
+   * @return false if the file could not be read.
+   */
+  bool LoadCheckpoint(const std::string &path);
+
+  /**
+   * @brief The fittest individual evaluated so far.
+   */
+  const Individual &get_best() const { return best_; }
+
+  unsigned int get_generations_done() const { return generations_done_; }
+
+  size_t get_cache_size() const { return fitness_cache_.size(); }
+
+  /**
+   * @brief # of steps until a robot starves (at most max_steps) in an arena
+   * seeded with seed, with every robot using genome's behaviors.
+   */
+  static unsigned int EvaluateGenome(const Genome &genome, unsigned int seed,
+    unsigned int max_steps);
+
+  /**
+   * @brief The genome of the fixed behaviors: fear (+ direct) of light and
+   * aggression (+ crossed) towards food.
+   */
+  static Genome FearGenome();
+
+ private:
+  /**
+   * @brief Fill population_ with the fear genome and random genomes.
+   */
+  void Initialize();
+
+  /**
+   * @brief Set the fitness of every individual, from the cache or by running
+   * the arenas of the genomes not seen before.
+   */
+  void EvaluatePopulation();
+
+  /**
+   * @brief Replace population_ with its offspring: the elites, then children
+   * of tournament selected parents.
+   */
+  void Breed();
+
+  const Individual &SelectParent();
+
+  Genome RandomGenome();
+
+  evolution_params params_;
+  WorkerPool pool_;
+  std::mt19937 rng_;
+  std::vector<Individual> population_{};
+  std::map<Genome, double> fitness_cache_{};
+  Individual best_{};
+  unsigned int generations_done_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_BEHAVIOR_OPTIMIZER_H_
@@ -0,0 +1,270 @@
+/**
+ * @file controller_server.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/controller_server.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+const char kMagic[8] = {'B', 'V', 'C', 'T', 'R', 'L', '0', '1'};
+const uint32_t kVersion = 1;
+// times a counter is polled before sleeping on it, which covers the usual
+// round trip of a client on another core
+const int kSpinIterations = 4000;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+  "futex words must be plain 32 bit integers");
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Wake every thread (in any process) waiting on word.
+ */
+void Wake(std::atomic<uint32_t> *word) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX,
+    nullptr, nullptr, 0);
+#else
+  static_cast<void>(word);  // waiters poll
+#endif
+}
+
+/**
+ * @brief Wait until done(word's value) is true, spinning first and then
+ * sleeping until word changes.
+ *
+ * @return false if timeout_ms passed first.
+ */
+template <typename Done>
+bool Wait(std::atomic<uint32_t> *word, Done done, unsigned int timeout_ms) {
+  for (int i = 0; i < kSpinIterations; ++i) {
+    if (done(word->load(std::memory_order_acquire))) {
+      return true;
+    }
+  }
+  Clock::time_point deadline = Clock::now() +
+    std::chrono::milliseconds(timeout_ms);
+  while (true) {
+    uint32_t value = word->load(std::memory_order_acquire);
+    if (done(value)) {
+      return true;
+    }
+    Clock::duration left = deadline - Clock::now();
+    if (left <= Clock::duration::zero()) {
+      return false;
+    }
+#ifdef __linux__
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left);
+    timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+    timeout.tv_nsec = static_cast<decltype(timeout.tv_nsec)>(
+      ns.count() % 1000000000);
+    // returns at once if word is no longer value
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, value,
+      &timeout, nullptr, 0);
+#else
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+  }
+}
+
+/**
+ * @brief Map the shared memory object name, creating it with size bytes if
+ * create is set.
+ *
+ * @param[in,out] size The size to create, or gets the size found.
+ *
+ * @return The mapping, or nullptr.
+ */
+void *MapRegion(const std::string &name, bool create, size_t *size) {
+  int fd = create ? shm_open(name.c_str(), O_CREAT | O_RDWR, 0600) :
+    shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat status;
+  if (create) {
+    // truncating to 0 first zeroes a region left by an earlier server
+    if (ftruncate(fd, 0) != 0 ||
+        ftruncate(fd, static_cast<off_t>(*size)) != 0) {
+      close(fd);
+      return nullptr;
+    }
+  } else if (fstat(fd, &status) == 0) {
+    *size = static_cast<size_t>(status.st_size);
+  } else {
+    *size = 0;
+  }
+  void *memory = *size < sizeof(controller_shm_header) ? MAP_FAILED :
+    mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  return memory == MAP_FAILED ? nullptr : memory;
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+ControllerServer::ControllerServer(const std::string &name, size_t capacity,
+    unsigned int timeout_ms)
+    : name_(name),
+      size_(sizeof(controller_shm_header) +
+        capacity * sizeof(controller_robot_slot)),
+      timeout_ms_(timeout_ms) {
+  void *memory = MapRegion(name_, true, &size_);
+  if (memory == nullptr) {
+    return;
+  }
+  header_ = new (memory) controller_shm_header();
+  slots_ = reinterpret_cast<controller_robot_slot *>(header_ + 1);
+  header_->version = kVersion;
+  header_->capacity = static_cast<uint32_t>(capacity);
+  // the magic last, so a client never sees a half made header
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header_->magic, kMagic, sizeof(kMagic));
+}
+
+ControllerServer::~ControllerServer() {
+  if (header_ == nullptr) {
+    return;
+  }
+  header_->closed.store(1, std::memory_order_release);
+  Wake(&header_->step);
+  munmap(header_, size_);
+  shm_unlink(name_.c_str());
+}
+
+ControllerClient::ControllerClient(const std::string &name) {
+  void *memory = MapRegion(name, false, &size_);
+  if (memory == nullptr) {
+    return;
+  }
+  controller_shm_header *header =
+    reinterpret_cast<controller_shm_header *>(memory);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || size_ < sizeof(controller_shm_header) +
+      header->capacity * sizeof(controller_robot_slot)) {
+    munmap(memory, size_);
+    return;
+  }
+  header_ = header;
+  slots_ = reinterpret_cast<controller_robot_slot *>(header_ + 1);
+  // only answer the steps published from now on
+  step_ = header_->step.load(std::memory_order_acquire);
+  header_->attached.store(1, std::memory_order_release);
+}
+
+ControllerClient::~ControllerClient() {
+  if (header_ == nullptr) {
+    return;
+  }
+  header_->attached.store(0, std::memory_order_release);
+  munmap(header_, size_);
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void ControllerServer::Exchange(Arena *arena) {
+  const std::vector<Robot *> &robots = arena->get_robots();
+  size_t n = 0;
+  bool answered = false;
+  if (header_ != nullptr &&
+      header_->attached.load(std::memory_order_acquire) != 0) {
+    n = std::min(robots.size(), static_cast<size_t>(header_->capacity));
+    for (size_t i = 0; i < n; ++i) {
+      Robot *robot = robots[i];
+      controller_robot_slot &slot = slots_[i];
+      slot.readings[0] = robot->get_left_lightsensor()->get_reading();
+      slot.readings[1] = robot->get_right_lightsensor()->get_reading();
+      slot.readings[2] = robot->get_left_foodsensor()->get_reading();
+      slot.readings[3] = robot->get_right_foodsensor()->get_reading();
+      slot.x = robot->get_pose().x;
+      slot.y = robot->get_pose().y;
+      slot.heading = robot->get_pose().theta;
+      slot.hungry = robot->get_hungry();
+      slot.starving = robot->get_starving();
+    }
+    header_->n_robots.store(static_cast<uint32_t>(n),
+      std::memory_order_relaxed);
+    uint32_t step = header_->step.load(std::memory_order_relaxed) + 1;
+    header_->step.store(step, std::memory_order_release);
+    Wake(&header_->step);
+
+    answered = Wait(&header_->done,
+      [step](uint32_t done) { return done == step; }, timeout_ms_);
+    if (!answered) {
+      // assume the client is gone until it waits for a step again
+      ++timeouts_;
+      header_->attached.store(0, std::memory_order_release);
+    }
+  }
+
+  for (size_t i = 0; i < robots.size(); ++i) {
+    if (answered && i < n && slots_[i].control != 0) {
+      robots[i]->set_external_velocity(
+        WheelVelocity(slots_[i].wheels[0], slots_[i].wheels[1]));
+    } else {
+      robots[i]->clear_external_velocity();
+    }
+  }
+}
+
+bool ControllerClient::WaitForStep(unsigned int timeout_ms) {
+  if (header_ == nullptr) {
+    return false;
+  }
+  header_->attached.store(1, std::memory_order_release);
+  uint32_t last = step_;
+  const std::atomic<uint32_t> &closed = header_->closed;
+  bool published = Wait(&header_->step, [last, &closed](uint32_t step) {
+    return step != last || closed.load(std::memory_order_acquire) != 0; },
+    timeout_ms);
+  if (!published || header_->closed.load(std::memory_order_acquire) != 0) {
+    return false;
+  }
+  step_ = header_->step.load(std::memory_order_acquire);
+  return true;
+}
+
+void ControllerClient::Reply() {
+  if (header_ == nullptr) {
+    return;
+  }
+  header_->done.store(step_, std::memory_order_release);
+  Wake(&header_->done);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,187 @@
+/**
+ * @file controller_server.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_CONTROLLER_SERVER_H_
+#define SRC_CONTROLLER_SERVER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class Arena;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One robot's slot in the shared memory region. The server writes
+ * everything but wheels and control, which belong to the client.
+ */
+struct controller_robot_slot {
+  // left light, right light, left food, right food
+  double readings[4];
+  double x;
+  double y;
+  double heading;
+  uint32_t hungry;
+  uint32_t starving;
+  // written by the client: left and right wheel velocities
+  double wheels[2];
+  // written by the client: non-zero to drive the robot with wheels instead
+  // of its behaviors
+  uint32_t control;
+  uint32_t padding;
+};
+
+/**
+ * @brief The start of the shared memory region, followed by `capacity`
+ * controller_robot_slots.
+ *
+ * Each step, the server writes the slots, sets n_robots and increments
+ * `step`. The client waits for `step` to change, writes its wheels and sets
+ * `done` to the same value. Both counters are futex words, so neither side
+ * burns a core while the other is working for long.
+ */
+struct controller_shm_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t capacity;
+  // robots whose slots are valid this step
+  std::atomic<uint32_t> n_robots;
+  // set by a client while it is attached; the server only waits if set
+  std::atomic<uint32_t> attached;
+  // incremented by the server when a step's readings are published
+  std::atomic<uint32_t> step;
+  // set to `step` by the client when its wheels for that step are written
+  std::atomic<uint32_t> done;
+  // set by the server when it shuts down
+  std::atomic<uint32_t> closed;
+  uint32_t padding;
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Lets a controller in another process drive the robots of an Arena
+ * through a POSIX shared memory region.
+ *
+ * Once set on an Arena (Arena::set_controller_server()), Exchange() is
+ * called every timestep after the sensors are notified and before the
+ * robots are updated. If a client is attached, it publishes each robot's
+ * sensor readings, wakes the client and waits for its wheel velocities,
+ * which then override the behaviors of the robots the client controls. The
+ * handshake spins briefly before sleeping on a futex, so a client on
+ * another core answers within microseconds. Without a client the arena
+ * runs as usual.
+ */
+class ControllerServer {
+ public:
+  /**
+   * @param name Name of the shared memory object, e.g. "/braitenberg".
+   * @param capacity Most robots that can be published.
+   * @param timeout_ms How long to wait for a client each step before giving
+   * up on it for that step.
+   */
+  ControllerServer(const std::string &name, size_t capacity,
+    unsigned int timeout_ms = 1000);
+
+  /**
+   * @brief Tell the client the server is gone and remove the region.
+   */
+  ~ControllerServer();
+
+  ControllerServer(const ControllerServer &other) = delete;
+  ControllerServer &operator=(const ControllerServer &other) = delete;
+
+  /**
+   * @brief Whether the shared memory region was created.
+   */
+  bool IsOpen() const { return header_ != nullptr; }
+
+  /**
+   * @brief Publish the readings of arena's robots, wait for the client and
+   * apply its wheel velocities. Robots the client does not control (or all,
+   * if no client is attached) are handed back to their behaviors.
+   */
+  void Exchange(Arena *arena);
+
+  /**
+   * @brief # of steps the client did not answer in time.
+   */
+  uint64_t get_timeouts() const { return timeouts_; }
+
+ private:
+  std::string name_;
+  size_t size_{0};
+  controller_shm_header *header_{nullptr};
+  controller_robot_slot *slots_{nullptr};
+  unsigned int timeout_ms_;
+  uint64_t timeouts_{0};
+};
+
+/**
+ * @brief The client side of a ControllerServer, for controllers written in
+ * C++. Clients in other languages only need the layout of
+ * controller_shm_header and controller_robot_slot.
+ */
+class ControllerClient {
+ public:
+  /**
+   * @brief Attach to the region of a running server.
+   */
+  explicit ControllerClient(const std::string &name);
+
+  /**
+   * @brief Detach, letting the server run on without waiting.
+   */
+  ~ControllerClient();
+
+  ControllerClient(const ControllerClient &other) = delete;
+  ControllerClient &operator=(const ControllerClient &other) = delete;
+
+  bool IsOpen() const { return header_ != nullptr; }
+
+  /**
+   * @brief Wait until the server publishes a step not yet answered.
+   *
+   * @return false if the server closed or timeout_ms passed first.
+   */
+  bool WaitForStep(unsigned int timeout_ms);
+
+  /**
+   * @brief The robots of the current step.
+   */
+  size_t get_robot_count() const { return header_->n_robots.load(); }
+  controller_robot_slot *get_slot(size_t i) { return &slots_[i]; }
+
+  /**
+   * @brief Hand the wheels written to the slots to the server.
+   */
+  void Reply();
+
+ private:
+  size_t size_{0};
+  controller_shm_header *header_{nullptr};
+  controller_robot_slot *slots_{nullptr};
+  // the last step answered
+  uint32_t step_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_CONTROLLER_SERVER_H_
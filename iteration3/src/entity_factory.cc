@@ -7,6 +7,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <algorithm>
 #include <string>
 #include <ctime>
 #include <iostream>
@@ -15,6 +16,7 @@
 #include "src/entity_factory.h"
 #include "src/entity_type.h"
 #include "src/params.h"
+#include "src/poisson_disk_sampler.h"
 #include "src/pose.h"
 #include "src/rgb_color.h"
 
@@ -27,8 +29,12 @@ NAMESPACE_BEGIN(csci3081);
  * Class Definitions
  ******************************************************************************/
 
-EntityFactory::EntityFactory() {
-  srand(time(nullptr));
+EntityFactory::EntityFactory(unsigned int seed) {
+  if (seed == 0) {
+    srand(time(nullptr));  // entities still use random() when reset
+    seed = static_cast<unsigned int>(time(nullptr));
+  }
+  rng_.seed(seed);
 }
 
 ArenaEntity* EntityFactory::CreateEntity(EntityType etype) {
@@ -53,10 +59,8 @@ Robot* EntityFactory::CreateRobot() {
   auto* robot = new Robot;
   robot->set_type(kRobot);
   robot->set_color(ROBOT_COLOR);
-  robot->set_pose(SetPoseRandomly());
 
-  double rand_radius = random() %
-    (ROBOT_MAX_RADIUS - ROBOT_MIN_RADIUS + 1) + ROBOT_MIN_RADIUS;
+  double rand_radius = RandomInt(ROBOT_MIN_RADIUS, ROBOT_MAX_RADIUS);
   robot->set_radius(rand_radius);
 
   ++entity_count_;
@@ -86,10 +90,8 @@ Light* EntityFactory::CreateLight() {
   auto* Light = new csci3081::Light;
   Light->set_type(kLight);
   Light->set_color(Light_COLOR);
-  Light->set_pose(SetPoseRandomly());
 
-  double rand_radius = random() %
-    (Light_MAX_RADIUS - Light_MIN_RADIUS + 1) + Light_MIN_RADIUS;
+  double rand_radius = RandomInt(Light_MIN_RADIUS, Light_MAX_RADIUS);
 
   Light->set_radius(rand_radius);
   ++entity_count_;
@@ -102,7 +104,6 @@ Food* EntityFactory::CreateFood() {
   auto* Food = new csci3081::Food;
   Food->set_type(kFood);
   Food->set_color(Food_COLOR);
-  Food->set_pose(SetPoseRandomly());
   Food->set_radius(Food_RADIUS);
   ++entity_count_;
   ++Food_count_;
@@ -110,10 +111,35 @@ Food* EntityFactory::CreateFood() {
   return Food;
 }
 
-Pose EntityFactory::SetPoseRandomly() {
-  // Dividing arena into 19x14 grid. Each grid square is 50x50
-  return {static_cast<double>((30 + (random() % 19) * 50)),
-        static_cast<double>((30 + (random() % 14) * 50))};
+size_t EntityFactory::PlaceEntities(
+    const std::vector<ArenaEntity *> &entities, size_t first, double x_dim,
+    double y_dim, const ObstacleMap *obstacles) {
+  double max_radius = 0;
+  for (auto ent : entities) {
+    max_radius = std::max(max_radius, ent->get_radius());
+  }
+  PoissonDiskSampler sampler(x_dim, y_dim, max_radius, COLLISION_SKIN);
+  if (obstacles && !obstacles->is_empty()) {
+    sampler.set_obstacles(obstacles);
+  }
+  for (size_t i = 0; i < first; ++i) {
+    sampler.AddCircle(entities[i]->get_pose(), entities[i]->get_radius());
+  }
+
+  std::vector<double> radii;
+  for (size_t i = first; i < entities.size(); ++i) {
+    radii.push_back(entities[i]->get_radius());
+  }
+  std::vector<Pose> centers;
+  size_t n_unplaced = sampler.PlaceAll(radii, &rng_, &centers);
+  for (size_t i = first; i < entities.size(); ++i) {
+    entities[i]->set_position(centers[i - first].x, centers[i - first].y);
+  }
+  return n_unplaced;
+}
+
+int EntityFactory::RandomInt(int min, int max) {
+  return std::uniform_int_distribution<int>(min, max)(rng_);
 }
 
 NAMESPACE_END(csci3081);
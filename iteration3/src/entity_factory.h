@@ -10,12 +10,15 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <random>
 #include <string>
+#include <vector>
 
 #include "src/food.h"
 #include "src/common.h"
 #include "src/entity_type.h"
 #include "src/light.h"
+#include "src/obstacle_map.h"
 #include "src/params.h"
 #include "src/pose.h"
 #include "src/rgb_color.h"
@@ -34,16 +37,17 @@ NAMESPACE_BEGIN(csci3081);
  *
  * The factory keeps track of the number of entities of each type and overall.
  * It assigns ID's to the entity when it creates it.
- * The factory randomly places entities, and in doing so, attempts to not
- * have them overlap.
+ * The factory randomly places entities, without overlap (PlaceEntities()).
  */
 class EntityFactory {
  public:
   /**
    * @brief EntityFactory constructor.
    *
+   * @param seed Seed for placing and sizing entities. The same seed gives the
+   * same entities every time. 0 seeds from the clock.
    */
-  EntityFactory();
+  explicit EntityFactory(unsigned int seed = 0);
 
   /**
    * @brief Default destructor.
@@ -63,6 +67,19 @@ class EntityFactory {
   */
   ArenaEntity* CreateEntity(EntityType etype);
 
+  /**
+   * @brief Move entities[first, end) to random positions in an x_dim by
+   * y_dim arena where they overlap neither each other, entities[0, first),
+   * nor the obstacles (see PoissonDiskSampler). Headings are kept.
+   *
+   * @param obstacles May be NULL.
+   *
+   * @return # of entities no free position was found for, which are left at
+   * random positions.
+   */
+  size_t PlaceEntities(const std::vector<ArenaEntity *> &entities,
+    size_t first, double x_dim, double y_dim, const ObstacleMap *obstacles);
+
  private:
    /**
    * @brief CreateRobot called from within CreateEntity.
@@ -80,9 +97,9 @@ class EntityFactory {
   Food* CreateFood();
 
   /**
-  * @brief An attempt to not overlap any of the newly constructed entities.
+  * @brief A random integer in [min, max].
   */
-  Pose SetPoseRandomly();
+  int RandomInt(int min, int max);
 
   /* Factory tracks the number of created entities. There is no accounting for
    * the destruction of entities */
@@ -90,6 +107,9 @@ class EntityFactory {
   int robot_count_{0};
   int Light_count_{0};
   int Food_count_{0};
+
+  // each factory has its own generator, so arenas can be created in parallel
+  std::mt19937 rng_{};
 };
 
 NAMESPACE_END(csci3081);
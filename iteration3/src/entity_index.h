@@ -0,0 +1,165 @@
+/**
+ * @file entity_index.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_ENTITY_INDEX_H_
+#define SRC_ENTITY_INDEX_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "src/common.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A uniform grid over the arena holding entities by position, so that
+ * the entities near a point can be found without looking at all of them.
+ *
+ * An entity must not move while it is in the index. An index of entities
+ * that never move (e.g. FoodIndex) is only changed when they are added or
+ * removed; one of mobile entities is rebuilt each timestep before it is
+ * queried. Positions outside the arena are clamped to the border cells.
+ *
+ * @tparam T The class of the entities, e.g. Food.
+ */
+template <typename T>
+class EntityIndex {
+ public:
+  /**
+   * @param x_dim Width of the arena.
+   * @param y_dim Height of the arena.
+   * @param cell_size Side length of a grid cell.
+   */
+  EntityIndex(double x_dim, double y_dim, double cell_size)
+      : cell_size_(cell_size),
+        columns_(std::max(1, static_cast<int>(std::ceil(x_dim / cell_size)))),
+        rows_(std::max(1, static_cast<int>(std::ceil(y_dim / cell_size)))),
+        cells_(columns_ * rows_) {}
+
+  /**
+   * @brief Add ent to the cell containing its current position.
+   */
+  void Insert(T * ent) {
+    Pose pos = ent->get_pose();
+    cells_[CellY(pos.y) * columns_ + CellX(pos.x)].push_back(ent);
+    ++size_;
+  }
+
+  /**
+   * @brief Remove ent from the index. It must not have moved since it was
+   * inserted.
+   *
+   * @return true if ent was in the index.
+   */
+  bool Remove(T * ent) {
+    Pose pos = ent->get_pose();
+    std::vector<T *> &cell = cells_[CellY(pos.y) * columns_ + CellX(pos.x)];
+    auto it = std::find(cell.begin(), cell.end(), ent);
+    if (it == cell.end()) {
+      return false;
+    }
+    // order within a cell does not matter
+    *it = cell.back();
+    cell.pop_back();
+    --size_;
+    return true;
+  }
+
+  /**
+   * @brief Empty the index and insert all of ents again.
+   */
+  void Rebuild(const std::vector<T *> &ents) {
+    Clear();
+    for (auto ent : ents) {
+      Insert(ent);
+    }
+  }
+
+  void Clear() {
+    for (auto &cell : cells_) {
+      cell.clear();
+    }
+    size_ = 0;
+  }
+
+  /**
+   * @brief Every entity whose center is within range of center.
+   *
+   * @param[out] found The entities in range are appended here.
+   */
+  void QueryRange(const Pose &center, double range,
+      std::vector<T *> *found) const {
+    double range_squared = range * range;
+    int min_x = CellX(center.x - range);
+    int max_x = CellX(center.x + range);
+    int min_y = CellY(center.y - range);
+    int max_y = CellY(center.y + range);
+    for (int y = min_y; y <= max_y; ++y) {
+      for (int x = min_x; x <= max_x; ++x) {
+        for (auto ent : cells_[y * columns_ + x]) {
+          double delta_x = ent->get_pose().x - center.x;
+          double delta_y = ent->get_pose().y - center.y;
+          if (delta_x * delta_x + delta_y * delta_y <= range_squared) {
+            found->push_back(ent);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Every entity whose center may lie in the box. This is a broad
+   * phase: it returns the contents of all cells that touch the box.
+   *
+   * @param[out] found The candidate entities are appended here.
+   */
+  void QueryBox(double min_x, double min_y, double max_x, double max_y,
+      std::vector<T *> *found) const {
+    int last_x = CellX(max_x);
+    int last_y = CellY(max_y);
+    for (int y = CellY(min_y); y <= last_y; ++y) {
+      for (int x = CellX(min_x); x <= last_x; ++x) {
+        const std::vector<T *> &cell = cells_[y * columns_ + x];
+        found->insert(found->end(), cell.begin(), cell.end());
+      }
+    }
+  }
+
+  size_t get_size() const { return size_; }
+
+ private:
+  int CellX(double x) const {
+    int cell = static_cast<int>(std::floor(x / cell_size_));
+    return std::min(std::max(cell, 0), columns_ - 1);
+  }
+
+  int CellY(double y) const {
+    int cell = static_cast<int>(std::floor(y / cell_size_));
+    return std::min(std::max(cell, 0), rows_ - 1);
+  }
+
+  double cell_size_;
+  int columns_;
+  int rows_;
+  // row-major: cell (x, y) is cells_[y * columns_ + x]
+  std::vector<std::vector<T *>> cells_;
+  size_t size_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_ENTITY_INDEX_H_
@@ -29,6 +29,8 @@ NAMESPACE_BEGIN(csci3081);
 enum EntityType {
   kRobot, kLight, kFood, kEntity,
   kRightWall, kLeftWall, kTopWall, kBottomWall,
+  // static obstacle geometry (see ObstacleMap), which acts as a wall
+  kObstacle,
   kUndefined
 };
 
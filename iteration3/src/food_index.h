@@ -0,0 +1,34 @@
+/**
+ * @file food_index.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_FOOD_INDEX_H_
+#define SRC_FOOD_INDEX_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+#include "src/entity_index.h"
+#include "src/food.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Every Food by position. Food never moves, so the index is only
+ * changed when food is added or removed (and rebuilt when the arena is
+ * reset, since that moves the food).
+ */
+typedef EntityIndex<Food> FoodIndex;
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_FOOD_INDEX_H_
@@ -14,6 +14,7 @@
 
 #include "src/sensor.h"
 #include "src/params.h"
+#include "src/sensor_falloff.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
@@ -25,20 +26,36 @@ NAMESPACE_BEGIN(csci3081);
  * Food sensors detect food only when hungry. Food sensors are not displayed.
  *
  * Receives position information about Foods from the arena and updates reading.
+ *
+ * @tparam Falloff How the reading from one food falls off with the distance
+ * to it (see sensor_falloff.h).
  */
-class FoodSensor : public Sensor {
+template <typename Falloff>
+class BasicFoodSensor : public Sensor {
  public:
-  FoodSensor();
+  explicit BasicFoodSensor(const Falloff &falloff = Falloff())
+      : falloff_(falloff) {
+    color_.Set(kRed);
+  }
 
   /**
   * @brief Update reading based on distance and formula
   */
-  void Notify(Pose position) override;
+  void Notify(Pose position) override {
+    reading_ += falloff_(numerator_value_, calculateDistance(position));
+  }
+
+  const Falloff &get_falloff() const { return falloff_; }
 
  private:
-  double base_{1.08};
+  Falloff falloff_;
 };
 
+/**
+ * @brief A food sensor with the arena's default falloff.
+ */
+typedef BasicFoodSensor<PowerFalloff<double>> FoodSensor;
+
 NAMESPACE_END(csci3081);
 
 #endif  // SRC_FOOD_SENSOR_H_
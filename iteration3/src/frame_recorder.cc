@@ -0,0 +1,122 @@
+/**
+ * @file frame_recorder.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "src/frame_recorder.h"
+#include "src/software_rasterizer.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+FrameRecorder::FrameRecorder(const std::string &prefix,
+    unsigned int interval, FrameFormat format, int width, int height,
+    double zoom, unsigned int n_workers)
+    : prefix_(prefix),
+      interval_(std::max(interval, 1u)),
+      format_(format),
+      width_(width),
+      height_(height),
+      zoom_(zoom),
+      max_queued_(0) {
+  if (n_workers == 0) {
+    n_workers = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  max_queued_ = n_workers * 4;
+  for (unsigned int i = 0; i < n_workers; ++i) {
+    workers_.emplace_back(&FrameRecorder::WorkerLoop, this);
+  }
+}
+
+FrameRecorder::~FrameRecorder() {
+  Finish();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  frame_queued_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void FrameRecorder::Capture(Arena * arena, unsigned int step) {
+  if (step % interval_ != 0) {
+    return;
+  }
+  batcher_.Build(arena, zoom_, width_, height_);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  frame_done_.wait(lock, [this]() { return queue_.size() < max_queued_; });
+  queue_.push_back(
+    Frame{step, arena->get_x_dim(), arena->get_y_dim(), batcher_});
+  lock.unlock();
+  frame_queued_.notify_one();
+}
+
+void FrameRecorder::Finish() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  frame_done_.wait(lock, [this]() {
+    return queue_.empty() && in_progress_ == 0; });
+}
+
+void FrameRecorder::WorkerLoop() {
+  SoftwareRasterizer rasterizer(width_, height_);
+  while (true) {
+    Frame frame;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      frame_queued_.wait(lock, [this]() {
+        return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;  // stopping and nothing left to write
+      }
+      frame = std::move(queue_.front());
+      queue_.pop_front();
+      ++in_progress_;
+    }
+    // the queue has room again
+    frame_done_.notify_all();
+
+    rasterizer.Clear(RgbColor(0, 0, 0));
+    rasterizer.Draw(frame.batcher, zoom_, frame.x_dim, frame.y_dim);
+    std::string path = FramePath(frame.step);
+    bool written = (format_ == kPNG) ? rasterizer.WritePNG(path) :
+      rasterizer.WritePPM(path);
+    if (written) {
+      ++frames_written_;
+    } else {
+      ++frames_failed_;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --in_progress_;
+    }
+    frame_done_.notify_all();
+  }
+}
+
+std::string FrameRecorder::FramePath(unsigned int step) const {
+  char number[16];
+  snprintf(number, sizeof(number), "%06u", step);
+  return prefix_ + number + ((format_ == kPNG) ? ".png" : ".ppm");
+}
+
+NAMESPACE_END(csci3081);
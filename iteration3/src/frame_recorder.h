@@ -0,0 +1,134 @@
+/**
+ * @file frame_recorder.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_FRAME_RECORDER_H_
+#define SRC_FRAME_RECORDER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/common.h"
+#include "src/render_batch.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Image formats FrameRecorder can write.
+ */
+enum FrameFormat {
+  kPPM,
+  kPNG
+};
+
+/**
+ * @brief Renders every k-th timestep of an Arena to an image file, without a
+ * display.
+ *
+ * Capture() is called from the simulation loop. On a recorded step it takes
+ * a snapshot of what there is to draw (the RenderBatcher batches) and queues
+ * it; worker threads draw the snapshots with a SoftwareRasterizer and write
+ * them out, so the simulation keeps running while frames are rendered. If
+ * the workers fall too far behind, Capture() waits for room in the queue
+ * instead of using more and more memory.
+ *
+ * Frames are written to <prefix><step, 6 digits>.ppm (or .png).
+ */
+class FrameRecorder {
+ public:
+  /**
+   * @param prefix Path prefix of the frame files.
+   * @param interval Record every interval-th step.
+   * @param format Image format of the frames.
+   * @param width Width of the frames in pixels.
+   * @param height Height of the frames in pixels.
+   * @param zoom Pixels per arena unit.
+   * @param n_workers # of rendering threads. 0 uses one per core.
+   */
+  FrameRecorder(const std::string &prefix, unsigned int interval,
+    FrameFormat format, int width, int height, double zoom,
+    unsigned int n_workers = 0);
+
+  /**
+   * @brief Finish() and stop the workers.
+   */
+  ~FrameRecorder();
+
+  FrameRecorder(const FrameRecorder &other) = delete;
+  FrameRecorder &operator=(const FrameRecorder &other) = delete;
+
+  /**
+   * @brief Queue a frame of arena if step is a multiple of the interval.
+   */
+  void Capture(Arena * arena, unsigned int step);
+
+  /**
+   * @brief Wait until every queued frame has been written.
+   */
+  void Finish();
+
+  unsigned int get_frames_written() const { return frames_written_; }
+  unsigned int get_frames_failed() const { return frames_failed_; }
+
+ private:
+  struct Frame {
+    unsigned int step{0};
+    double x_dim{0};
+    double y_dim{0};
+    RenderBatcher batcher{};
+  };
+
+  /**
+   * @brief Render and write frames until the recorder is destroyed.
+   */
+  void WorkerLoop();
+
+  std::string FramePath(unsigned int step) const;
+
+  std::string prefix_;
+  unsigned int interval_;
+  FrameFormat format_;
+  int width_;
+  int height_;
+  double zoom_;
+  // the largest # of frames queued before Capture() waits
+  size_t max_queued_;
+
+  // builds snapshots on the simulation thread
+  RenderBatcher batcher_{};
+
+  std::mutex mutex_{};
+  // signaled when a frame is queued or the recorder stops
+  std::condition_variable frame_queued_{};
+  // signaled when a frame is done
+  std::condition_variable frame_done_{};
+  std::deque<Frame> queue_{};
+  // frames taken off the queue but not written yet
+  unsigned int in_progress_{0};
+  bool stopping_{false};
+  std::vector<std::thread> workers_{};
+
+  std::atomic<unsigned int> frames_written_{0};
+  std::atomic<unsigned int> frames_failed_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_FRAME_RECORDER_H_
@@ -0,0 +1,85 @@
+/**
+ * @file ghost_pool.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_GHOST_POOL_H_
+#define SRC_GHOST_POOL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <vector>
+
+#include "src/common.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Read-only copies (ghosts) of entities owned by another arena, e.g.
+ * the entities of a neighboring tile that are near the shared border.
+ *
+ * A ghost only has the pose and radius of the entity it copies; it is never
+ * updated, swept or collided, but the arena's own entities sense it and are
+ * kept from overlapping it. The ghosts are replaced every timestep, so the
+ * objects are kept in a pool and reused instead of being allocated again.
+ *
+ * @tparam T The class of the entities copied, e.g. Robot.
+ */
+template <typename T>
+class GhostPool {
+ public:
+  GhostPool() {}
+
+  ~GhostPool() {
+    for (auto ghost : pool_) {
+      delete ghost;
+    }
+  }
+
+  GhostPool(const GhostPool &other) = delete;
+  GhostPool &operator=(const GhostPool &other) = delete;
+
+  /**
+   * @brief Add a ghost at pose with the given radius.
+   *
+   * @return The ghost, which stays valid until Clear().
+   */
+  T *Add(const Pose &pose, double radius) {
+    if (ghosts_.size() == pool_.size()) {
+      pool_.push_back(new T());
+    }
+    T *ghost = pool_[ghosts_.size()];
+    ghost->set_pose(pose);
+    ghost->set_radius(radius);
+    ghosts_.push_back(ghost);
+    return ghost;
+  }
+
+  /**
+   * @brief Remove all ghosts, keeping the objects for reuse.
+   */
+  void Clear() { ghosts_.clear(); }
+
+  /**
+   * @brief The current ghosts, e.g. for a StepEngine to sense and avoid.
+   */
+  std::vector<T *> *get_ghosts() { return &ghosts_; }
+
+ private:
+  std::vector<T *> ghosts_{};
+  // every ghost object allocated so far, in use or not
+  std::vector<T *> pool_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_GHOST_POOL_H_
@@ -7,6 +7,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cstdio>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -186,6 +187,27 @@ GraphicsArenaViewer::GraphicsArenaViewer(
         light_count_, food_count_, numerator_value_);
     });
 
+  // *************** SLIDER 6 ************************//
+  new nanogui::Label(panel, "Zoom", "sans-bold");
+  nanogui::Slider *slider6 = new nanogui::Slider(panel);
+  slider6->setRange({RENDER_MIN_ZOOM, RENDER_MAX_ZOOM});
+  slider6->setValue(1.0f);
+  slider6->setFixedWidth(100);
+
+  nanogui::TextBox *textBox6 = new nanogui::TextBox(panel);
+  textBox6->setFixedSize(nanogui::Vector2i(60, 25));
+  textBox6->setFontSize(20);
+  textBox6->setValue("1.00");
+
+  // zooming only changes the drawing, so it applies while sliding
+  slider6->setCallback(
+    [this, textBox6](float value) {
+      zoom_ = value;
+      char text[16];
+      snprintf(text, sizeof(text), "%.2f", value);
+      textBox6->setValue(text);
+    });
+
   // Lays out all the components with "15" units of inbetween spacing
   panel->setLayout(new nanogui::BoxLayout(nanogui::Orientation::Vertical,
       nanogui::Alignment::Middle, 0, 15));
@@ -220,109 +242,46 @@ void GraphicsArenaViewer::OnPlayingBtnPressed() {
 /*******************************************************************************
  * Drawing of Entities in Arena
  ******************************************************************************/
-void GraphicsArenaViewer::DrawRobot(NVGcontext *ctx,
-                                     const Robot *const robot) {
-  // translate and rotate all graphics calls that follow so that they are
-  // centered, at the position and heading of this robot
-  nvgSave(ctx);
-  nvgTranslate(ctx,
-               static_cast<float>(robot->get_pose().x),
-               static_cast<float>(robot->get_pose().y));
-  nvgRotate(ctx,
-            static_cast<float>(robot->get_pose().theta * M_PI / 180.0));
-
-  // robot's circle
-  nvgBeginPath(ctx);
-  nvgCircle(ctx, 0.0, 0.0, static_cast<float>(robot->get_radius()));
-
-  // Color robot depending on hunger state
-  // green: not hungry, yellow: hungry but not starving, red: starving
-  // purple: robot has starved (died)
-  if (!robot->get_hungry())
-    nvgFillColor(ctx, nvgRGBA(0, 255, 0, 255));  // green
-  else if (robot->get_hungry() && !robot->get_starving())
-    nvgFillColor(ctx, nvgRGBA(255, 255, 50, 255));  // yellow
-  else if (robot->get_starving() && !robot->get_starved())
-    nvgFillColor(ctx, nvgRGBA(255, 0, 0, 255));  // red
-  else  // otherwise robot is dead and then it is purple
-    nvgFillColor(ctx, nvgRGBA(75, 0, 150, 255));
-
-  nvgFill(ctx);
-
-  // robot id text label
-  nvgSave(ctx);
-  nvgRotate(ctx, static_cast<float>(M_PI / 2.0));
-
-  nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgFontSize(ctx, 40.0f);
-
-  nvgRestore(ctx);
-  nvgRestore(ctx);
-
-  // left light sensor
-  nvgSave(ctx);
-  nvgBeginPath(ctx);
-  nvgTranslate(ctx,
-    static_cast<float>(robot->get_left_lightsensor()->get_position().x),
-    static_cast<float>(robot->get_left_lightsensor()->get_position().y));
-
-  nvgCircle(ctx, 0.0, 0.0, robot->get_left_lightsensor()->get_radius());
-  nvgFillColor(ctx,
-    nvgRGBA(robot->get_left_lightsensor()->get_color().r,
-    robot->get_left_lightsensor()->get_color().g,
-    robot->get_left_lightsensor()->get_color().b, 255));
-  nvgFill(ctx);
-  nvgStrokeColor(ctx, nvgRGBA(100, 100, 100, 255));
-  nvgStroke(ctx);
-  nvgRestore(ctx);
-
-  // right light sensor
-  nvgSave(ctx);
-  nvgBeginPath(ctx);
-  nvgTranslate(ctx,
-    static_cast<float>(robot->get_right_lightsensor()->get_position().x),
-    static_cast<float>(robot->get_right_lightsensor()->get_position().y));
-
-  nvgCircle(ctx, 0.0, 0.0, robot->get_right_lightsensor()->get_radius());
-  nvgFillColor(ctx,
-                 nvgRGBA(robot->get_right_lightsensor()->get_color().r,
-                  robot->get_right_lightsensor()->get_color().g,
-                         robot->get_right_lightsensor()->get_color().b, 255));
-  nvgFill(ctx);
-  nvgStrokeColor(ctx, nvgRGBA(100, 100, 100, 255));
-  nvgStroke(ctx);
-  nvgRestore(ctx);
-}
 void GraphicsArenaViewer::DrawArena(NVGcontext *ctx) {
   nvgBeginPath(ctx);
   // Creates new rectangle shaped sub-path.
   nvgRect(ctx, 0, 0, arena_->get_x_dim(), arena_->get_y_dim());
+  // the obstacles are drawn as part of the walls
+  const ObstacleMap *obstacles = arena_->get_obstacles();
+  for (size_t i = 0; obstacles && i < obstacles->get_size(); ++i) {
+    const obstacle_segment &segment = obstacles->get_segment(i);
+    nvgMoveTo(ctx, static_cast<float>(segment.x0),
+      static_cast<float>(segment.y0));
+    nvgLineTo(ctx, static_cast<float>(segment.x1),
+      static_cast<float>(segment.y1));
+  }
   nvgStrokeColor(ctx, nvgRGBA(255, 255, 255, 255));
   nvgStroke(ctx);
 }
 
-void GraphicsArenaViewer::DrawEntity(NVGcontext *ctx,
-                                       const ArenaEntity *const entity) {
-  // Light's circle
-  nvgBeginPath(ctx);
-  nvgCircle(ctx,
-            static_cast<float>(entity->get_pose().x),
-            static_cast<float>(entity->get_pose().y),
-            static_cast<float>(entity->get_radius()));
-  nvgFillColor(ctx,
-               nvgRGBA(entity->get_color().r, entity->get_color().g,
-                       entity->get_color().b, 255));
-  nvgFill(ctx);
-  nvgStrokeColor(ctx, nvgRGBA(0, 0, 0, 255));
-  nvgStroke(ctx);
+void GraphicsArenaViewer::DrawBatches(NVGcontext *ctx) {
+  // one path, fill and stroke per batch instead of per entity
+  for (auto &batch : batcher_.get_batches()) {
+    if (batch.circles.empty()) {
+      continue;
+    }
+    nvgBeginPath(ctx);
+    for (auto &circle : batch.circles) {
+      nvgCircle(ctx, circle.x, circle.y, circle.radius);
+    }
+    nvgFillColor(ctx,
+                 nvgRGBA(batch.fill.r, batch.fill.g, batch.fill.b, 255));
+    nvgFill(ctx);
+    nvgStrokeColor(ctx,
+                   nvgRGBA(batch.stroke.r, batch.stroke.g, batch.stroke.b,
+                           255));
+    nvgStroke(ctx);
+  }
 
-  // Light id text label
-  if (entity->get_type() != kRobot) {
-    nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
-    nvgText(ctx,
-            static_cast<float>(entity->get_pose().x),
-            static_cast<float>(entity->get_pose().y),
-            entity->get_name().c_str(), nullptr);
+  // Light and food id text labels
+  nvgFillColor(ctx, nvgRGBA(0, 0, 0, 255));
+  for (auto &label : batcher_.get_labels()) {
+    nvgText(ctx, label.x, label.y, label.text.c_str(), nullptr);
   }
 }
 
@@ -331,15 +290,13 @@ void GraphicsArenaViewer::DrawUsingNanoVG(NVGcontext *ctx) {
   nvgFontSize(ctx, 18.0f);
   nvgFontFace(ctx, "sans-bold");
   nvgTextAlign(ctx, NVG_ALIGN_CENTER | NVG_ALIGN_MIDDLE);
+
+  nvgSave(ctx);
+  nvgScale(ctx, static_cast<float>(zoom_), static_cast<float>(zoom_));
   DrawArena(ctx);
-  std::vector<ArenaEntity *> entities = arena_->get_entities();
-  for (auto &entity : entities) {
-    DrawEntity(ctx, entity);
-  } /* for(i..) */
-  std::vector<Robot *> robots = arena_->get_robots();
-  for (auto &robot : robots) {
-    DrawRobot(ctx, robot);
-  }
+  batcher_.Build(arena_, zoom_, arena_->get_x_dim(), arena_->get_y_dim());
+  DrawBatches(ctx);
+  nvgRestore(ctx);
 
   // if loss display message
   if (arena_->get_game_status() == LOST) {
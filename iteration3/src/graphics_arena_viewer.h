@@ -16,6 +16,7 @@
 #include "src/controller.h"
 #include "src/common.h"
 #include "src/communication.h"
+#include "src/render_batch.h"
 
 /*******************************************************************************
  * Namespaces
@@ -49,8 +50,9 @@ class Controller;
  *  While the window is open UpdateSimulation will be called repeatedly,
  *  once per frame. It does not advance time if the game is paused.
  *
- *  DrawRobot changes the appearence of the robot depending on the 
- *  hunger level. Also displays 2 white light sensors.
+ *  Robots are colored depending on their hunger level and display 2 white
+ *  light sensors. Everything is drawn in batches of same-colored circles, and
+ *  a zoom slider scales the view.
  */
 class GraphicsArenaViewer : public GraphicsApp {
  public:
@@ -132,33 +134,19 @@ class GraphicsArenaViewer : public GraphicsApp {
  private:
   void DrawArena(NVGcontext *ctx);
   /**
-   * @brief Draw a Robot using `nanogui`.
+   * @brief Draw the batches built by batcher_ using `nanogui`.
    *
    * This function requires an active `nanovg` drawing context (`ctx`), so it
    * should probably only be called from with DrawUsingNanoVG.
-   * 
-   * This function also displays the 2 light sensors on the robot
-   * 
-   * Also checks the state of the robot's hunger and colors the robot
-   * depending on the hunger state. 
-   * Green - not hungry, yellow - hungry but not starving, 
-   * red - starving, purple - starved (dead)
-   *
-   * @param[in] ctx The `nanovg` context.
-   * @param[in] robot The Robot handle.
-   */
-  void DrawRobot(NVGcontext *ctx, const class Robot *const robot);
-
-  /**
-   * @brief Draw an Light in the Arena using `nanogui`.
    *
-   * This function requires an active `nanovg` drawing context (`ctx`), so it
-   * should probably only be called from with DrawUsingNanoVG.
+   * Each batch of same-colored circles is drawn as a single path, so large
+   * populations can be drawn. Robots are colored by hunger state:
+   * Green - not hungry, yellow - hungry but not starving,
+   * red - starving, purple - starved (dead)
    *
    * @param[in] ctx The `nanovg` context.
-   * @param[in] Light The Light handle.
    */
-  void DrawEntity(NVGcontext *ctx, const class ArenaEntity *const entity);
+  void DrawBatches(NVGcontext *ctx);
 
   /**
    * @brief Resets the game upon function call
@@ -176,6 +164,12 @@ class GraphicsArenaViewer : public GraphicsApp {
   // paused
   bool paused_{true};
 
+  // screen pixels per arena unit
+  double zoom_{1.0};
+
+  // groups the entities to draw by color, reused every frame
+  RenderBatcher batcher_{};
+
   // buttons
   nanogui::Button *playing_button_{nullptr};
 
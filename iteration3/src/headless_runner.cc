@@ -0,0 +1,723 @@
+/**
+ * @file headless_runner.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/controller_server.h"
+#include "src/headless_runner.h"
+#include "src/metrics_recorder.h"
+#include "src/obstacle_map.h"
+#include "src/sensor_falloff.h"
+#include "src/vehicle_ensemble.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+/**
+ * @brief A command line option: its flag, and how its value is stored.
+ * set returns false (or throws) if the value is not valid for the option,
+ * and leaves the option as it was.
+ */
+struct option {
+  const char *flag;
+  std::function<bool(const std::string &value)> set;
+};
+
+/**
+ * @brief Parse argv as flag value pairs, setting the option in table with
+ * each flag.
+ *
+ * @return false (after printing the problem) if a flag is not in table, has
+ * no value, or its value is not valid.
+ */
+bool ParseOptions(int argc, char **argv, const std::vector<option> &table) {
+  for (int i = 0; i < argc; i += 2) {
+    std::string arg = argv[i];
+    auto match = std::find_if(table.begin(), table.end(),
+      [&arg](const option &o) { return arg == o.flag; });
+    if (match == table.end()) {
+      std::cerr << "Unknown option " << arg << std::endl;
+      return false;
+    }
+    if (i + 1 >= argc) {
+      std::cerr << "Missing value for " << arg << std::endl;
+      return false;
+    }
+    std::string value = argv[i + 1];
+    bool valid = false;
+    try {
+      valid = match->set(value);
+    } catch (const std::exception &) {  // stoull/stod could not parse it
+    }
+    if (!valid) {
+      std::cerr << "Bad value for " << arg << ": " << value << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Read value, which must be all digits, as a number of at least min
+ * that fits in Number.
+ */
+template <typename Number>
+bool ParseUnsigned(const std::string &value, unsigned int min,
+    Number *number) {
+  if (value.empty() ||
+      value.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  uint64_t parsed = std::stoull(value);
+  if (parsed < min || parsed > std::numeric_limits<Number>::max()) {
+    return false;
+  }
+  *number = static_cast<Number>(parsed);
+  return true;
+}
+
+/**
+ * @brief An option whose value is a whole number of at least min.
+ */
+template <typename Number>
+option UnsignedOption(const char *flag, Number *target,
+    unsigned int min = 0) {
+  return {flag, [target, min](const std::string &value) {
+    return ParseUnsigned(value, min, target);
+  }};
+}
+
+/**
+ * @brief An option whose value is a finite number, not negative.
+ */
+option DoubleOption(const char *flag, double *target) {
+  return {flag, [target](const std::string &value) {
+    size_t end = 0;
+    double parsed = std::stod(value, &end);
+    if (end != value.size() || !std::isfinite(parsed) || parsed < 0) {
+      return false;
+    }
+    *target = parsed;
+    return true;
+  }};
+}
+
+option StringOption(const char *flag, std::string *target) {
+  return {flag, [target](const std::string &value) {
+    *target = value;
+    return true;
+  }};
+}
+
+/**
+ * @brief `--seed`, which is at least 1 in every mode: an arena seeded with 0
+ * seeds itself from the clock, and a run that cannot be repeated is no use
+ * for comparing.
+ */
+option SeedOption(unsigned int *seed) {
+  return UnsignedOption("--seed", seed, 1);
+}
+
+/**
+ * @brief `--format png|ppm`.
+ */
+option FormatOption(FrameFormat *format) {
+  return {"--format", [format](const std::string &value) {
+    if (value != "png" && value != "ppm") {
+      return false;
+    }
+    *format = (value == "png") ? kPNG : kPPM;
+    return true;
+  }};
+}
+
+/**
+ * @brief `--size`, the width and height of a square arena.
+ */
+option SizeOption(arena_params *arena) {
+  return {"--size", [arena](const std::string &value) {
+    uint side = 0;
+    if (!ParseUnsigned(value, 1, &side)) {
+      return false;
+    }
+    arena->x_dim = side;
+    arena->y_dim = side;
+    return true;
+  }};
+}
+
+/**
+ * @brief The options every VehiclePopulation benchmark takes.
+ */
+std::vector<option> PopulationOptions(population_params *population) {
+  return {
+    UnsignedOption("--vehicles", &population->n_vehicles),
+    UnsignedOption("--lights", &population->n_lights),
+    SeedOption(&population->seed)};
+}
+
+/**
+ * @brief Counts the last level cache misses of this thread through the
+ * Linux perf events interface, where the kernel allows it.
+ */
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1,
+      0));
+#endif
+  }
+
+  ~CacheMissCounter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  CacheMissCounter(const CacheMissCounter &other) = delete;
+  CacheMissCounter &operator=(const CacheMissCounter &other) = delete;
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  void Start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /**
+   * @return The misses since Start().
+   */
+  uint64_t Stop() {
+    uint64_t misses = 0;
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &misses, sizeof(misses)) != sizeof(misses)) {
+        misses = 0;
+      }
+    }
+#endif
+    return misses;
+  }
+
+ private:
+  int fd_{-1};
+};
+
+/**
+ * @brief Step population for n_steps, printing the time per step and the
+ * cache misses (if they can be counted).
+ */
+void TimeLocality(const char *name, const population_params &population,
+    unsigned int n_steps, double dt) {
+  VehiclePopulation<double> vehicles(population);
+  CacheMissCounter counter;
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  counter.Start();
+  for (unsigned int step = 0; step < n_steps; ++step) {
+    vehicles.Step(dt);
+  }
+  uint64_t misses = counter.Stop();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  char line[96];
+  snprintf(line, sizeof(line), "%-10s %10.3f ms/step", name,
+    seconds * 1000 / std::max(n_steps, 1u));
+  std::cout << line;
+  if (counter.IsOpen()) {
+    std::cout << "  " << misses / std::max(n_steps, 1u)
+              << " cache misses/step";
+  } else {
+    std::cout << "  (cache misses not countable here)";
+  }
+  std::cout << std::endl;
+}
+
+/**
+ * @brief Move the robots and lights of arena into options.n_clusters normally
+ * distributed clusters.
+ */
+void Cluster(Arena *arena, const broadphase_options &options) {
+  std::mt19937 rng(options.arena.seed);
+  std::uniform_real_distribution<double> center_x(0, options.arena.x_dim);
+  std::uniform_real_distribution<double> center_y(0, options.arena.y_dim);
+  std::vector<std::pair<double, double>> centers;
+  for (unsigned int i = 0; i < std::max(options.n_clusters, 1u); ++i) {
+    centers.emplace_back(center_x(rng), center_y(rng));
+  }
+  std::normal_distribution<double> offset(0, options.cluster_spread);
+  std::vector<ArenaMobileEntity *> mobile(arena->get_robots().begin(),
+    arena->get_robots().end());
+  mobile.insert(mobile.end(), arena->get_lights().begin(),
+    arena->get_lights().end());
+  for (size_t i = 0; i < mobile.size(); ++i) {
+    const std::pair<double, double> &center = centers[i % centers.size()];
+    double radius = mobile[i]->get_radius();
+    mobile[i]->set_position(
+      std::min(std::max(center.first + offset(rng), radius),
+        options.arena.x_dim - radius),
+      std::min(std::max(center.second + offset(rng), radius),
+        options.arena.y_dim - radius));
+  }
+}
+
+/**
+ * @brief Step a population with falloff for n_steps, printing the time per
+ * sensor reading (two per vehicle and light).
+ */
+template <typename Falloff>
+void TimeFalloff(const char *name, const Falloff &falloff,
+    const falloff_options &options) {
+  VehiclePopulation<double, Falloff> vehicles(options.population, falloff);
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  for (unsigned int step = 0; step < options.n_steps; ++step) {
+    vehicles.Step(options.dt);
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  double readings = 2.0 * options.n_steps * options.population.n_vehicles *
+    options.population.n_lights;
+  char line[96];
+  snprintf(line, sizeof(line), "%-20s %8.2f ns/reading", name,
+    readings > 0 ? seconds * 1e9 / readings : 0);
+  std::cout << line << std::endl;
+}
+
+void TimeBroadphase(const char *name, Broadphase broadphase,
+    const broadphase_options &options) {
+  Arena arena(&options.arena);
+  arena.set_broadphase(broadphase);
+  Cluster(&arena, options);
+  size_t collisions = 0;
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  for (unsigned int step = 0; step < options.n_steps; ++step) {
+    arena.AdvanceTime(options.dt);
+    collisions += arena.get_step_stats().collisions;
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  char line[96];
+  snprintf(line, sizeof(line), "%-15s %10.3f ms/step %12zu collisions", name,
+    seconds * 1000 / std::max(options.n_steps, 1u), collisions);
+  std::cout << line << std::endl;
+}
+
+}  // namespace
+
+int RunHeadless(const headless_options &options) {
+  arena_params aparams;
+  ObstacleMap obstacles;
+  if (!options.obstacles_path.empty()) {
+    if (!obstacles.Load(options.obstacles_path)) {
+      std::cerr << "Could not read obstacles " << options.obstacles_path
+                << std::endl;
+      return 1;
+    }
+    aparams.obstacles = &obstacles;
+  }
+  Arena arena(&aparams);
+  arena.set_step_size(options.step_size);
+
+  std::unique_ptr<FrameRecorder> recorder;
+  if (!options.frame_prefix.empty()) {
+    int width = static_cast<int>(std::ceil(aparams.x_dim *
+      options.frame_zoom));
+    int height = static_cast<int>(std::ceil(aparams.y_dim *
+      options.frame_zoom));
+    recorder.reset(new FrameRecorder(options.frame_prefix,
+      options.frame_interval, options.frame_format, width, height,
+      options.frame_zoom, options.n_frame_workers));
+  }
+
+  std::unique_ptr<MetricsRecorder> metrics;
+  if (!options.metrics_csv.empty() || !options.metrics_binary.empty()) {
+    metrics.reset(new MetricsRecorder(options.metrics_interval));
+    if (!options.metrics_csv.empty()) {
+      std::unique_ptr<CsvMetricsSink> csv(
+        new CsvMetricsSink(options.metrics_csv));
+      if (!csv->IsOpen()) {
+        std::cerr << "Could not open " << options.metrics_csv << std::endl;
+        return 1;
+      }
+      metrics->AddSink(std::move(csv));
+    }
+    if (!options.metrics_binary.empty()) {
+      std::unique_ptr<BinaryMetricsSink> binary(
+        new BinaryMetricsSink(options.metrics_binary));
+      if (!binary->IsOpen()) {
+        std::cerr << "Could not open " << options.metrics_binary << std::endl;
+        return 1;
+      }
+      metrics->AddSink(std::move(binary));
+    }
+    arena.set_metrics_recorder(metrics.get());
+  }
+
+  std::unique_ptr<ControllerServer> server;
+  if (!options.server_name.empty()) {
+    server.reset(new ControllerServer(options.server_name,
+      arena.get_robots().size()));
+    if (!server->IsOpen()) {
+      std::cerr << "Could not create " << options.server_name << std::endl;
+      return 1;
+    }
+    arena.set_controller_server(server.get());
+  }
+
+  // the same fixed timestep the graphics viewer advances the arena by
+  unsigned int step = 0;
+  // the cost of the shadows the obstacles cast
+  StepStats shadows;
+  for (; step < options.n_steps && arena.get_game_status() == PLAYING;
+       ++step) {
+    if (recorder) {
+      recorder->Capture(&arena, step);
+    }
+    arena.AdvanceTime(0.05);
+    const StepStats &stats = arena.get_step_stats();
+    shadows.occlusion_rays += stats.occlusion_rays;
+    shadows.occlusion_cache_hits += stats.occlusion_cache_hits;
+    shadows.occluded_readings += stats.occluded_readings;
+  }
+  if (recorder) {
+    recorder->Capture(&arena, step);
+    recorder->Finish();
+  }
+  if (metrics) {
+    metrics->Flush();
+    arena.set_metrics_recorder(nullptr);
+  }
+  if (server) {
+    arena.set_controller_server(nullptr);
+    if (server->get_timeouts() > 0) {
+      std::cerr << "The controller did not answer " << server->get_timeouts()
+                << " steps in time" << std::endl;
+    }
+  }
+
+  std::cout << "Ran " << step << " steps, game status "
+            << arena.get_game_status() << std::endl;
+  if (!obstacles.is_empty()) {
+    std::cout << "Cast " << shadows.occlusion_rays << " lines of sight, "
+              << "reused " << shadows.occlusion_cache_hits << " pairs, "
+              << shadows.occluded_readings << " in shadow" << std::endl;
+  }
+  if (recorder) {
+    std::cout << "Wrote " << recorder->get_frames_written() << " frames"
+              << std::endl;
+    if (recorder->get_frames_failed() > 0) {
+      std::cerr << "Could not write " << recorder->get_frames_failed()
+                << " frames" << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+bool ParseHeadlessOptions(int argc, char **argv, headless_options *options) {
+  return ParseOptions(argc, argv, {
+    UnsignedOption("--steps", &options->n_steps),
+    UnsignedOption("--step-size", &options->step_size, 1),
+    StringOption("--frames", &options->frame_prefix),
+    UnsignedOption("--every", &options->frame_interval),
+    FormatOption(&options->frame_format),
+    DoubleOption("--zoom", &options->frame_zoom),
+    StringOption("--metrics-csv", &options->metrics_csv),
+    StringOption("--metrics-bin", &options->metrics_binary),
+    UnsignedOption("--metrics-every", &options->metrics_interval),
+    StringOption("--server", &options->server_name),
+    StringOption("--obstacles", &options->obstacles_path),
+    UnsignedOption("--workers", &options->n_frame_workers)});
+}
+
+int RunEvolution(const evolution_params &params) {
+  BehaviorOptimizer optimizer(params);
+  if (!params.checkpoint_path.empty() &&
+      std::ifstream(params.checkpoint_path).good()) {
+    if (!optimizer.LoadCheckpoint(params.checkpoint_path)) {
+      std::cerr << "Could not read checkpoint " << params.checkpoint_path
+                << std::endl;
+      return 1;
+    }
+    std::cout << "Continuing after generation "
+              << optimizer.get_generations_done() << std::endl;
+  }
+
+  optimizer.Run([](unsigned int generation,
+      const std::vector<BehaviorOptimizer::Individual> &population) {
+    double total = 0;
+    for (auto &individual : population) {
+      total += individual.fitness;
+    }
+    std::cout << "Generation " << generation << ": best "
+              << population.front().fitness << " mean "
+              << total / population.size() << std::endl;
+  });
+
+  std::cout << "Best fitness " << optimizer.get_best().fitness
+            << ", genome";
+  for (double gene : optimizer.get_best().genome) {
+    std::cout << " " << gene;
+  }
+  std::cout << std::endl;
+  return 0;
+}
+
+bool ParseEvolutionOptions(int argc, char **argv, evolution_params *params) {
+  return ParseOptions(argc, argv, {
+    UnsignedOption("--generations", &params->generations),
+    UnsignedOption("--population", &params->population_size),
+    UnsignedOption("--trials", &params->trials),
+    UnsignedOption("--max-steps", &params->max_steps),
+    UnsignedOption("--elites", &params->elite_count),
+    UnsignedOption("--threads", &params->n_threads),
+    SeedOption(&params->seed),
+    StringOption("--checkpoint", &params->checkpoint_path)});
+}
+
+int RunPrecisionBenchmark(const precision_options &options) {
+  VehiclePopulation<float> single(options.population);
+  VehiclePopulation<double> dual(options.population);
+  size_t n = dual.get_size();
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration single_time = Clock::duration::zero();
+  Clock::duration dual_time = Clock::duration::zero();
+  std::cout << "step      mean drift   max drift" << std::endl;
+  unsigned int next_report = 10;
+  for (unsigned int step = 1; step <= options.n_steps; ++step) {
+    Clock::time_point start = Clock::now();
+    single.Step(static_cast<float>(options.dt));
+    Clock::time_point middle = Clock::now();
+    dual.Step(options.dt);
+    dual_time += Clock::now() - middle;
+    single_time += middle - start;
+
+    if (step == next_report || step == options.n_steps) {
+      double total = 0;
+      double most = 0;
+      for (uint32_t id = 0; id < n; ++id) {
+        BasicPose<float> a = single.get_pose(single.get_index(id));
+        BasicPose<double> b = dual.get_pose(dual.get_index(id));
+        double drift = dual.WrappedDistance(a.x, a.y, b.x, b.y);
+        total += drift;
+        most = std::max(most, drift);
+      }
+      char line[64];
+      snprintf(line, sizeof(line), "%-8u %12.6f %11.6f", step,
+        n > 0 ? total / n : 0, most);
+      std::cout << line << std::endl;
+      next_report *= 10;
+    }
+  }
+
+  double steps = static_cast<double>(options.n_steps) * n;
+  double single_rate = steps /
+    std::chrono::duration<double>(single_time).count();
+  double dual_rate = steps / std::chrono::duration<double>(dual_time).count();
+  std::cout << "float:  " << single_rate << " vehicle steps/s" << std::endl
+            << "double: " << dual_rate << " vehicle steps/s" << std::endl
+            << "float/double throughput: " << single_rate / dual_rate
+            << std::endl;
+  return 0;
+}
+
+int RunLocalityBenchmark(const locality_options &options) {
+  population_params population = options.population;
+  population.sort_interval = 0;
+  TimeLocality("unsorted", population, options.n_steps, options.dt);
+  population.sort_interval = options.population.sort_interval;
+  TimeLocality("morton", population, options.n_steps, options.dt);
+  return 0;
+}
+
+int RunEnsembleBenchmark(const ensemble_options &options) {
+  const size_t lanes = 8;
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  std::vector<std::unique_ptr<VehiclePopulation<double>>> populations;
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    population_params params = options.population;
+    params.seed += static_cast<unsigned int>(lane);
+    populations.emplace_back(new VehiclePopulation<double>(params));
+  }
+  for (unsigned int step = 0; step < options.n_steps; ++step) {
+    for (auto &population : populations) {
+      population->Step(options.dt);
+    }
+  }
+  Clock::time_point middle = Clock::now();
+  VehicleEnsemble<double, lanes> ensemble(options.population);
+  for (unsigned int step = 0; step < options.n_steps; ++step) {
+    ensemble.Step(options.dt);
+  }
+  Clock::time_point end = Clock::now();
+
+  size_t mismatches = 0;
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    for (size_t i = 0; i < ensemble.get_size(); ++i) {
+      BasicPose<double> a = populations[lane]->get_pose(i);
+      BasicPose<double> b = ensemble.get_pose(lane, i);
+      if (std::memcmp(&a, &b, sizeof(a)) != 0) {
+        ++mismatches;
+      }
+    }
+  }
+  double steps = static_cast<double>(options.n_steps) * lanes *
+    ensemble.get_size();
+  double scalar_rate = steps /
+    std::chrono::duration<double>(middle - start).count();
+  double ensemble_rate = steps /
+    std::chrono::duration<double>(end - middle).count();
+  std::cout << "populations: " << scalar_rate << " vehicle steps/s"
+            << std::endl
+            << "ensemble:    " << ensemble_rate << " vehicle steps/s"
+            << std::endl
+            << "ensemble/populations throughput: "
+            << ensemble_rate / scalar_rate << std::endl
+            << "mismatched vehicles: " << mismatches << std::endl;
+  return mismatches == 0 ? 0 : 1;
+}
+
+int RunFalloffBenchmark(const falloff_options &options) {
+  GaussianFalloff<double> gaussian;
+  TimeFalloff("power (pow)", PowerFalloff<double>(), options);
+  TimeFalloff("inverse square", InverseSquareFalloff<double>(), options);
+  TimeFalloff("exponential", ExponentialFalloff<double>(), options);
+  TimeFalloff("gaussian", gaussian, options);
+  TimeFalloff("gaussian (table)",
+    TabulatedFalloff<double>::Tabulate(gaussian, 1000), options);
+  TimeFalloff("piecewise (table)", TabulatedFalloff<double>(
+    {{0, 1}, {200, 0.5}, {800, 0.05}, {2000, 0}}, 2000), options);
+  return 0;
+}
+
+int RunBroadphaseBenchmark(const broadphase_options &options) {
+  TimeBroadphase("brute force", kBruteForce, options);
+  TimeBroadphase("sweep and prune", kSweepAndPrune, options);
+  return 0;
+}
+
+int RunSpawnBenchmark(const spawn_options &options) {
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+  Arena arena(&options.arena);
+  double setup = std::chrono::duration<double, std::milli>(
+    Clock::now() - start).count();
+  std::cout << "entities: " << arena.get_entities().size() << std::endl
+            << "setup ms: " << setup << std::endl;
+
+  start = Clock::now();
+  for (unsigned int reset = 0; reset < options.n_resets; ++reset) {
+    arena.Reset();
+  }
+  if (options.n_resets > 0) {
+    std::cout << "reset ms: " << std::chrono::duration<double, std::milli>(
+      Clock::now() - start).count() / options.n_resets << std::endl;
+  }
+  return 0;
+}
+
+bool ParsePrecisionOptions(int argc, char **argv,
+    precision_options *options) {
+  std::vector<option> table = PopulationOptions(&options->population);
+  table.push_back(UnsignedOption("--steps", &options->n_steps));
+  return ParseOptions(argc, argv, table);
+}
+
+bool ParseLocalityOptions(int argc, char **argv, locality_options *options) {
+  std::vector<option> table = PopulationOptions(&options->population);
+  table.push_back(UnsignedOption("--steps", &options->n_steps));
+  table.push_back(DoubleOption("--range",
+    &options->population.neighbor_range));
+  table.push_back(UnsignedOption("--sort-every",
+    &options->population.sort_interval, 1));
+  return ParseOptions(argc, argv, table);
+}
+
+bool ParseEnsembleOptions(int argc, char **argv, ensemble_options *options) {
+  std::vector<option> table = PopulationOptions(&options->population);
+  table.push_back(UnsignedOption("--steps", &options->n_steps));
+  return ParseOptions(argc, argv, table);
+}
+
+bool ParseFalloffOptions(int argc, char **argv, falloff_options *options) {
+  std::vector<option> table = PopulationOptions(&options->population);
+  table.push_back(UnsignedOption("--steps", &options->n_steps));
+  return ParseOptions(argc, argv, table);
+}
+
+bool ParseBroadphaseOptions(int argc, char **argv,
+    broadphase_options *options) {
+  return ParseOptions(argc, argv, {
+    UnsignedOption("--steps", &options->n_steps),
+    UnsignedOption("--lights", &options->arena.n_Lights),
+    SizeOption(&options->arena),
+    UnsignedOption("--clusters", &options->n_clusters),
+    DoubleOption("--spread", &options->cluster_spread),
+    SeedOption(&options->arena.seed)});
+}
+
+bool ParseSpawnOptions(int argc, char **argv, spawn_options *options) {
+  return ParseOptions(argc, argv, {
+    UnsignedOption("--foods", &options->arena.n_Foods),
+    UnsignedOption("--lights", &options->arena.n_Lights),
+    SizeOption(&options->arena),
+    UnsignedOption("--resets", &options->n_resets),
+    SeedOption(&options->arena.seed)});
+}
+
+NAMESPACE_END(csci3081);
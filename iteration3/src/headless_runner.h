@@ -0,0 +1,283 @@
+/**
+ * @file headless_runner.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_HEADLESS_RUNNER_H_
+#define SRC_HEADLESS_RUNNER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <string>
+
+#include "src/arena_params.h"
+#include "src/behavior_optimizer.h"
+#include "src/common.h"
+#include "src/frame_recorder.h"
+#include "src/vehicle_population.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Options for running the simulation without a window.
+ */
+struct headless_options {
+  // # of timesteps to run, unless the simulation ends first
+  unsigned int n_steps{1000};
+  // # of ticks each timestep advances entities by (see
+  // Arena::set_step_size())
+  unsigned int step_size{1};
+  // path prefix of the frame files; no frames are written if empty
+  std::string frame_prefix{};
+  // write a frame every frame_interval steps
+  unsigned int frame_interval{1};
+  FrameFormat frame_format{kPPM};
+  // pixels per arena unit in the frames
+  double frame_zoom{1.0};
+  // # of frame rendering threads, 0 for one per core
+  unsigned int n_frame_workers{0};
+  // metrics files; no metrics are recorded if both are empty
+  std::string metrics_csv{};
+  std::string metrics_binary{};
+  // record metrics every metrics_interval steps
+  unsigned int metrics_interval{1};
+  // shared memory name (e.g. "/braitenberg") external controllers attach
+  // to; no server is started if empty
+  std::string server_name{};
+  // obstacle file (see ObstacleMap::Read()); no obstacles if empty
+  std::string obstacles_path{};
+};
+
+/**
+ * @brief Options for comparing the single and double precision kernels.
+ */
+struct precision_options {
+  population_params population{};
+  // # of timesteps to run both populations
+  unsigned int n_steps{10000};
+  double dt{0.05};
+};
+
+/**
+ * @brief Options for timing a VehiclePopulation in creation order and in
+ * Morton order.
+ */
+struct locality_options {
+  population_params population{100000, 16, 4000, 4000, 1, 20, 10};
+  unsigned int n_steps{100};
+  double dt{0.05};
+};
+
+/**
+ * @brief Options for comparing an ensemble of populations with the same
+ * populations stepped one at a time.
+ */
+struct ensemble_options {
+  population_params population{2048, 16, 4000, 4000, 1, 0, 0};
+  unsigned int n_steps{100};
+  double dt{0.05};
+};
+
+/**
+ * @brief Options for timing a VehiclePopulation with each sensor falloff
+ * model.
+ */
+struct falloff_options {
+  population_params population{16384, 16, 4000, 4000, 1, 0, 0};
+  unsigned int n_steps{50};
+  double dt{0.05};
+};
+
+/**
+ * @brief Options for timing the broadphases on an arena whose entities are
+ * piled up in a few clusters.
+ */
+struct broadphase_options {
+  arena_params arena{2000, N_FoodS, 4000, 4000, 1};
+  // # of clusters, and the standard deviation of the distance of an entity
+  // from the center of its cluster
+  unsigned int n_clusters{4};
+  double cluster_spread{150};
+  unsigned int n_steps{300};
+  double dt{0.05};
+};
+
+/**
+ * @brief Options for timing how long an arena with many entities takes to
+ * set up and reset.
+ */
+struct spawn_options {
+  arena_params arena{N_LightS, 1000000, 100000, 100000, 1};
+  unsigned int n_resets{3};
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Run an Arena with the default parameters for options.n_steps
+ * timesteps, or until the simulation is over, optionally writing frames and
+ * metrics and serving an external controller.
+ *
+ * @return 0 on success, 1 if any frame or metrics file could not be written
+ * or the controller server could not be started.
+ */
+int RunHeadless(const headless_options &options);
+
+/**
+ * @brief Parse headless options from command line arguments, e.g.
+ * `--steps 5000 --step-size 10 --frames out/frame_ --every 10 --format png
+ * --zoom 0.5 --metrics-csv out/metrics.csv --metrics-every 10
+ * --server /braitenberg`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseHeadlessOptions(int argc, char **argv, headless_options *options);
+
+/**
+ * @brief Evolve robot behaviors with a BehaviorOptimizer, printing the
+ * fitness of each generation and the best genome at the end. If the
+ * checkpoint file exists, the run continues from it.
+ *
+ * @return 0 on success, 1 if the checkpoint could not be read.
+ */
+int RunEvolution(const evolution_params &params);
+
+/**
+ * @brief Parse evolution parameters from command line arguments, e.g.
+ * `--generations 50 --population 64 --trials 3 --max-steps 5000
+ * --elites 2 --threads 8 --seed 7 --checkpoint evolve.txt`.
+ *
+ * @param[out] params Receives the parsed parameters.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseEvolutionOptions(int argc, char **argv, evolution_params *params);
+
+/**
+ * @brief Step a float and a double VehiclePopulation from the same start,
+ * printing the throughput of each and how far apart their vehicles drift.
+ *
+ * @return 0.
+ */
+int RunPrecisionBenchmark(const precision_options &options);
+
+/**
+ * @brief Parse precision benchmark options from command line arguments,
+ * e.g. `--steps 10000 --vehicles 4096 --lights 16 --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParsePrecisionOptions(int argc, char **argv,
+  precision_options *options);
+
+/**
+ * @brief Step a large VehiclePopulation with neighbor queries, first in
+ * creation order and then reordered along a Morton curve, printing the time
+ * per step and the cache misses of each.
+ *
+ * @return 0.
+ */
+int RunLocalityBenchmark(const locality_options &options);
+
+/**
+ * @brief Parse locality benchmark options from command line arguments, e.g.
+ * `--steps 100 --vehicles 100000 --lights 16 --range 20 --sort-every 10
+ * --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseLocalityOptions(int argc, char **argv, locality_options *options);
+
+/**
+ * @brief Step 8 populations with consecutive seeds one at a time and then
+ * as a VehicleEnsemble, printing the throughput of each and the # of
+ * vehicles whose poses differ (which should be 0).
+ *
+ * @return 0 if every lane matched its population, 1 otherwise.
+ */
+int RunEnsembleBenchmark(const ensemble_options &options);
+
+/**
+ * @brief Parse ensemble benchmark options from command line arguments, e.g.
+ * `--steps 100 --vehicles 2048 --lights 16 --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseEnsembleOptions(int argc, char **argv, ensemble_options *options);
+
+/**
+ * @brief Step the same population with each falloff policy (see
+ * sensor_falloff.h), printing the time per sensor reading of each.
+ *
+ * @return 0.
+ */
+int RunFalloffBenchmark(const falloff_options &options);
+
+/**
+ * @brief Parse falloff benchmark options from command line arguments, e.g.
+ * `--steps 50 --vehicles 16384 --lights 16 --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseFalloffOptions(int argc, char **argv, falloff_options *options);
+
+/**
+ * @brief Step the same clustered arena with each broadphase, printing the
+ * time per step and the collisions each found (which should be the same).
+ *
+ * @return 0.
+ */
+int RunBroadphaseBenchmark(const broadphase_options &options);
+
+/**
+ * @brief Parse broadphase benchmark options from command line arguments,
+ * e.g. `--steps 300 --lights 2000 --size 4000 --clusters 4 --spread 150
+ * --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseBroadphaseOptions(int argc, char **argv,
+  broadphase_options *options);
+
+/**
+ * @brief Construct and Reset() an arena, printing the time each takes to
+ * spawn its entities (see PoissonDiskSampler).
+ *
+ * @return 0.
+ */
+int RunSpawnBenchmark(const spawn_options &options);
+
+/**
+ * @brief Parse spawn benchmark options from command line arguments, e.g.
+ * `--foods 1000000 --lights 8 --size 100000 --resets 3 --seed 1`.
+ *
+ * @param[out] options Receives the parsed options.
+ *
+ * @return false (after printing the problem) if an argument is not valid.
+ */
+bool ParseSpawnOptions(int argc, char **argv, spawn_options *options);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_HEADLESS_RUNNER_H_
@@ -0,0 +1,64 @@
+/**
+ * @file interaction_table.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_INTERACTION_TABLE_H_
+#define SRC_INTERACTION_TABLE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+#include "src/entity_type.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/**
+ * @brief What an entity does about another entity (or a wall).
+ */
+enum Interaction {
+  kIgnore,   // never looked at together
+  kSense,    // the entity's sensors see the other, but they never touch
+  kCollide   // they bounce off each other
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief How an entity of type `type` interacts with one of type `other`.
+ *
+ * This table is the only place the rules live: the arena's pair loops are
+ * generated from it, so a new entity type only needs a row and a column
+ * here. kCollide must be symmetric; kSense need not be (a robot senses a
+ * light, the light does not sense the robot).
+ */
+constexpr Interaction GetInteraction(EntityType type, EntityType other) {
+  // rows are `type`, columns are `other`
+  const Interaction entities[kEntity + 1][kEntity + 1] = {
+    //           kRobot    kLight    kFood    kEntity
+    /* kRobot */ {kCollide, kSense,   kSense,  kIgnore},
+    /* kLight */ {kIgnore,  kCollide, kIgnore, kIgnore},
+    /* kFood */  {kIgnore,  kIgnore,  kIgnore, kIgnore},
+    /* kEntity */ {kIgnore, kIgnore,  kIgnore, kIgnore}
+  };
+  // how each type interacts with any of the four walls and the obstacles
+  const Interaction walls[kEntity + 1] = {
+    /* kRobot */ kCollide, /* kLight */ kCollide,
+    /* kFood */ kIgnore, /* kEntity */ kIgnore
+  };
+
+  if (type > kEntity || other == kUndefined) {
+    return kIgnore;
+  }
+  return other > kEntity ? walls[type] : entities[type][other];
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_INTERACTION_TABLE_H_
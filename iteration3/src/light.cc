@@ -29,29 +29,48 @@ void Light::Reset() {
   set_pose(SetPoseRandomly());
   set_radius(random() % (Light_MAX_RADIUS - Light_MIN_RADIUS + 1) +
     Light_MIN_RADIUS);
+  segment_valid_ = false;
 } /* Reset() */
 
 void Light::TimestepUpdate(unsigned int dt) {
   if (time_ >= reverse_start_ + reverse_duration_) {
+    if (reverse_) {
+      segment_valid_ = false;
+    }
     reverse_ = false;
     motion_handler_velocity_ = defaultSpeed;
   }
 
-  // Use velocity and position to update position
-  motion_behavior_.UpdatePose(dt, motion_handler_velocity_);
+  if (analytic_) {
+    if (!segment_valid_ || get_pose_changes() != segment_pose_changes_) {
+      const Pose &pose = get_pose();
+      segment_ = BeginSegment<double>({pose.x, pose.y, pose.theta},
+        {motion_handler_velocity_.left, motion_handler_velocity_.right});
+      segment_time_ = 0;
+      segment_valid_ = true;
+    }
+    segment_time_ += dt;
+    set_pose(PoseAt(segment_time_));
+    segment_pose_changes_ = get_pose_changes();
+  } else {
+    // Use velocity and position to update position
+    motion_behavior_.UpdatePose(dt, motion_handler_velocity_);
+  }
 
   // Reset Sensor for next cycle
   sensor_touch_->Reset();
 } /* TimestepUpdate() */
 
 void Light::HandleCollision(EntityType object_type, ArenaEntity * object) {
-  // Lights should reverse arc after collisions with other lights and the wall
+  // Lights should reverse arc after collisions with other lights, the walls
+  // and the obstacles
   if (object_type == kLight || object_type == kRightWall ||
       object_type == kLeftWall || object_type == kTopWall ||
-      object_type == kBottomWall) {
+      object_type == kBottomWall || object_type == kObstacle) {
     reverse_start_ = time_;
     reverse_ = true;
     motion_handler_velocity_ = reverseArc;
+    segment_valid_ = false;
 
     sensor_touch_->HandleCollision(object_type, object);
   }
@@ -17,6 +17,7 @@
 #include "src/common.h"
 #include "src/entity_type.h"
 #include "src/pose.h"
+#include "src/vehicle_kernel.h"
 
 /*******************************************************************************
  * Namespaces
@@ -73,6 +74,37 @@ class Light : public ArenaMobileEntity {
 
   void set_time(double time) { time_ = time; }
 
+  /**
+   * @brief Move along closed-form segments instead of integrating the
+   * motion every timestep.
+   *
+   * While its wheel velocities stay the same and nothing else moves it, the
+   * light is on one straight line or circular arc, and its pose is computed
+   * from where the segment began (see SegmentPose()). A collision, the end
+   * of a reverse or a pose set from outside begins a new segment. Poses do
+   * not pick up rounding error step by step, so they differ from the
+   * integrated ones in the last bits.
+   */
+  void set_analytic(bool analytic) {
+    analytic_ = analytic;
+    segment_valid_ = false;
+  }
+  bool is_analytic() const { return analytic_; }
+
+  /**
+   * @brief The pose t timesteps after the current segment began, if nothing
+   * ends it first. Only meaningful in analytic mode.
+   */
+  Pose PoseAt(double t) const {
+    BasicPose<double> pose = SegmentPose(segment_, t);
+    return Pose(pose.x, pose.y, pose.theta);
+  }
+
+  /**
+   * @brief # of timesteps since the current segment began.
+   */
+  double get_segment_time() const { return segment_time_; }
+
  private:
   // Manages pose and wheel velocities that change with time and collisions.
   WheelVelocity motion_handler_velocity_{2, 2};
@@ -93,6 +125,14 @@ class Light : public ArenaMobileEntity {
   // this is the current time updated by arena every timestep
   // this is used for timing of reversing
   double time_{0.0};
+  // the segment moved along in analytic mode, the timesteps since it began
+  // and the pose changes once it last set the light's pose; any pose set
+  // from outside since begins a new segment
+  bool analytic_{false};
+  bool segment_valid_{false};
+  MotionSegment<double> segment_{};
+  double segment_time_{0};
+  unsigned int segment_pose_changes_{0};
 };
 
 NAMESPACE_END(csci3081);
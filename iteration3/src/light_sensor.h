@@ -14,6 +14,7 @@
 
 #include "src/sensor.h"
 #include "src/params.h"
+#include "src/sensor_falloff.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
@@ -27,20 +28,36 @@ NAMESPACE_BEGIN(csci3081);
  * Displayed as white circles on the robot.
  * 
  * Receives position information about Lights from the arena and updates reading.
+ *
+ * @tparam Falloff How the reading from one light falls off with the distance
+ * to it (see sensor_falloff.h).
  */
-class LightSensor : public Sensor {
+template <typename Falloff>
+class BasicLightSensor : public Sensor {
  public:
-  LightSensor();
+  explicit BasicLightSensor(const Falloff &falloff = Falloff())
+      : falloff_(falloff) {
+    color_.Set(kWhite);
+  }
 
   /**
   * @brief Update reading based on distance and formula
   */
-  void Notify(Pose position) override;
+  void Notify(Pose position) override {
+    reading_ += falloff_(numerator_value_, calculateDistance(position));
+  }
+
+  const Falloff &get_falloff() const { return falloff_; }
 
  private:
-  double base_{1.08};
+  Falloff falloff_;
 };
 
+/**
+ * @brief A light sensor with the arena's default falloff.
+ */
+typedef BasicLightSensor<PowerFalloff<double>> LightSensor;
+
 NAMESPACE_END(csci3081);
 
 #endif  // SRC_LIGHT_SENSOR_H_
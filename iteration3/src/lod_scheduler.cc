@@ -0,0 +1,145 @@
+/**
+ * @file lod_scheduler.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/interaction_table.h"
+#include "src/lod_scheduler.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+typedef std::pair<int64_t, ArenaEntity *> cell_entry;
+
+int64_t CellKey(int64_t column, int64_t row) {
+  return static_cast<int64_t>((static_cast<uint64_t>(column) << 32) ^
+    (static_cast<uint64_t>(row) & 0xffffffff));
+}
+
+int64_t CellOf(double coordinate, double cell_size) {
+  return static_cast<int64_t>(std::floor(coordinate / cell_size));
+}
+
+/**
+ * @brief Whether ent interacts with other: they collide, or ent is a robot
+ * that could eat other.
+ */
+bool Interacts(const ArenaEntity *ent, const ArenaEntity *other) {
+  return GetInteraction(ent->get_type(), other->get_type()) == kCollide ||
+    (ent->get_type() == kRobot && other->get_type() == kFood);
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+lod_report LodScheduler::Apply(Arena *arena, double dt,
+    const Pose &origin) const {
+  std::vector<ArenaMobileEntity *> mobile;
+  mobile.insert(mobile.end(), arena->get_robots().begin(),
+    arena->get_robots().end());
+  mobile.insert(mobile.end(), arena->get_lights().begin(),
+    arena->get_lights().end());
+
+  // bucket every entity in cells wide enough that anything it interacts
+  // with is in its own or a neighboring cell
+  double max_radius = 0;
+  for (auto ent : mobile) {
+    max_radius = std::max(max_radius, ent->get_radius());
+  }
+  for (auto food : arena->get_foods()) {
+    max_radius = std::max(max_radius, food->get_radius());
+  }
+  double cell_size = std::max(params_.interaction_distance + 2 * max_radius,
+    1.0);
+  std::vector<cell_entry> cells;
+  cells.reserve(mobile.size() + arena->get_foods().size());
+  auto bucket = [&](ArenaEntity *ent) {
+    cells.emplace_back(CellKey(CellOf(ent->get_pose().x, cell_size),
+      CellOf(ent->get_pose().y, cell_size)), ent);
+  };
+  for (auto ent : mobile) {
+    bucket(ent);
+  }
+  for (auto food : arena->get_foods()) {
+    bucket(food);
+  }
+  auto by_key = [](const cell_entry &a, const cell_entry &b) {
+    return a.first < b.first; };
+  std::sort(cells.begin(), cells.end(), by_key);
+
+  auto near_interaction = [&](ArenaMobileEntity *ent) {
+    const Pose &pose = ent->get_pose();
+    double reach = ent->get_radius() + params_.interaction_distance;
+    // walls, or a neighboring tile's ghosts past the edge
+    if (pose.x < reach || pose.y < reach ||
+        pose.x > arena->get_x_dim() - reach ||
+        pose.y > arena->get_y_dim() - reach) {
+      return true;
+    }
+    int64_t column = CellOf(pose.x, cell_size);
+    int64_t row = CellOf(pose.y, cell_size);
+    for (int64_t c = column - 1; c <= column + 1; ++c) {
+      for (int64_t r = row - 1; r <= row + 1; ++r) {
+        auto range = std::equal_range(cells.begin(), cells.end(),
+          cell_entry(CellKey(c, r), nullptr), by_key);
+        for (auto it = range.first; it != range.second; ++it) {
+          ArenaEntity *other = it->second;
+          if (other == ent || !Interacts(ent, other)) {
+            continue;
+          }
+          double dx = other->get_pose().x - pose.x;
+          double dy = other->get_pose().y - pose.y;
+          double distance = reach + other->get_radius();
+          if (dx * dx + dy * dy <= distance * distance) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  };
+
+  lod_report report;
+  for (auto ent : mobile) {
+    double x = origin.x + ent->get_pose().x;
+    double y = origin.y + ent->get_pose().y;
+    bool in_view = x >= view_min_x_ - params_.margin &&
+      x <= view_max_x_ + params_.margin &&
+      y >= view_min_y_ - params_.margin &&
+      y <= view_max_y_ + params_.margin;
+    if (in_view || params_.coarse_interval <= 1 || near_interaction(ent)) {
+      ent->set_update_interval(1);
+      ++report.fine_entities;
+    } else {
+      ent->set_update_interval(params_.coarse_interval);
+      ++report.coarse_entities;
+    }
+  }
+  if (report.coarse_entities > 0) {
+    report.divergence_bound = 2 * params_.max_speed * dt *
+      (params_.coarse_interval - 1);
+  }
+  return report;
+}
+
+NAMESPACE_END(csci3081);
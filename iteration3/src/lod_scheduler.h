@@ -0,0 +1,120 @@
+/**
+ * @file lod_scheduler.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_LOD_SCHEDULER_H_
+#define SRC_LOD_SCHEDULER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+
+#include "src/common.h"
+#include "src/params.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class Arena;
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Parameters of a LodScheduler.
+ */
+struct lod_params {
+  // entities at a coarse level of detail are updated once every this many
+  // timesteps, by all of them at once
+  unsigned int coarse_interval{4};
+  // entities this far outside the view are still updated every timestep
+  double margin{100};
+  // entities this close (edge to edge) to something they collide with or
+  // eat, or to the edge of their arena, are updated every timestep
+  double interaction_distance{60};
+  // the fastest any entity moves, in distance per unit of time
+  double max_speed{ROBOT_MAX_SPEED};
+};
+
+/**
+ * @brief What a LodScheduler::Apply() did to an arena.
+ */
+struct lod_report {
+  // mobile entities updated every timestep
+  size_t fine_entities{0};
+  // mobile entities updated once every coarse_interval timesteps
+  size_t coarse_entities{0};
+  // the furthest a coarse entity can be from where updating it every
+  // timestep would have put it, by the end of each of its updates
+  double divergence_bound{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Chooses the level of detail of each mobile entity of an Arena, so a
+ * large world only spends full fidelity where it is watched or where
+ * something happens.
+ *
+ * Call Apply() before each Arena::AdvanceTime(). Robots and lights inside
+ * the view (grown by `margin`), or within `interaction_distance` of an
+ * entity they collide with, food they could eat or the edge of their arena,
+ * are updated every timestep. The rest are updated once every
+ * `coarse_interval` timesteps with a substep covering the timesteps they
+ * skipped (ArenaMobileEntity::set_update_interval()), and their robots only
+ * read their sensors on those timesteps. An entity is back to full detail
+ * on the first Apply() after it comes near the view or an interaction.
+ *
+ * Between its updates a coarse entity keeps still, and during one it keeps
+ * the wheel velocities it chose at its start. Since nothing moves faster
+ * than `max_speed`, either way it ends each update at most
+ * 2 * max_speed * dt * (coarse_interval - 1) from where a full detail run
+ * from the same state would have put it; lod_report::divergence_bound
+ * reports this bound.
+ */
+class LodScheduler {
+ public:
+  explicit LodScheduler(const lod_params &params) : params_(params) {}
+
+  /**
+   * @brief Set the visible region, in the coordinates Apply() is given the
+   * origin in (e.g. the world's, for the tiles of a TiledWorld).
+   */
+  void set_view(double min_x, double min_y, double max_x, double max_y) {
+    view_min_x_ = min_x;
+    view_min_y_ = min_y;
+    view_max_x_ = max_x;
+    view_max_y_ = max_y;
+  }
+
+  /**
+   * @brief Set the update interval of every robot and light of arena for
+   * the next timesteps.
+   *
+   * @param dt The timestep the arena is advanced by.
+   * @param origin The position of arena's (0, 0) in view coordinates.
+   */
+  lod_report Apply(Arena *arena, double dt, const Pose &origin = Pose())
+    const;
+
+  const lod_params &get_params() const { return params_; }
+
+ private:
+  lod_params params_;
+  // everything is in view until set_view() is called
+  double view_min_x_{-1e300};
+  double view_min_y_{-1e300};
+  double view_max_x_{1e300};
+  double view_max_y_{1e300};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_LOD_SCHEDULER_H_
@@ -8,16 +8,108 @@
  * Includes
  ******************************************************************************/
 #include <iostream>
+#include <string>
 
 #include "src/arena_params.h"
 #include "src/controller.h"
 #include "src/graphics_arena_viewer.h"
+#include "src/headless_runner.h"
 
 
 /*******************************************************************************
  * Non-Member Functions
  ******************************************************************************/
-int main(__unused int argc, __unused char **argv) {
+namespace {
+
+/**
+ * @brief Parse the arguments after a mode's flag into options and run the
+ * mode with them.
+ */
+template <typename Options>
+int RunMode(int argc, char **argv, bool (*parse)(int, char **, Options *),
+    int (*run)(const Options &)) {
+  Options options;
+  if (!parse(argc, argv, &options)) {
+    return 1;
+  }
+  return run(options);
+}
+
+/**
+ * @brief A way of running without the graphics viewer, chosen by the first
+ * argument.
+ */
+struct mode {
+  const char *flag;
+  int (*run)(int argc, char **argv);
+};
+
+const mode kModes[] = {
+  // Without a display: arenaviewer --headless [--steps N] [--step-size N]
+  // [--frames PREFIX] [--every K] [--format ppm|png] [--zoom Z]
+  // [--workers N] [--metrics-csv FILE] [--metrics-bin FILE]
+  // [--metrics-every K] [--server NAME] [--obstacles FILE]
+  {"--headless", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseHeadlessOptions,
+      csci3081::RunHeadless);
+  }},
+  // Evolve behaviors: arenaviewer --evolve [--generations N]
+  // [--population N] [--trials N] [--max-steps N] [--elites N]
+  // [--threads N] [--seed N] [--checkpoint FILE]
+  {"--evolve", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseEvolutionOptions,
+      csci3081::RunEvolution);
+  }},
+  // Compare float and double kernels: arenaviewer --bench-precision
+  // [--steps N] [--vehicles N] [--lights N] [--seed N]
+  {"--bench-precision", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParsePrecisionOptions,
+      csci3081::RunPrecisionBenchmark);
+  }},
+  // Time Morton ordering: arenaviewer --bench-locality [--steps N]
+  // [--vehicles N] [--lights N] [--range R] [--sort-every K] [--seed N]
+  {"--bench-locality", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseLocalityOptions,
+      csci3081::RunLocalityBenchmark);
+  }},
+  // Step populations in lanes: arenaviewer --bench-ensemble [--steps N]
+  // [--vehicles N] [--lights N] [--seed N]
+  {"--bench-ensemble", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseEnsembleOptions,
+      csci3081::RunEnsembleBenchmark);
+  }},
+  // Time the sensor falloff models: arenaviewer --bench-falloff [--steps N]
+  // [--vehicles N] [--lights N] [--seed N]
+  {"--bench-falloff", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseFalloffOptions,
+      csci3081::RunFalloffBenchmark);
+  }},
+  // Compare broadphases on clusters: arenaviewer --bench-broadphase
+  // [--steps N] [--lights N] [--size N] [--clusters N] [--spread S]
+  // [--seed N]
+  {"--bench-broadphase", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseBroadphaseOptions,
+      csci3081::RunBroadphaseBenchmark);
+  }},
+  // Time spawning many entities: arenaviewer --bench-spawn [--foods N]
+  // [--lights N] [--size N] [--resets N] [--seed N]
+  {"--bench-spawn", [](int argc, char **argv) {
+    return RunMode(argc, argv, csci3081::ParseSpawnOptions,
+      csci3081::RunSpawnBenchmark);
+  }},
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    for (const mode &m : kModes) {
+      if (std::string(argv[1]) == m.flag) {
+        return m.run(argc - 2, argv + 2);
+      }
+    }
+  }
+
   // The controller creates both the arena and viewer
   auto *controller = new csci3081::Controller;
 
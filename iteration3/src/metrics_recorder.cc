@@ -0,0 +1,136 @@
+/**
+ * @file metrics_recorder.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <utility>
+
+#include "src/arena.h"
+#include "src/metrics_recorder.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+MetricsRecorder::MetricsRecorder(unsigned int decimation, size_t batch_size)
+    : decimation_(std::max(decimation, 1u)),
+      batch_size_(std::max<size_t>(batch_size, 1)) {
+  batch_.reserve(batch_size_);
+  writer_ = std::thread(&MetricsRecorder::WriterLoop, this);
+}
+
+MetricsRecorder::~MetricsRecorder() {
+  Flush();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  batch_queued_.notify_one();
+  writer_.join();
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void MetricsRecorder::AddSink(std::unique_ptr<MetricsSink> sink) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sinks_.push_back(std::move(sink));
+}
+
+void MetricsRecorder::Record(Arena * arena) {
+  if (++step_count_ % decimation_ != 0) {
+    return;
+  }
+
+  step_metrics metrics;
+  metrics.step = step_count_;
+  const StepStats &stats = arena->get_step_stats();
+  metrics.collisions = static_cast<uint32_t>(stats.collisions);
+  metrics.meals = static_cast<uint32_t>(stats.meals);
+
+  // one pass over the robots for all the robot aggregates
+  double meal_time_sum = 0;
+  double light_sum = 0;
+  std::vector<Robot *> robots = arena->get_robots();
+  for (auto robot : robots) {
+    meal_time_sum += robot->get_time_since_last_meal();
+    light_sum += robot->get_last_light_reading();
+    metrics.n_hungry += robot->get_hungry() ? 1 : 0;
+    metrics.n_starving += robot->get_starving() ? 1 : 0;
+  }
+  metrics.n_robots = static_cast<uint32_t>(robots.size());
+  if (!robots.empty()) {
+    metrics.mean_time_since_last_meal = meal_time_sum / robots.size();
+    metrics.mean_light_reading = light_sum / robots.size();
+  }
+
+  batch_.push_back(metrics);
+  if (batch_.size() >= batch_size_) {
+    HandOff();
+  }
+}
+
+void MetricsRecorder::Flush() {
+  if (!batch_.empty()) {
+    HandOff();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+  // the writer thread cannot start again while the lock is held
+  for (auto &sink : sinks_) {
+    sink->Flush();
+  }
+}
+
+void MetricsRecorder::HandOff() {
+  std::vector<step_metrics> full;
+  full.reserve(batch_size_);
+  full.swap(batch_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(full));
+  }
+  batch_queued_.notify_one();
+}
+
+void MetricsRecorder::WriterLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    batch_queued_.wait(lock, [this]() {
+      return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;  // stopping and everything is written
+    }
+    std::vector<step_metrics> batch = std::move(queue_.front());
+    queue_.pop_front();
+    writing_ = true;
+
+    // Sinks are only added under the lock, so they can be used unlocked
+    // while the simulation queues more batches.
+    std::vector<MetricsSink *> sinks;
+    for (auto &sink : sinks_) {
+      sinks.push_back(sink.get());
+    }
+    lock.unlock();
+    for (auto sink : sinks) {
+      sink->Write(batch);
+    }
+    lock.lock();
+
+    writing_ = false;
+    if (queue_.empty()) {
+      idle_.notify_all();
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
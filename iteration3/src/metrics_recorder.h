@@ -0,0 +1,115 @@
+/**
+ * @file metrics_recorder.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_METRICS_RECORDER_H_
+#define SRC_METRICS_RECORDER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common.h"
+#include "src/metrics_sink.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class Arena;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Measures the arena after every timestep and streams the measurements
+ * to any number of MetricsSinks.
+ *
+ * Arena calls Record() after each update. Every decimation-th update, the
+ * aggregates are computed in one pass over the robots and added to a batch.
+ * Full batches are handed to a writer thread, which passes them to the
+ * sinks, so file output never happens in the simulation loop. Batches are
+ * queued without limit rather than making the simulation wait for a slow
+ * sink.
+ */
+class MetricsRecorder {
+ public:
+  /**
+   * @param decimation Record every decimation-th update.
+   * @param batch_size # of records handed to the writer thread at a time.
+   */
+  explicit MetricsRecorder(unsigned int decimation = 1,
+    size_t batch_size = 256);
+
+  /**
+   * @brief Flush() and stop the writer thread.
+   */
+  ~MetricsRecorder();
+
+  MetricsRecorder(const MetricsRecorder &other) = delete;
+  MetricsRecorder &operator=(const MetricsRecorder &other) = delete;
+
+  /**
+   * @brief Add a sink. Records already written are not passed to it.
+   */
+  void AddSink(std::unique_ptr<MetricsSink> sink);
+
+  /**
+   * @brief Measure the arena after an update, if this update is recorded.
+   */
+  void Record(Arena * arena);
+
+  /**
+   * @brief Hand off the partial batch, wait until the writer thread has
+   * written everything and flush the sinks.
+   */
+  void Flush();
+
+  /**
+   * @brief # of updates seen by Record(), recorded or not.
+   */
+  uint64_t get_step_count() const { return step_count_; }
+
+  unsigned int get_decimation() const { return decimation_; }
+
+ private:
+  /**
+   * @brief Pass queued batches to the sinks until the recorder is destroyed.
+   */
+  void WriterLoop();
+
+  /**
+   * @brief Queue batch_ for the writer thread.
+   */
+  void HandOff();
+
+  unsigned int decimation_;
+  size_t batch_size_;
+  uint64_t step_count_{0};
+  // records not yet handed to the writer thread
+  std::vector<step_metrics> batch_{};
+
+  std::mutex mutex_{};
+  // signaled when a batch is queued or the recorder stops
+  std::condition_variable batch_queued_{};
+  // signaled when the writer thread has written everything queued
+  std::condition_variable idle_{};
+  std::deque<std::vector<step_metrics>> queue_{};
+  std::vector<std::unique_ptr<MetricsSink>> sinks_{};
+  bool writing_{false};
+  bool stopping_{false};
+  std::thread writer_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_METRICS_RECORDER_H_
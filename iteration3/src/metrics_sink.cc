@@ -0,0 +1,93 @@
+/**
+ * @file metrics_sink.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/metrics_sink.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+template <typename T>
+void WriteField(std::ofstream *file, const T &value) {
+  file->write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+CsvMetricsSink::CsvMetricsSink(const std::string &path) : file_(path) {
+  file_ << "step,mean_time_since_last_meal,mean_light_reading,robots,"
+        << "hungry,starving,collisions,meals\n";
+}
+
+BinaryMetricsSink::BinaryMetricsSink(const std::string &path)
+    : file_(path, std::ios::binary) {
+  file_.write("BVMETRC1", 8);
+}
+
+RingMetricsSink::RingMetricsSink(size_t capacity)
+    : ring_(std::max<size_t>(capacity, 1)) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void CsvMetricsSink::Write(const std::vector<step_metrics> &batch) {
+  for (auto &m : batch) {
+    file_ << m.step << ',' << m.mean_time_since_last_meal << ','
+          << m.mean_light_reading << ',' << m.n_robots << ',' << m.n_hungry
+          << ',' << m.n_starving << ',' << m.collisions << ',' << m.meals
+          << '\n';
+  }
+}
+
+void BinaryMetricsSink::Write(const std::vector<step_metrics> &batch) {
+  // field by field, so there is no padding in the file
+  for (auto &m : batch) {
+    WriteField(&file_, m.step);
+    WriteField(&file_, m.mean_time_since_last_meal);
+    WriteField(&file_, m.mean_light_reading);
+    WriteField(&file_, m.n_robots);
+    WriteField(&file_, m.n_hungry);
+    WriteField(&file_, m.n_starving);
+    WriteField(&file_, m.collisions);
+    WriteField(&file_, m.meals);
+  }
+}
+
+void RingMetricsSink::Write(const std::vector<step_metrics> &batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &m : batch) {
+    ring_[next_] = m;
+    next_ = (next_ + 1) % ring_.size();
+    size_ = std::min(size_ + 1, ring_.size());
+  }
+}
+
+std::vector<step_metrics> RingMetricsSink::GetRecent() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<step_metrics> recent;
+  recent.reserve(size_);
+  size_t oldest = (next_ + ring_.size() - size_) % ring_.size();
+  for (size_t i = 0; i < size_; ++i) {
+    recent.push_back(ring_[(oldest + i) % ring_.size()]);
+  }
+  return recent;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,131 @@
+/**
+ * @file metrics_sink.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_METRICS_SINK_H_
+#define SRC_METRICS_SINK_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Aggregate measurements of the arena after one timestep.
+ */
+struct step_metrics {
+  // # of recorded arena updates so far, counting from 1
+  uint64_t step{0};
+  // mean over the robots of the time since their last meal
+  double mean_time_since_last_meal{0};
+  // mean over the robots of their last light reading
+  double mean_light_reading{0};
+  uint32_t n_robots{0};
+  uint32_t n_hungry{0};
+  uint32_t n_starving{0};
+  // collisions handled in the step
+  uint32_t collisions{0};
+  // times a robot ate in the step
+  uint32_t meals{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Destination for step_metrics. MetricsRecorder calls Write() from
+ * its writer thread only, with records in step order.
+ */
+class MetricsSink {
+ public:
+  MetricsSink() {}
+  virtual ~MetricsSink() {}
+
+  /**
+   * @brief Store a batch of records.
+   */
+  virtual void Write(const std::vector<step_metrics> &batch) = 0;
+
+  /**
+   * @brief Make everything written so far durable (e.g. flush a file).
+   */
+  virtual void Flush() {}
+};
+
+/**
+ * @brief Writes records as comma separated values, one line per step, after
+ * a header line.
+ */
+class CsvMetricsSink : public MetricsSink {
+ public:
+  explicit CsvMetricsSink(const std::string &path);
+
+  void Write(const std::vector<step_metrics> &batch) override;
+  void Flush() override { file_.flush(); }
+
+  bool IsOpen() const { return file_.is_open(); }
+
+ private:
+  std::ofstream file_;
+};
+
+/**
+ * @brief Writes records in a compact binary format: the 8 byte magic
+ * "BVMETRC1", then one 44 byte record per step holding the fields of
+ * step_metrics in declaration order, in the host's byte order.
+ */
+class BinaryMetricsSink : public MetricsSink {
+ public:
+  explicit BinaryMetricsSink(const std::string &path);
+
+  void Write(const std::vector<step_metrics> &batch) override;
+  void Flush() override { file_.flush(); }
+
+  bool IsOpen() const { return file_.is_open(); }
+
+ private:
+  std::ofstream file_;
+};
+
+/**
+ * @brief Keeps the most recent records in memory, e.g. for a live plot.
+ * GetRecent() may be called from any thread.
+ */
+class RingMetricsSink : public MetricsSink {
+ public:
+  explicit RingMetricsSink(size_t capacity);
+
+  void Write(const std::vector<step_metrics> &batch) override;
+
+  /**
+   * @brief The records held, oldest first.
+   */
+  std::vector<step_metrics> GetRecent() const;
+
+ private:
+  mutable std::mutex mutex_{};
+  std::vector<step_metrics> ring_;
+  // index the next record is written to
+  size_t next_{0};
+  size_t size_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_METRICS_SINK_H_
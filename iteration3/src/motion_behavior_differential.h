@@ -30,8 +30,7 @@ NAMESPACE_BEGIN(csci3081);
 class MotionBehaviorDifferential : public MotionBehavior {
  public:
   explicit MotionBehaviorDifferential(ArenaMobileEntity * entity)
-      : MotionBehavior(entity) , radius_(entity_->get_radius()),
-        temp_vel_(0, 0) {
+      : MotionBehavior(entity) , radius_(entity_->get_radius()) {
   }
 
   MotionBehaviorDifferential(const MotionBehaviorDifferential& other) = default;
@@ -50,36 +49,13 @@ class MotionBehaviorDifferential : public MotionBehavior {
    * in the direction of its heading. If one wheel is faster than the other,
    * this drives the entity in an arc (e.g. if WheelVelocity.right > .left,
    * then the entity will move in an arc turning to the left relative to its
-   * heading.)
+   * heading.) The model itself is DifferentialDrive(), which is shared with
+   * the single precision kernels.
    */
   void UpdatePose(double dt, WheelVelocity vel) override;
 
  private:
-  /**
-   * @brief Get the radius of the ICC
-   */
-  double icc_radius() const;
-
-  /**
-   * @brief Get the angular velocity, in rad/sec.
-   */
-  double omega() const;
-
-  /**
-   * @brief Get the Instantaneous Center of Curvature (ICC) of the entity.
-   *
-   * @param pose The entities current pose.
-   *
-   * @return The center of curvature (theta component of pose unused).
-   */
-  struct Pose calc_icc(struct Pose pose) const;
-
   double radius_;
-
-  // Velocity is stored in motion handler. Value is passed in here and used to
-  // calculate new pose. Its used in various functions, hence the temp var
-  // instead of passing it around from function to function.
-  WheelVelocity temp_vel_;
 };
 
 NAMESPACE_END(csci3081);
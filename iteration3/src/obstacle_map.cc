@@ -0,0 +1,352 @@
+/**
+ * @file obstacle_map.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "src/obstacle_map.h"
+#include "src/swept_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+// most segments in a leaf of the hierarchy
+const uint32_t kLeafSize = 4;
+
+// deeper than a median split hierarchy gets for any number of segments
+const int kMaxDepth = 64;
+
+// times Separate() goes over the contacts, for corners that push back and
+// forth
+const int kSeparatePasses = 4;
+
+double Centroid(const obstacle_segment &segment, bool along_x) {
+  return along_x ? segment.x0 + segment.x1 : segment.y0 + segment.y1;
+}
+
+/**
+ * @brief Twice the signed area of the triangle a, b, (x, y): positive if
+ * the point is left of a to b.
+ */
+double Orientation(const Pose &a, const Pose &b, double x, double y) {
+  return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+/**
+ * @brief Whether the segment from a to b crosses or touches segment.
+ */
+bool Crosses(const Pose &a, const Pose &b, const obstacle_segment &segment) {
+  double side0 = Orientation(a, b, segment.x0, segment.y0);
+  double side1 = Orientation(a, b, segment.x1, segment.y1);
+  if ((side0 > 0 && side1 > 0) || (side0 < 0 && side1 < 0)) {
+    return false;
+  }
+  Pose start(segment.x0, segment.y0);
+  Pose end(segment.x1, segment.y1);
+  double side_a = Orientation(start, end, a.x, a.y);
+  double side_b = Orientation(start, end, b.x, b.y);
+  if ((side_a > 0 && side_b > 0) || (side_a < 0 && side_b < 0)) {
+    return false;
+  }
+  if (std::fabs(side0) > 0 || std::fabs(side1) > 0 ||
+      std::fabs(side_a) > 0 || std::fabs(side_b) > 0) {
+    return true;
+  }
+  // on one line: they cross if their extents overlap
+  return std::max(a.x, b.x) >= std::min(segment.x0, segment.x1) &&
+    std::min(a.x, b.x) <= std::max(segment.x0, segment.x1) &&
+    std::max(a.y, b.y) >= std::min(segment.y0, segment.y1) &&
+    std::min(a.y, b.y) <= std::max(segment.y0, segment.y1);
+}
+
+/**
+ * @brief Narrow [enter, leave], the part of a ray starting at origin and
+ * moving by delta that is inside the slab [min, max] of one axis.
+ *
+ * @return false if no part of the ray is left.
+ */
+bool ClipToSlab(double origin, double delta, double min, double max,
+    double *enter, double *leave) {
+  if (!(std::fabs(delta) > 0)) {
+    return origin >= min && origin <= max;
+  }
+  double t0 = (min - origin) / delta;
+  double t1 = (max - origin) / delta;
+  *enter = std::max(*enter, std::min(t0, t1));
+  *leave = std::min(*leave, std::max(t0, t1));
+  return *enter <= *leave;
+}
+
+/**
+ * @brief Whether the segment from from to to passes through the box of
+ * a node (the slab test).
+ */
+bool RayHitsBox(const Pose &from, const Pose &to, double min_x,
+    double min_y, double max_x, double max_y) {
+  double enter = 0;
+  double leave = 1;
+  return ClipToSlab(from.x, to.x - from.x, min_x, max_x, &enter, &leave) &&
+    ClipToSlab(from.y, to.y - from.y, min_y, max_y, &enter, &leave);
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void ObstacleMap::AddSegment(double x0, double y0, double x1, double y1) {
+  obstacle_segment segment;
+  segment.x0 = x0;
+  segment.y0 = y0;
+  segment.x1 = x1;
+  segment.y1 = y1;
+  segments_.push_back(segment);
+}
+
+void ObstacleMap::AddPolygon(const std::vector<Pose> &points) {
+  for (size_t i = 0; i < points.size(); ++i) {
+    const Pose &next = points[(i + 1) % points.size()];
+    AddSegment(points[i].x, points[i].y, next.x, next.y);
+  }
+}
+
+bool ObstacleMap::Read(std::istream *in) {
+  std::string line;
+  while (std::getline(*in, line)) {
+    std::istringstream fields(line);
+    std::string kind;
+    if (!(fields >> kind) || kind[0] == '#') {
+      continue;
+    }
+    std::vector<double> coordinates;
+    double coordinate = 0;
+    while (fields >> coordinate) {
+      coordinates.push_back(coordinate);
+    }
+    if (!fields.eof() || coordinates.size() % 2 != 0) {
+      return false;
+    }
+    std::vector<Pose> points;
+    for (size_t i = 0; i < coordinates.size(); i += 2) {
+      points.emplace_back(coordinates[i], coordinates[i + 1]);
+    }
+    if (kind == "segment" && points.size() == 2) {
+      AddSegment(points[0].x, points[0].y, points[1].x, points[1].y);
+    } else if (kind == "polygon" && points.size() >= 3) {
+      AddPolygon(points);
+    } else {
+      return false;
+    }
+  }
+  Build();
+  return true;
+}
+
+bool ObstacleMap::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  return Read(&file);
+}
+
+void ObstacleMap::Build() {
+  nodes_.clear();
+  order_.resize(segments_.size());
+  for (size_t i = 0; i < order_.size(); ++i) {
+    order_[i] = static_cast<uint32_t>(i);
+  }
+  if (!segments_.empty()) {
+    BuildNode(0, static_cast<uint32_t>(segments_.size()));
+  }
+}
+
+uint32_t ObstacleMap::BuildNode(uint32_t first, uint32_t last) {
+  node box;
+  box.min_x = box.min_y = HUGE_VAL;
+  box.max_x = box.max_y = -HUGE_VAL;
+  for (uint32_t i = first; i < last; ++i) {
+    const obstacle_segment &segment = segments_[order_[i]];
+    box.min_x = std::min({box.min_x, segment.x0, segment.x1});
+    box.min_y = std::min({box.min_y, segment.y0, segment.y1});
+    box.max_x = std::max({box.max_x, segment.x0, segment.x1});
+    box.max_y = std::max({box.max_y, segment.y0, segment.y1});
+  }
+  uint32_t index = static_cast<uint32_t>(nodes_.size());
+  nodes_.push_back(box);
+  if (last - first <= kLeafSize) {
+    nodes_[index].first = first;
+    nodes_[index].count = last - first;
+    return index;
+  }
+
+  // half the segments on each side of the middle one along the longer side
+  bool along_x = box.max_x - box.min_x >= box.max_y - box.min_y;
+  uint32_t middle = first + (last - first) / 2;
+  std::nth_element(order_.begin() + first, order_.begin() + middle,
+    order_.begin() + last, [&](uint32_t a, uint32_t b) {
+      return Centroid(segments_[a], along_x) <
+        Centroid(segments_[b], along_x); });
+  uint32_t left = BuildNode(first, middle);
+  uint32_t right = BuildNode(middle, last);
+  nodes_[index].left = left;
+  nodes_[index].right = right;
+  return index;
+}
+
+template <typename Overlaps, typename Visit>
+void ObstacleMap::Traverse(Overlaps overlaps, Visit visit) const {
+  if (nodes_.empty()) {
+    return;
+  }
+  uint32_t stack[kMaxDepth];
+  int n_stacked = 0;
+  stack[n_stacked++] = 0;
+  while (n_stacked > 0) {
+    const node &current = nodes_[stack[--n_stacked]];
+    if (!overlaps(current)) {
+      continue;
+    }
+    if (current.count > 0) {
+      for (uint32_t i = current.first; i < current.first + current.count;
+          ++i) {
+        if (!visit(order_[i])) {
+          return;
+        }
+      }
+    } else {
+      stack[n_stacked++] = current.left;
+      stack[n_stacked++] = current.right;
+    }
+  }
+}
+
+template <typename Visit>
+void ObstacleMap::VisitBox(double min_x, double min_y, double max_x,
+    double max_y, Visit visit) const {
+  Traverse([&](const node &box) {
+      return box.min_x <= max_x && box.max_x >= min_x &&
+        box.min_y <= max_y && box.max_y >= min_y;
+    }, [&](uint32_t i) {
+      visit(i);
+      return true;
+    });
+}
+
+void ObstacleMap::QueryCircle(double x, double y, double reach,
+    std::vector<uint32_t> *found) const {
+  VisitBox(x - reach, y - reach, x + reach, y + reach, [&](uint32_t i) {
+    const obstacle_segment &segment = segments_[i];
+    Pose closest = ClosestPointOnSegment(x, y, segment.x0, segment.y0,
+      segment.x1, segment.y1);
+    double dx = x - closest.x;
+    double dy = y - closest.y;
+    if (dx * dx + dy * dy <= reach * reach) {
+      found->push_back(i);
+    }
+  });
+}
+
+double ObstacleMap::SweepCircle(const Pose &start, const Pose &end,
+    double radius, size_t *segment) const {
+  double first = -1;
+  VisitBox(std::min(start.x, end.x) - radius,
+    std::min(start.y, end.y) - radius, std::max(start.x, end.x) + radius,
+    std::max(start.y, end.y) + radius, [&](uint32_t i) {
+      const obstacle_segment &candidate = segments_[i];
+      double t = SweptCircleSegmentTimeOfImpact(start, end, candidate.x0,
+        candidate.y0, candidate.x1, candidate.y1, radius);
+      if (t >= 0 && (first < 0 || t < first)) {
+        first = t;
+        *segment = i;
+      }
+    });
+  return first;
+}
+
+int ObstacleMap::Separate(Pose *center, double radius, double skin) const {
+  // contacts are rare, and a local list lets arenas stepped on different
+  // threads share the map
+  std::vector<uint32_t> nearby;
+  int contacts = 0;
+  for (int pass = 0; pass < kSeparatePasses; ++pass) {
+    nearby.clear();
+    QueryCircle(center->x, center->y, radius, &nearby);
+    if (nearby.empty()) {
+      break;
+    }
+    for (uint32_t i : nearby) {
+      const obstacle_segment &segment = segments_[i];
+      Pose closest = ClosestPointOnSegment(center->x, center->y, segment.x0,
+        segment.y0, segment.x1, segment.y1);
+      double dx = center->x - closest.x;
+      double dy = center->y - closest.y;
+      double distance = sqrt(dx * dx + dy * dy);
+      if (distance > radius) {
+        continue;  // an earlier contact pushed it clear
+      }
+      if (distance > 0) {
+        dx /= distance;
+        dy /= distance;
+      } else {
+        // on the segment: leave along its normal
+        double ux = segment.x1 - segment.x0;
+        double uy = segment.y1 - segment.y0;
+        double length = sqrt(ux * ux + uy * uy);
+        dx = length > 0 ? -uy / length : 1;
+        dy = length > 0 ? ux / length : 0;
+      }
+      center->x += dx * (radius + skin - distance);
+      center->y += dy * (radius + skin - distance);
+      ++contacts;
+    }
+  }
+  return contacts;
+}
+
+bool ObstacleMap::IsBlocked(const Pose &from, const Pose &to) const {
+  bool blocked = false;
+  Traverse([&](const node &box) {
+      return RayHitsBox(from, to, box.min_x, box.min_y, box.max_x,
+        box.max_y);
+    }, [&](uint32_t i) {
+      blocked = Crosses(from, to, segments_[i]);
+      return !blocked;
+    });
+  return blocked;
+}
+
+void ObstacleMap::IsBlockedPair(const Pose &from_a, const Pose &from_b,
+    const Pose &to, bool *blocked_a, bool *blocked_b) const {
+  *blocked_a = false;
+  *blocked_b = false;
+  // a node is entered if either ray still to be blocked passes through it,
+  // and each of its segments is then tested against both
+  Traverse([&](const node &box) {
+      return (!*blocked_a && RayHitsBox(from_a, to, box.min_x, box.min_y,
+          box.max_x, box.max_y)) ||
+        (!*blocked_b && RayHitsBox(from_b, to, box.min_x, box.min_y,
+          box.max_x, box.max_y));
+    }, [&](uint32_t i) {
+      *blocked_a = *blocked_a || Crosses(from_a, to, segments_[i]);
+      *blocked_b = *blocked_b || Crosses(from_b, to, segments_[i]);
+      return !(*blocked_a && *blocked_b);
+    });
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,181 @@
+/**
+ * @file obstacle_map.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_OBSTACLE_MAP_H_
+#define SRC_OBSTACLE_MAP_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A line segment of static obstacle geometry, from (x0, y0) to
+ * (x1, y1).
+ */
+struct obstacle_segment {
+  double x0{0};
+  double y0{0};
+  double x1{0};
+  double y1{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Static obstacles made of line segments (polygons are added as their
+ * edges), with a bounding volume hierarchy to find the segments near a
+ * circle.
+ *
+ * The hierarchy is built once by Build(), after the segments are added;
+ * the obstacles do not move, so it is never refit. Each node bounds its
+ * segments with a box and splits them at the median along the longer side
+ * of the box, so a query visits about log(n) nodes plus the leaves it
+ * overlaps, however many segments make up the map.
+ */
+class ObstacleMap {
+ public:
+  ObstacleMap() {}
+
+  void AddSegment(double x0, double y0, double x1, double y1);
+
+  /**
+   * @brief Add the edges of the closed polygon through points.
+   */
+  void AddPolygon(const std::vector<Pose> &points);
+
+  /**
+   * @brief Add the obstacles of a scenario and Build(). Each line is either
+   * "segment x0 y0 x1 y1" or "polygon x y x y ..." (at least three
+   * points); blank lines and lines starting with # are skipped.
+   *
+   * @return false if a line could not be read; the obstacles before it are
+   * kept.
+   */
+  bool Read(std::istream *in);
+
+  /**
+   * @brief Read() the file at path.
+   *
+   * @return false if the file could not be opened or read.
+   */
+  bool Load(const std::string &path);
+
+  /**
+   * @brief Build the hierarchy over the segments added so far.
+   */
+  void Build();
+
+  size_t get_size() const { return segments_.size(); }
+  bool is_empty() const { return segments_.empty(); }
+  const obstacle_segment &get_segment(size_t i) const {
+    return segments_[i]; }
+
+  /**
+   * @brief Every segment that comes within reach of (x, y).
+   *
+   * @param[out] found The indices of the segments are appended here.
+   */
+  void QueryCircle(double x, double y, double reach,
+    std::vector<uint32_t> *found) const;
+
+  /**
+   * @brief The first segment a circle of radius moving in a straight line
+   * from start to end touches. A segment the circle already touches at
+   * start is not reported (see Separate()).
+   *
+   * @param[out] segment The index of the segment, if one is touched.
+   *
+   * @return The time of impact in [0, 1], or -1 if none is touched.
+   */
+  double SweepCircle(const Pose &start, const Pose &end, double radius,
+    size_t *segment) const;
+
+  /**
+   * @brief Push a circle of radius at center out of every segment it
+   * touches, to skin from it. Contacts are resolved one after the other and
+   * repeated, so a circle wedged in a corner leaves both sides.
+   *
+   * @return # of contacts resolved, 0 if the circle touches nothing.
+   */
+  int Separate(Pose *center, double radius, double skin) const;
+
+  /**
+   * @brief Whether any segment crosses (or touches) the line of sight from
+   * from to to.
+   */
+  bool IsBlocked(const Pose &from, const Pose &to) const;
+
+  /**
+   * @brief IsBlocked() for the lines of sight from two points close
+   * together, such as the two sensors of a robot, to the same target. Both
+   * rays are cast as a packet, in one pass over the hierarchy, which stops
+   * once both are blocked.
+   */
+  void IsBlockedPair(const Pose &from_a, const Pose &from_b, const Pose &to,
+    bool *blocked_a, bool *blocked_b) const;
+
+ private:
+  struct node {
+    double min_x{0};
+    double min_y{0};
+    double max_x{0};
+    double max_y{0};
+    // children if count is 0, otherwise the segments first to
+    // first + count of order_
+    uint32_t left{0};
+    uint32_t right{0};
+    uint32_t first{0};
+    uint32_t count{0};
+  };
+
+  /**
+   * @brief Add the node over order_[first, last) and its children.
+   *
+   * @return The index of the node.
+   */
+  uint32_t BuildNode(uint32_t first, uint32_t last);
+
+  /**
+   * @brief Call visit with the index of every segment in a leaf whose box
+   * overlaps(box) is true for, until visit returns false.
+   */
+  template <typename Overlaps, typename Visit>
+  void Traverse(Overlaps overlaps, Visit visit) const;
+
+  /**
+   * @brief Traverse() the leaves that overlap the given box; visit returns
+   * nothing.
+   */
+  template <typename Visit>
+  void VisitBox(double min_x, double min_y, double max_x, double max_y,
+    Visit visit) const;
+
+  std::vector<obstacle_segment> segments_{};
+  // segment indices, grouped by leaf
+  std::vector<uint32_t> order_{};
+  // nodes_[0] is the root
+  std::vector<node> nodes_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_OBSTACLE_MAP_H_
@@ -0,0 +1,51 @@
+/**
+ * @file occlusion_cache.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/occlusion_cache.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void OcclusionCache::GetVisibility(const ObstacleMap &obstacles,
+    const ArenaEntity *robot, const ArenaEntity *emitter, const Pose &left,
+    const Pose &right, const Pose &target, bool *left_visible,
+    bool *right_visible, StepStats *stats) {
+  auto found = sights_.find(sight_key(robot, emitter));
+  if (found != sights_.end() && IsNear(left, found->second.left) &&
+      IsNear(right, found->second.right) &&
+      IsNear(target, found->second.target)) {
+    ++stats->occlusion_cache_hits;
+  } else {
+    if (found == sights_.end()) {
+      found = sights_.emplace(sight_key(robot, emitter), sight()).first;
+    }
+    sight &cast = found->second;
+    bool left_blocked = false;
+    bool right_blocked = false;
+    obstacles.IsBlockedPair(left, right, target, &left_blocked,
+      &right_blocked);
+    cast.left = left;
+    cast.right = right;
+    cast.target = target;
+    cast.left_visible = !left_blocked;
+    cast.right_visible = !right_blocked;
+    stats->occlusion_rays += 2;
+  }
+  *left_visible = found->second.left_visible;
+  *right_visible = found->second.right_visible;
+  stats->occluded_readings += (*left_visible ? 0 : 1) +
+    (*right_visible ? 0 : 1);
+}
+
+NAMESPACE_END(csci3081);
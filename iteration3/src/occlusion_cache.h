@@ -0,0 +1,104 @@
+/**
+ * @file occlusion_cache.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_OCCLUSION_CACHE_H_
+#define SRC_OCCLUSION_CACHE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "src/common.h"
+#include "src/obstacle_map.h"
+#include "src/params.h"
+#include "src/pose.h"
+#include "src/step_stats.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+class ArenaEntity;
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Remembers whether each emitter was visible from the two sensors of
+ * each robot, so the lines of sight are only cast through the obstacles
+ * again once the sensors or the emitter moved further than a tolerance.
+ *
+ * Entries are found by the robot and the emitter, but whether one is used
+ * only depends on where the three points are: a stale entry of an entity
+ * that is gone is simply re-cast. Visibility can be off by the tolerance
+ * near the edge of a shadow.
+ */
+class OcclusionCache {
+ public:
+  explicit OcclusionCache(double tolerance = OCCLUSION_TOLERANCE)
+    : tolerance_(tolerance) {}
+
+  void set_tolerance(double tolerance) { tolerance_ = tolerance; }
+  double get_tolerance() const { return tolerance_; }
+
+  /**
+   * @brief Whether emitter, at target, is visible from the sensors of robot
+   * at left and right. Both lines of sight are cast as one packet when
+   * either endpoint moved beyond the tolerance.
+   *
+   * @param stats Counts the rays cast, the cache hits and the blocked
+   * lines of sight.
+   */
+  void GetVisibility(const ObstacleMap &obstacles, const ArenaEntity *robot,
+    const ArenaEntity *emitter, const Pose &left, const Pose &right,
+    const Pose &target, bool *left_visible, bool *right_visible,
+    StepStats *stats);
+
+  /**
+   * @brief Forget every entry, e.g. when the obstacles change.
+   */
+  void Clear() { sights_.clear(); }
+
+  size_t get_size() const { return sights_.size(); }
+
+ private:
+  typedef std::pair<const ArenaEntity *, const ArenaEntity *> sight_key;
+
+  struct sight {
+    Pose left{};
+    Pose right{};
+    Pose target{};
+    bool left_visible{true};
+    bool right_visible{true};
+  };
+
+  struct key_hash {
+    size_t operator()(const sight_key &key) const {
+      return std::hash<const void *>()(key.first) * 31 +
+        std::hash<const void *>()(key.second);
+    }
+  };
+
+  /**
+   * @brief Whether a moved no further than the tolerance from b.
+   */
+  bool IsNear(const Pose &a, const Pose &b) const {
+    return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) <=
+      tolerance_ * tolerance_;
+  }
+
+  double tolerance_;
+  std::unordered_map<sight_key, sight, key_hash> sights_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_OCCLUSION_CACHE_H_
@@ -1,16 +1,13 @@
 /**
- * @file food_sensor.cc
+ * @file parametric_behavior.cc
  *
- * @copyright 2017 3081 Staff, All rights reserved.
+ * @copyright 2018 Dawood Khan
  */
 
 /*******************************************************************************
  * Includes
  ******************************************************************************/
-#include <math.h>
-
-#include "src/food_sensor.h"
-#include "src/params.h"
+#include "src/parametric_behavior.h"
 
 /*******************************************************************************
  * Namespaces
@@ -18,19 +15,16 @@
 NAMESPACE_BEGIN(csci3081);
 
 /*******************************************************************************
- * Constructors/Destructor
+ * Member Functions
  ******************************************************************************/
-FoodSensor::FoodSensor() {
-  color_.Set(kRed);
-  position_.x = 0;
-  position_.y = 0;
-  position_.theta = 0;
-  reading_ = 0;
-}
-
-void FoodSensor::Notify(Pose position) {
-  reading_ += (static_cast<double>(numerator_value_)
-      / (pow(calculateDistance(position), base_)));
+WheelVelocity ParametricBehavior::processReading(double leftReading,
+    double rightReading) {
+  WheelVelocity v;
+  v.left = parameters_[0] * leftReading + parameters_[1] * rightReading +
+    parameters_[4];
+  v.right = parameters_[2] * leftReading + parameters_[3] * rightReading +
+    parameters_[5];
+  return v;
 }
 
 NAMESPACE_END(csci3081);
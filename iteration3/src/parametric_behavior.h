@@ -0,0 +1,64 @@
+/**
+ * @file parametric_behavior.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_PARAMETRIC_BEHAVIOR_H_
+#define SRC_PARAMETRIC_BEHAVIOR_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <array>
+
+#include "src/robot_behavior.h"
+#include "src/wheel_velocity.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Class representing a general Braitenberg behavior: each wheel
+ * velocity is a weighted sum of the two sensor readings plus a bias.
+ *
+ *     left  = w[0] * leftReading + w[1] * rightReading + w[4]
+ *     right = w[2] * leftReading + w[3] * rightReading + w[5]
+ *
+ * The fixed behaviors are special cases, e.g. fear (+ direct) is
+ * {1, 0, 0, 1, 0, 0} and explore (- crossed) is {0, -1, -1, 0, max, max}
+ * where max is the light max reading.
+ */
+class ParametricBehavior : public RobotBehavior {
+ public:
+  static const int kParameters = 6;
+  typedef std::array<double, kParameters> Parameters;
+
+  explicit ParametricBehavior(const Parameters &parameters)
+    : parameters_(parameters) {}
+  ~ParametricBehavior() = default;
+
+  /**
+   * @brief Processes the reading and then returns a WheelVelocity object 
+   *        based on the readings and weights.
+   *
+   * @param leftReading reading from left sensor
+   * @param rightReading reading from right sensor
+   */
+  WheelVelocity processReading(double leftReading, double rightReading)
+    override;
+
+  const Parameters &get_parameters() const { return parameters_; }
+
+ private:
+  Parameters parameters_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_PARAMETRIC_BEHAVIOR_H_
@@ -29,6 +29,14 @@
 #define TEXT_BOX_WIDTH 50
 #define GUI_MENU_WIDTH 180
 #define GUI_MENU_GAP 10
+// below these zoom levels robot sensors and entity labels are not drawn
+#define RENDER_SENSOR_MIN_ZOOM 0.5
+#define RENDER_LABEL_MIN_ZOOM 1.0
+// nor are labels when more entities than this are in view, where they would
+// only smear into each other at a text draw call apiece
+#define RENDER_MAX_LABELS 200
+#define RENDER_MIN_ZOOM 0.25
+#define RENDER_MAX_ZOOM 4.0
 
 // arena
 #define N_LightS 4
@@ -42,6 +50,10 @@
 #define ARENA_X_DIM X_DIM
 #define ARENA_Y_DIM Y_DIM
 
+// gap left between two entities (or an entity and a wall) after a collision
+// is resolved, so they are not still touching on the next timestep
+#define COLLISION_SKIN 1.0
+
 // game status
 #define WON 0
 #define LOST 1
@@ -75,6 +87,8 @@
 #define ROBOT_MAX_ANGLE 360
 // offset from which robot's hunger will be reset from a food object
 #define PIXEL_OFFSET 5
+// change in any sensor reading that wakes up a sleeping (stopped) robot
+#define SLEEP_READING_TOLERANCE 0.01
 
 // Food
 #define Food_RADIUS 20
@@ -84,6 +98,13 @@
 #define Food_COLOR \
   { 255, 0, 0 }
 #define N_FoodS 4
+// side length of a cell of the grid used to find the food near a robot
+#define FOOD_INDEX_CELL_SIZE 100
+// the same for the lights near a robot, when sensors have a range
+#define LIGHT_INDEX_CELL_SIZE 100
+// a light's visibility from a sensor is cast again through the obstacles
+// only once one of them moved further than this since it was last cast
+#define OCCLUSION_TOLERANCE 2.0
 
 // Light
 #define Light_POSITION \
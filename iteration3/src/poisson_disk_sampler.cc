@@ -0,0 +1,201 @@
+/**
+ * @file poisson_disk_sampler.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "src/poisson_disk_sampler.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+// uniformly random positions tried for a circle before the rings
+const int kDarts = 8;
+
+// positions tried in the ring around a placed circle before giving up on it
+const int kRingAttempts = 16;
+
+}  // namespace
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+PoissonDiskSampler::PoissonDiskSampler(double x_dim, double y_dim,
+    double max_radius, double gap)
+    : x_dim_(x_dim),
+      y_dim_(y_dim),
+      max_radius_(max_radius),
+      gap_(gap),
+      // two circles in cells that are not neighbors are further apart than
+      // the largest radii and the gap
+      cell_size_(std::max(2 * max_radius + gap, 1.0)),
+      columns_(std::max(1, static_cast<int>(std::ceil(x_dim / cell_size_)))),
+      rows_(std::max(1, static_cast<int>(std::ceil(y_dim / cell_size_)))),
+      head_(static_cast<size_t>(columns_) * rows_, -1) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void PoissonDiskSampler::AddCircle(const Pose &center, double radius) {
+  Insert(center.x, center.y, std::min(radius, max_radius_));
+}
+
+bool PoissonDiskSampler::Place(double radius, std::mt19937 *rng,
+    Pose *center) {
+  return PlaceIn(radius, 0, 0, x_dim_, y_dim_, rng, center);
+}
+
+size_t PoissonDiskSampler::PlaceAll(const std::vector<double> &radii,
+    std::mt19937 *rng, std::vector<Pose> *centers) {
+  size_t n = radii.size();
+  centers->assign(n, Pose());
+  if (n == 0) {
+    return 0;
+  }
+  // circles of one kind are often listed together; shuffled, each kind is
+  // spread over the whole arena. The radii are gathered, and the centers
+  // scattered, in loops of their own, which keeps the random accesses out
+  // of the placement loop.
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), *rng);
+  std::vector<double> shuffled(n);
+  for (size_t k = 0; k < n; ++k) {
+    shuffled[k] = radii[order[k]];
+  }
+  std::vector<Pose> placed(n);
+  circles_.reserve(circles_.size() + n);
+  active_.reserve(active_.size() + n);
+
+  // boxes about as wide as high, at least one per circle
+  size_t box_columns = std::max(static_cast<size_t>(1),
+    static_cast<size_t>(std::llround(std::sqrt(n * x_dim_ / y_dim_))));
+  size_t box_rows = (n + box_columns - 1) / box_columns;
+  size_t n_boxes = box_columns * box_rows;
+  double box_width = x_dim_ / box_columns;
+  double box_height = y_dim_ / box_rows;
+
+  size_t n_unplaced = 0;
+  for (size_t k = 0; k < n; ++k) {
+    size_t box = k * n_boxes / n;
+    double min_x = (box % box_columns) * box_width;
+    double min_y = (box / box_columns) * box_height;
+    double radius = shuffled[k];
+    // darts may land a radius outside the box, so a box smaller than a
+    // circle still has room for it
+    if (!PlaceIn(radius, min_x - radius, min_y - radius,
+        min_x + box_width + radius, min_y + box_height + radius, rng,
+        &placed[k])) {
+      ++n_unplaced;
+    }
+  }
+  for (size_t k = 0; k < n; ++k) {
+    (*centers)[order[k]] = placed[k];
+  }
+  return n_unplaced;
+}
+
+bool PoissonDiskSampler::PlaceIn(double radius, double min_x, double min_y,
+    double max_x, double max_y, std::mt19937 *rng, Pose *center) {
+  std::uniform_real_distribution<double> unit(0, 1);
+  min_x = std::max(min_x, radius);
+  min_y = std::max(min_y, radius);
+  double span_x = std::max(std::min(max_x, x_dim_ - radius) - min_x, 0.0);
+  double span_y = std::max(std::min(max_y, y_dim_ - radius) - min_y, 0.0);
+  for (int dart = 0; dart < kDarts; ++dart) {
+    double x = min_x + unit(*rng) * span_x;
+    double y = min_y + unit(*rng) * span_y;
+    if (Fits(x, y, radius)) {
+      Insert(x, y, radius);
+      *center = Pose(x, y);
+      return true;
+    }
+  }
+
+  // the arena is filling up: grow out from the circles placed
+  while (!active_.empty()) {
+    const circle &around = circles_[active_.back()];
+    double inner = around.radius + radius + gap_;
+    for (int attempt = 0; attempt < kRingAttempts; ++attempt) {
+      double angle = unit(*rng) * 2 * M_PI;
+      double distance = inner + unit(*rng) * (radius + gap_);
+      double x = around.x + distance * std::cos(angle);
+      double y = around.y + distance * std::sin(angle);
+      if (Fits(x, y, radius)) {
+        Insert(x, y, radius);
+        *center = Pose(x, y);
+        return true;
+      }
+    }
+    active_.pop_back();
+  }
+
+  *center = Pose(radius + unit(*rng) * std::max(x_dim_ - 2 * radius, 0.0),
+    radius + unit(*rng) * std::max(y_dim_ - 2 * radius, 0.0));
+  return false;
+}
+
+bool PoissonDiskSampler::Fits(double x, double y, double radius) const {
+  if (x < radius || x > x_dim_ - radius || y < radius ||
+      y > y_dim_ - radius) {
+    return false;
+  }
+  int column = CellOf(x, columns_);
+  int row = CellOf(y, rows_);
+  for (int r = std::max(row - 1, 0); r <= std::min(row + 1, rows_ - 1);
+      ++r) {
+    for (int c = std::max(column - 1, 0);
+        c <= std::min(column + 1, columns_ - 1); ++c) {
+      for (int32_t i = head_[r * columns_ + c]; i >= 0;
+          i = circles_[i].next) {
+        const circle &other = circles_[i];
+        double dx = other.x - x;
+        double dy = other.y - y;
+        double reach = other.radius + radius + gap_;
+        if (dx * dx + dy * dy < reach * reach) {
+          return false;
+        }
+      }
+    }
+  }
+  if (obstacles_) {
+    std::vector<uint32_t> touched;
+    obstacles_->QueryCircle(x, y, radius + gap_, &touched);
+    return touched.empty();
+  }
+  return true;
+}
+
+void PoissonDiskSampler::Insert(double x, double y, double radius) {
+  int32_t index = static_cast<int32_t>(circles_.size());
+  int cell = CellOf(y, rows_) * columns_ + CellOf(x, columns_);
+  circle added;
+  added.x = x;
+  added.y = y;
+  added.radius = radius;
+  added.next = head_[cell];
+  circles_.push_back(added);
+  head_[cell] = index;
+  active_.push_back(static_cast<uint32_t>(index));
+}
+
+int PoissonDiskSampler::CellOf(double value, int n_cells) const {
+  int cell = static_cast<int>(std::floor(value / cell_size_));
+  return std::min(std::max(cell, 0), n_cells - 1);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,143 @@
+/**
+ * @file poisson_disk_sampler.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_POISSON_DISK_SAMPLER_H_
+#define SRC_POISSON_DISK_SAMPLER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "src/common.h"
+#include "src/obstacle_map.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Places circles of mixed radii at random in an x_dim by y_dim
+ * arena so that none overlap, for spawning entities.
+ *
+ * A candidate position is checked against the circles already placed in
+ * the 3 x 3 cells around it of a grid whose cells are as wide as the
+ * largest gap two circles can need, so each check is O(1) and placing N
+ * circles is O(N). Each circle is first tried at a few random positions
+ * (dart throwing), which spreads sparse populations evenly over the arena.
+ * When the arena is too full for darts to land, candidates are drawn in the
+ * ring just outside the last circle placed (Bridson's algorithm) instead,
+ * which fills the space left between them; a placed circle whose ring has
+ * no room is not tried again.
+ *
+ * PlaceAll() throws the darts of many circles stratified: the arena is
+ * split into as many boxes as there are circles, visited in rows, and each
+ * circle's darts land in and around its own box. Consecutive checks then
+ * touch neighboring cells instead of cells anywhere in the grid, which is
+ * what keeps a million circles fast once the grid outgrows the cache, and
+ * the circles are spread more evenly than uniformly random darts would.
+ */
+class PoissonDiskSampler {
+ public:
+  /**
+   * @param max_radius The largest radius that will be placed or added.
+   * @param gap Space left between the edges of two circles.
+   */
+  PoissonDiskSampler(double x_dim, double y_dim, double max_radius,
+    double gap);
+
+  PoissonDiskSampler(const PoissonDiskSampler &other) = delete;
+  PoissonDiskSampler &operator=(const PoissonDiskSampler &other) = delete;
+
+  /**
+   * @brief Keep the circles placed clear of obstacles as well. The
+   * obstacles are not owned and must be built.
+   */
+  void set_obstacles(const ObstacleMap * obstacles) {
+    obstacles_ = obstacles; }
+
+  /**
+   * @brief A circle already in the arena, which the circles placed must not
+   * overlap. It may overlap others and need not be inside the arena.
+   */
+  void AddCircle(const Pose &center, double radius);
+
+  /**
+   * @brief Find a free position, inside the arena, for a circle of radius,
+   * which then occupies it.
+   *
+   * @param[out] center The position found. If there is none, a uniformly
+   * random one, which overlaps others.
+   *
+   * @return false if no free position was found.
+   */
+  bool Place(double radius, std::mt19937 *rng, Pose *center);
+
+  /**
+   * @brief Place() a circle of each of radii, in a random order, with
+   * stratified darts.
+   *
+   * @param[out] centers The position found for each circle, as by Place().
+   *
+   * @return # of circles no free position was found for.
+   */
+  size_t PlaceAll(const std::vector<double> &radii, std::mt19937 *rng,
+    std::vector<Pose> *centers);
+
+  size_t get_size() const { return circles_.size(); }
+
+ private:
+  struct circle {
+    double x{0};
+    double y{0};
+    double radius{0};
+    // the circle added to the same cell before this one, or -1
+    int32_t next{-1};
+  };
+
+  /**
+   * @brief Place() with the darts thrown in the box from (min_x, min_y) to
+   * (max_x, max_y), which is clamped to the arena.
+   */
+  bool PlaceIn(double radius, double min_x, double min_y, double max_x,
+    double max_y, std::mt19937 *rng, Pose *center);
+
+  /**
+   * @brief Whether a circle of radius at (x, y) is inside the arena and
+   * clear of every circle and obstacle.
+   */
+  bool Fits(double x, double y, double radius) const;
+
+  void Insert(double x, double y, double radius);
+
+  int CellOf(double value, int n_cells) const;
+
+  double x_dim_;
+  double y_dim_;
+  double max_radius_;
+  double gap_;
+  double cell_size_;
+  int columns_;
+  int rows_;
+  const ObstacleMap * obstacles_{nullptr};
+  // the circles, and a list of them per cell starting at the last circle
+  // added to the cell (-1 if none)
+  std::vector<circle> circles_{};
+  std::vector<int32_t> head_{};
+  // circles whose ring may still have room
+  std::vector<uint32_t> active_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_POISSON_DISK_SAMPLER_H_
@@ -0,0 +1,148 @@
+/**
+ * @file render_batch.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/render_batch.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void RenderBatcher::Build(Arena * arena, double zoom, double view_width,
+    double view_height) {
+  for (auto &batch : batches_) {
+    batch.circles.clear();
+  }
+  labels_.clear();
+  view_max_x_ = view_width / zoom;
+  view_max_y_ = view_height / zoom;
+  bool draw_sensors = zoom >= RENDER_SENSOR_MIN_ZOOM;
+  bool draw_labels = zoom >= RENDER_LABEL_MIN_ZOOM;
+
+  // Lights and food, outlined in black and labeled with their name
+  RgbColor black(0, 0, 0);
+  RenderBatch *batch = nullptr;
+  for (auto entity : arena->get_entities()) {
+    if (entity->get_type() == kRobot) {
+      continue;  // drawn below, colored by hunger
+    }
+    Pose pos = entity->get_pose();
+    if (!IsVisible(pos.x, pos.y, entity->get_radius())) {
+      continue;
+    }
+    const RgbColor &color = entity->get_color();
+    // entities of one type tend to share a color, so the last batch is
+    // usually the right one
+    if (!batch || batch->fill.r != color.r || batch->fill.g != color.g ||
+        batch->fill.b != color.b) {
+      batch = FindBatch(kEntityLayer, color, black);
+    }
+    batch->circles.push_back({static_cast<float>(pos.x),
+      static_cast<float>(pos.y), static_cast<float>(entity->get_radius())});
+    if (draw_labels && labels_.size() <= RENDER_MAX_LABELS) {
+      labels_.push_back({static_cast<float>(pos.x),
+        static_cast<float>(pos.y), entity->get_name()});
+    }
+  }
+  if (labels_.size() > RENDER_MAX_LABELS) {
+    labels_.clear();  // too crowded to read
+  }
+
+  // Robots, colored by hunger state: green when not hungry, yellow when
+  // hungry, red when starving and purple once starved. All four batches are
+  // added before any is kept, since adding a batch may move the others.
+  RgbColor hunger_colors[] = {RgbColor(0, 255, 0), RgbColor(255, 255, 50),
+    RgbColor(255, 0, 0), RgbColor(75, 0, 150)};
+  for (auto &color : hunger_colors) {
+    FindBatch(kRobotLayer, color, black);
+  }
+  RenderBatch *hunger[4];
+  for (int i = 0; i < 4; ++i) {
+    hunger[i] = FindBatch(kRobotLayer, hunger_colors[i], black);
+  }
+  std::vector<Robot *> robots = arena->get_robots();
+  for (auto robot : robots) {
+    Pose pos = robot->get_pose();
+    if (!IsVisible(pos.x, pos.y, robot->get_radius())) {
+      continue;
+    }
+    int state = 0;
+    if (robot->get_starved()) {
+      state = 3;
+    } else if (robot->get_starving()) {
+      state = 2;
+    } else if (robot->get_hungry()) {
+      state = 1;
+    }
+    hunger[state]->circles.push_back({static_cast<float>(pos.x),
+      static_cast<float>(pos.y), static_cast<float>(robot->get_radius())});
+  }
+
+  if (!draw_sensors) {
+    return;
+  }
+  // Light sensors, on top of the robots and outlined in grey
+  batch = nullptr;
+  RgbColor grey(100, 100, 100);
+  for (auto robot : robots) {
+    Sensor *sensors[] = {robot->get_left_lightsensor(),
+      robot->get_right_lightsensor()};
+    for (auto sensor : sensors) {
+      Pose pos = sensor->get_position();
+      if (!IsVisible(pos.x, pos.y, sensor->get_radius())) {
+        continue;
+      }
+      RgbColor color = sensor->get_color();
+      if (!batch || batch->fill.r != color.r || batch->fill.g != color.g ||
+          batch->fill.b != color.b) {
+        batch = FindBatch(kSensorLayer, color, grey);
+      }
+      batch->circles.push_back({static_cast<float>(pos.x),
+        static_cast<float>(pos.y), static_cast<float>(sensor->get_radius())});
+    }
+  }
+}  // Build()
+
+size_t RenderBatcher::get_circle_count() const {
+  size_t count = 0;
+  for (auto &batch : batches_) {
+    count += batch.circles.size();
+  }
+  return count;
+}
+
+RenderBatch *RenderBatcher::FindBatch(int layer, const RgbColor &fill,
+    const RgbColor &stroke) {
+  auto it = batches_.begin();
+  for (; it != batches_.end() && it->layer <= layer; ++it) {
+    if (it->layer == layer && it->fill.r == fill.r && it->fill.g == fill.g &&
+        it->fill.b == fill.b && it->stroke.r == stroke.r &&
+        it->stroke.g == stroke.g && it->stroke.b == stroke.b) {
+      return &*it;
+    }
+  }
+  // keep the batches ordered by layer
+  RenderBatch batch;
+  batch.layer = layer;
+  batch.fill = fill;
+  batch.stroke = stroke;
+  return &*batches_.insert(it, batch);
+}
+
+bool RenderBatcher::IsVisible(double x, double y, double radius) const {
+  return x + radius >= 0 && y + radius >= 0 && x - radius <= view_max_x_ &&
+    y - radius <= view_max_y_;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,130 @@
+/**
+ * @file render_batch.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_RENDER_BATCH_H_
+#define SRC_RENDER_BATCH_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <string>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/common.h"
+#include "src/rgb_color.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief A circle to draw, in arena coordinates.
+ */
+struct RenderCircle {
+  float x{0};
+  float y{0};
+  float radius{0};
+};
+
+/**
+ * @brief Text to draw centered on a point, in arena coordinates.
+ */
+struct RenderLabel {
+  float x{0};
+  float y{0};
+  std::string text{};
+};
+
+/**
+ * @brief Circles that are all drawn the same way, so they can be drawn as a
+ * single path with one fill and one stroke.
+ */
+struct RenderBatch {
+  // batches of a higher layer are drawn on top
+  int layer{0};
+  RgbColor fill{};
+  RgbColor stroke{};
+  std::vector<RenderCircle> circles{};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Groups everything in the Arena that has to be drawn into batches of
+ * same-colored circles.
+ *
+ * Drawing a path per entity does not scale to large populations, so the
+ * viewer draws each batch as one path instead. Robots are colored by hunger
+ * state, and everything else by its own color. Entities outside the view
+ * are left out, as are robot sensors below RENDER_SENSOR_MIN_ZOOM and labels
+ * below RENDER_LABEL_MIN_ZOOM, where they would be too small to see. Labels
+ * are also left out when more than RENDER_MAX_LABELS lights and food are in
+ * view, so a large population at the default zoom draws no text.
+ *
+ * The batches are kept between frames so their storage is reused.
+ */
+class RenderBatcher {
+ public:
+  RenderBatcher() {}
+
+  /**
+   * @brief Rebuild the batches and labels for the current state of arena.
+   *
+   * @param arena The Arena to draw.
+   * @param zoom Screen pixels per arena unit.
+   * @param view_width Width of the view in screen pixels.
+   * @param view_height Height of the view in screen pixels.
+   */
+  void Build(Arena * arena, double zoom, double view_width,
+    double view_height);
+
+  /**
+   * @brief Batches in drawing order (later batches are drawn on top), each
+   * with a separate fill and stroke color. Empty batches may be included.
+   */
+  const std::vector<RenderBatch> &get_batches() const { return batches_; }
+
+  const std::vector<RenderLabel> &get_labels() const { return labels_; }
+
+  /**
+   * @brief # of circles in all the batches.
+   */
+  size_t get_circle_count() const;
+
+ private:
+  /**
+   * @brief Drawing layers, from bottom to top.
+   */
+  enum Layer { kEntityLayer, kRobotLayer, kSensorLayer };
+
+  /**
+   * @brief The batch of the layer drawn with these colors. A new batch is
+   * added after the others of its layer if there is none yet.
+   */
+  RenderBatch *FindBatch(int layer, const RgbColor &fill,
+    const RgbColor &stroke);
+
+  /**
+   * @brief Whether a circle is at least partially in the view.
+   */
+  bool IsVisible(double x, double y, double radius) const;
+
+  std::vector<RenderBatch> batches_{};
+  std::vector<RenderLabel> labels_{};
+  // extent of the view in arena coordinates
+  double view_max_x_{0};
+  double view_max_y_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_RENDER_BATCH_H_
@@ -0,0 +1,160 @@
+/**
+ * @file replay_harness.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "src/replay_harness.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+const uint64_t kFnvOffset = 14695981039346656037ull;
+const uint64_t kFnvPrime = 1099511628211ull;
+
+/**
+ * @brief Add the bits of value to an FNV-1a hash.
+ */
+void HashValue(uint64_t *hash, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    *hash = (*hash ^ ((bits >> (8 * i)) & 0xff)) * kFnvPrime;
+  }
+}
+
+uint64_t HashEntity(const ArenaEntity *ent, const Pose &origin) {
+  uint64_t hash = kFnvOffset;
+  HashValue(&hash, origin.x + ent->get_pose().x);
+  HashValue(&hash, origin.y + ent->get_pose().y);
+  HashValue(&hash, ent->get_pose().theta);
+  return hash;
+}
+
+uint64_t HashRobot(const Robot *robot, const Pose &origin) {
+  uint64_t hash = HashEntity(robot, origin);
+  HashValue(&hash, robot->get_hungry());
+  HashValue(&hash, robot->get_starving());
+  // the sensors are cleared once read; these are what the robot read
+  for (int sensor = 0; sensor < 4; ++sensor) {
+    HashValue(&hash, robot->get_last_reading(sensor));
+  }
+  return hash;
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+replay_result ReplayHarness::Run(const replay_engine &engine) const {
+  world_params params = scenario_;
+  params.n_threads = engine.n_threads;
+  params.tile.broadphase = engine.broadphase;
+  TiledWorld world(params);
+  world.set_lod_scheduler(engine.lod);
+
+  replay_result result;
+  result.engine = engine.name;
+  std::unordered_map<const ArenaEntity *, size_t> numbers;
+  for (size_t i = 0; i < world.get_tile_count(); ++i) {
+    Arena *tile = world.get_tile(i);
+    for (auto robot : tile->get_robots()) {
+      numbers.emplace(robot, numbers.size());
+    }
+    for (auto light : tile->get_lights()) {
+      numbers.emplace(light, numbers.size());
+    }
+  }
+  result.entity_count = numbers.size();
+  result.entity_hashes.resize(steps_ * result.entity_count);
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::duration stepping = Clock::duration::zero();
+  for (unsigned int step = 0; step < steps_; ++step) {
+    Clock::time_point start = Clock::now();
+    world.AdvanceTime(dt_);
+    stepping += Clock::now() - start;
+
+    uint64_t *hashes = &result.entity_hashes[step * result.entity_count];
+    for (size_t i = 0; i < world.get_tile_count(); ++i) {
+      Arena *tile = world.get_tile(i);
+      Pose origin = world.get_tile_origin(i);
+      for (auto robot : tile->get_robots()) {
+        hashes[numbers.at(robot)] = HashRobot(robot, origin);
+      }
+      for (auto light : tile->get_lights()) {
+        hashes[numbers.at(light)] = HashEntity(light, origin);
+      }
+    }
+  }
+  result.seconds = std::chrono::duration<double>(stepping).count();
+  return result;
+}
+
+std::vector<replay_result> ReplayHarness::Compare(
+    const std::vector<replay_engine> &engines) const {
+  std::vector<replay_result> results;
+  for (auto &engine : engines) {
+    results.push_back(Run(engine));
+    const replay_result &reference = results.front();
+    replay_result &result = results.back();
+    size_t n = std::min(reference.entity_hashes.size(),
+      result.entity_hashes.size());
+    for (size_t i = 0; i < n; ++i) {
+      if (reference.entity_hashes[i] != result.entity_hashes[i]) {
+        result.divergent_step = static_cast<int>(i / result.entity_count);
+        result.divergent_entity = static_cast<int>(i % result.entity_count);
+        break;
+      }
+    }
+  }
+  return results;
+}
+
+void ReplayHarness::WriteTable(const std::vector<replay_result> &results,
+    std::ostream *out) {
+  char line[128];
+  snprintf(line, sizeof(line), "%-16s %10s %8s  %s\n", "engine", "seconds",
+    "speedup", "first divergence");
+  *out << line;
+  for (auto &result : results) {
+    char divergence[48] = "none";
+    if (result.divergent_step >= 0) {
+      snprintf(divergence, sizeof(divergence), "step %d, entity %d",
+        result.divergent_step, result.divergent_entity);
+    }
+    double speedup = result.seconds > 0 ?
+      results.front().seconds / result.seconds : 0;
+    snprintf(line, sizeof(line), "%-16s %10.4f %7.2fx  %s\n",
+      result.engine.c_str(), result.seconds, speedup, divergence);
+    *out << line;
+  }
+}
+
+uint64_t ReplayHarness::StepHash(const replay_result &result, size_t step) {
+  uint64_t hash = kFnvOffset;
+  for (size_t i = 0; i < result.entity_count; ++i) {
+    uint64_t entity = result.entity_hashes[step * result.entity_count + i];
+    hash = (hash ^ entity) * kFnvPrime;
+  }
+  return hash;
+}
+
+NAMESPACE_END(csci3081);
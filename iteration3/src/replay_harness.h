@@ -0,0 +1,116 @@
+/**
+ * @file replay_harness.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_REPLAY_HARNESS_H_
+#define SRC_REPLAY_HARNESS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/lod_scheduler.h"
+#include "src/sweep_and_prune.h"
+#include "src/tiled_world.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief One way of stepping a world, to be checked against the others.
+ */
+struct replay_engine {
+  std::string name{};
+  // # of threads stepping the tiles
+  unsigned int n_threads{1};
+  // chooses the levels of detail if set
+  const LodScheduler *lod{nullptr};
+  // how the tiles find the pairs of entities that may collide
+  Broadphase broadphase{kBruteForce};
+};
+
+/**
+ * @brief The state hashes of one run of a ReplayHarness scenario.
+ */
+struct replay_result {
+  std::string engine{};
+  // time spent stepping, without hashing
+  double seconds{0};
+  // hash of every entity after every step, entity_count per step
+  std::vector<uint64_t> entity_hashes{};
+  size_t entity_count{0};
+  // the first step, and entity in it, that differs from the reference run,
+  // or -1 if none does
+  int divergent_step{-1};
+  int divergent_entity{-1};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Runs one seeded TiledWorld scenario through several engine
+ * configurations and checks that they step it identically.
+ *
+ * After every step, each robot's pose, hunger flags and light reading and
+ * each light's pose are hashed bit for bit. Entities are numbered in the
+ * order they are first found in the tiles (robots, then lights), so they
+ * keep their number when they migrate to another tile, and poses are hashed
+ * in world coordinates. The first run of Compare() is the reference the
+ * others must match.
+ */
+class ReplayHarness {
+ public:
+  /**
+   * @param scenario The world to run; give it a non-zero seed.
+   * @param steps # of steps to run.
+   * @param dt The timestep.
+   */
+  ReplayHarness(const world_params &scenario, unsigned int steps, double dt)
+    : scenario_(scenario), steps_(steps), dt_(dt) {}
+
+  /**
+   * @brief Run the scenario with engine and hash it after every step.
+   */
+  replay_result Run(const replay_engine &engine) const;
+
+  /**
+   * @brief Run every engine and find where each first differs from the
+   * first one.
+   */
+  std::vector<replay_result> Compare(
+    const std::vector<replay_engine> &engines) const;
+
+  /**
+   * @brief Write the time of each run, its speedup over the first and its
+   * first divergence.
+   */
+  static void WriteTable(const std::vector<replay_result> &results,
+    std::ostream *out);
+
+  /**
+   * @brief The hash of every entity after a step of result.
+   */
+  static uint64_t StepHash(const replay_result &result, size_t step);
+
+ private:
+  world_params scenario_;
+  unsigned int steps_;
+  double dt_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_REPLAY_HARNESS_H_
@@ -7,6 +7,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <cmath>
 #include <iostream>
 #include "src/robot.h"
 #include "src/params.h"
@@ -55,6 +56,16 @@ Robot::Robot() :
   left_lightsensor_->set_radius(3.0);
   right_lightsensor_->set_radius(3.0);
 }
+
+Robot::~Robot() {
+  CancelHungerEvents();
+  delete robot_behavior_;
+  delete food_behavior_;
+  delete left_lightsensor_;
+  delete right_lightsensor_;
+  delete left_foodsensor_;
+  delete right_foodsensor_;
+}
 /*******************************************************************************
  * Member Functions
  ******************************************************************************/
@@ -65,19 +76,6 @@ void Robot::TimestepUpdate(unsigned int dt) {
   left_foodsensor_->setSensorPositionBasedOnRobotPosition(this->get_pose());
   right_foodsensor_->setSensorPositionBasedOnRobotPosition(this->get_pose());
 
-  // update flags based on time
-  if (!ignore_hunger_) {
-  // update the time and any flags as needed
-    time_since_last_meal_ += dt;
-
-    if (time_since_last_meal_ >= hungry_time_)
-      hungry_ = true;
-    if (time_since_last_meal_ >= starving_time_)
-      starving_ = true;
-    if (time_since_last_meal_ >= starved_time_)
-      starved_ = true;
-  }
-
   // velocity for updating for override or sensors
   WheelVelocity velocity;
 
@@ -98,6 +96,9 @@ void Robot::TimestepUpdate(unsigned int dt) {
     }
 
     motion_handler_.UpdateVelocityOverride(velocity);
+  } else if (external_control_) {
+    velocity = external_velocity_;
+    motion_handler_.UpdateVelocity(velocity);
   } else {  // if not override controls use sensor readings
     // Make WheelVelocity based on the behavior of the robot if
     // robot is not starving
@@ -122,12 +123,21 @@ void Robot::TimestepUpdate(unsigned int dt) {
   // Use velocity and position to update position
   motion_behavior_.UpdatePose(dt, motion_handler_.get_velocity());
 
+  // A robot that has stopped stays put until something changes, so it can
+  // sleep. Remember what it was sensing to know when to wake up.
+  WheelVelocity current = motion_handler_.get_velocity();
+  if (!collision_override_ && std::fabs(current.left) <= 0.0 &&
+      std::fabs(current.right) <= 0.0) {
+    asleep_ = true;
+    sleep_readings_[0] = left_lightsensor_->get_reading();
+    sleep_readings_[1] = right_lightsensor_->get_reading();
+    sleep_readings_[2] = left_foodsensor_->get_reading();
+    sleep_readings_[3] = right_foodsensor_->get_reading();
+  }
+
   // Reset sensors for next cycle
   sensor_touch_->Reset();
-  left_lightsensor_->set_reading(0.0);
-  right_lightsensor_->set_reading(0.0);
-  left_foodsensor_->set_reading(0.0);
-  right_foodsensor_->set_reading(0.0);
+  ClearSensorReadings();
 
   // Update robot's position last to make sure sensor is on robot
   left_lightsensor_->setSensorPositionBasedOnRobotPosition(this->get_pose());
@@ -136,6 +146,56 @@ void Robot::TimestepUpdate(unsigned int dt) {
   right_foodsensor_->setSensorPositionBasedOnRobotPosition(this->get_pose());
 } /* TimestepUpdate() */
 
+bool Robot::CanSkipTimestep() {
+  if (!asleep_) {
+    return false;
+  }
+  double readings[] = {
+    left_lightsensor_->get_reading(), right_lightsensor_->get_reading(),
+    left_foodsensor_->get_reading(), right_foodsensor_->get_reading()};
+  for (int i = 0; i < 4; ++i) {
+    if (std::fabs(readings[i] - sleep_readings_[i]) >
+        SLEEP_READING_TOLERANCE) {
+      Wake();
+      return false;
+    }
+  }
+  ClearSensorReadings();
+  return true;
+}
+
+void Robot::ReplaceSensors(Sensor *left_light, Sensor *right_light,
+    Sensor *left_food, Sensor *right_food) {
+  Sensor **sensors[] = {&left_lightsensor_, &right_lightsensor_,
+    &left_foodsensor_, &right_foodsensor_};
+  Sensor *replacements[] = {left_light, right_light, left_food, right_food};
+  for (int i = 0; i < 4; ++i) {
+    Sensor *old = *sensors[i];
+    Sensor *replacement = replacements[i];
+    replacement->set_robot_radius(old->get_robot_radius());
+    replacement->set_angle_offset(old->get_angle_offset());
+    replacement->set_radius(old->get_radius());
+    replacement->set_color(old->get_color());
+    replacement->set_numerator_value(
+      static_cast<int>(old->get_numerator_value()));
+    replacement->set_position(old->get_position());
+    replacement->set_reading(old->get_reading());
+    delete old;
+    *sensors[i] = replacement;
+  }
+}
+
+void Robot::ClearSensorReadings() {
+  last_readings_[0] = left_lightsensor_->get_reading();
+  last_readings_[1] = right_lightsensor_->get_reading();
+  last_readings_[2] = left_foodsensor_->get_reading();
+  last_readings_[3] = right_foodsensor_->get_reading();
+  left_lightsensor_->set_reading(0.0);
+  right_lightsensor_->set_reading(0.0);
+  left_foodsensor_->set_reading(0.0);
+  right_foodsensor_->set_reading(0.0);
+}
+
 void Robot::Reset() {
   set_pose(SetPoseRandomly());
   motion_handler_.set_max_speed(ROBOT_MAX_SPEED);
@@ -143,10 +203,11 @@ void Robot::Reset() {
   sensor_touch_->Reset();
 
   motion_handler_.set_velocity(0, 0);
+  Wake();
   hungry_ = false;
   starving_ = false;
   starved_ = false;
-  time_since_last_meal_ = 0;
+  set_time_since_last_meal(0);
 
   // Update sensors position based on the robot's position
   left_lightsensor_->setSensorPositionBasedOnRobotPosition(this->get_pose());
@@ -163,15 +224,15 @@ void Robot::HandleCollision(EntityType object_type, ArenaEntity * object) {
     case kLeftWall:
     case kTopWall:
     case kBottomWall:
+    case kObstacle:
       motion_handler_.set_velocity(0, 0);
       sensor_touch_->HandleCollision(object_type, object);
+      Wake();
 
       collision_override_ = true;  // start override controls
       break;
     case kFood:  // if robot eats from food source reset hunger states and time
-      time_since_last_meal_ = 0;
-      hungry_ = false;
-      starving_ = false;
+      Eat();
       break;
     case kLight:
       break;
@@ -180,6 +241,141 @@ void Robot::HandleCollision(EntityType object_type, ArenaEntity * object) {
   }
 }
 
+void Robot::set_robot_behavior(RobotBehavior * robotBehavior) {
+  if (robotBehavior != robot_behavior_) {
+    delete robot_behavior_;
+    robot_behavior_ = robotBehavior;
+  }
+  Wake();
+}
+
+void Robot::set_food_behavior(RobotBehavior * foodBehavior) {
+  if (foodBehavior != food_behavior_) {
+    delete food_behavior_;
+    food_behavior_ = foodBehavior;
+  }
+  Wake();
+}
+
+bool Robot::Eat() {
+  bool was_hungry = hungry_ || starving_;
+  if (was_hungry) {
+    Wake();  // the food readings are no longer used
+  }
+  hungry_ = false;
+  starving_ = false;
+  paused_meal_time_ = 0;
+  hunger_stage_ = 0;
+  if (timer_wheel_ == nullptr) {
+    return was_hungry;
+  }
+  last_meal_tick_ = timer_wheel_->get_current_tick();
+  // A pending timer due no later than the robot can get hungry again
+  // re-arms itself when it fires, so it is left in place.
+  if (hunger_timer_ == 0 ||
+      hunger_timer_tick_ > last_meal_tick_ + hungry_time_) {
+    ScheduleHungerEvents();
+  }
+  return was_hungry;
+}
+
+void Robot::set_external_velocity(const WheelVelocity &velocity) {
+  // a sleeping robot would not notice new velocities
+  if (!external_control_ ||
+      std::fabs(velocity.left - external_velocity_.left) > 0 ||
+      std::fabs(velocity.right - external_velocity_.right) > 0) {
+    Wake();
+  }
+  external_control_ = true;
+  external_velocity_ = velocity;
+}
+
+void Robot::clear_external_velocity() {
+  if (external_control_) {
+    Wake();
+  }
+  external_control_ = false;
+}
+
+void Robot::set_timer_wheel(TimerWheel * wheel) {
+  int time_since_last_meal = get_time_since_last_meal();
+  CancelHungerEvents();
+  timer_wheel_ = wheel;
+  set_time_since_last_meal(time_since_last_meal);
+}
+
+void Robot::set_ignore_hunger(bool ignoreHunger) {
+  if (ignoreHunger == ignore_hunger_) {
+    return;
+  }
+  // freeze the time since the last meal while hunger is ignored
+  Wake();
+  int time_since_last_meal = get_time_since_last_meal();
+  ignore_hunger_ = ignoreHunger;
+  set_time_since_last_meal(time_since_last_meal);
+}
+
+int Robot::get_time_since_last_meal() const {
+  if (ignore_hunger_ || timer_wheel_ == nullptr) {
+    return paused_meal_time_;
+  }
+  return static_cast<int>(timer_wheel_->get_current_tick() - last_meal_tick_);
+}
+
+void Robot::set_time_since_last_meal(int timeSinceLastMeal) {
+  paused_meal_time_ = timeSinceLastMeal;
+  if (timer_wheel_ != nullptr) {
+    last_meal_tick_ = timer_wheel_->get_current_tick() - timeSinceLastMeal;
+  }
+  ScheduleHungerEvents();
+}
+
+void Robot::ScheduleHungerEvents() {
+  CancelHungerEvents();
+  hunger_stage_ = 0;
+  ArmHungerTimer();
+}
+
+void Robot::CancelHungerEvents() {
+  if (timer_wheel_ != nullptr && hunger_timer_ != 0) {
+    timer_wheel_->Cancel(hunger_timer_);
+  }
+  hunger_timer_ = 0;
+}
+
+void Robot::ArmHungerTimer() {
+  if (timer_wheel_ == nullptr || ignore_hunger_) {
+    return;
+  }
+  const int thresholds[] = {hungry_time_, starving_time_, starved_time_};
+  int time_since_last_meal = get_time_since_last_meal();
+  while (hunger_stage_ < 3 &&
+      time_since_last_meal >= thresholds[hunger_stage_]) {
+    // a change in hunger changes which readings are used, so wake up
+    Wake();
+    switch (hunger_stage_++) {
+      case 0:
+        hungry_ = true;
+        break;
+      case 1:
+        starving_ = true;
+        break;
+      default:
+        starved_ = true;
+        if (starved_callback_) {
+          starved_callback_(this);
+        }
+        break;
+    }
+  }
+  if (hunger_stage_ < 3) {
+    int remaining = thresholds[hunger_stage_] - time_since_last_meal;
+    hunger_timer_tick_ = timer_wheel_->get_current_tick() + remaining;
+    hunger_timer_ = timer_wheel_->Schedule(remaining,
+      [this]() { hunger_timer_ = 0; ArmHungerTimer(); });
+  }
+}
+
 std::string Robot::get_name() const {
   std::string behavior;
 
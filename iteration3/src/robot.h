@@ -10,6 +10,7 @@
 /*******************************************************************************
  * Includes
  ******************************************************************************/
+#include <functional>
 #include <string>
 
 #include "src/arena_mobile_entity.h"
@@ -26,6 +27,7 @@
 #include "src/food.h"
 #include "src/light_sensor.h"
 #include "src/food_sensor.h"
+#include "src/timer_wheel.h"
 /*******************************************************************************
  * Namespaces
  ******************************************************************************/
@@ -60,6 +62,18 @@ class Food;
  * Based on the robot's behavior, some of these readings are used and others
  * are ignored.
  * Ex. If robott is not hungry, food sensor readings are ignored.
+ *
+ * A robot whose wheels have stopped falls asleep and is skipped by the arena
+ * until one of its sensor readings changes, it collides, eats or its hunger
+ * state changes.
+ *
+ * Hunger is event driven. Once the robot is given a TimerWheel it keeps one
+ * timer on it, due at its next hunger transition (hungry, starving, then
+ * starved). A meal only moves the timer if it would fire too late, so a
+ * robot eating every step does not touch the wheel; a timer that fires
+ * before the transition is due, because the robot ate since it was set,
+ * re-arms itself for the time left. A robot without a TimerWheel never gets
+ * hungry.
  */
 class Robot : public ArenaMobileEntity {
  public:
@@ -68,9 +82,13 @@ class Robot : public ArenaMobileEntity {
    */
   Robot();
 
-  Robot(const Robot &other) = default;
-  Robot &operator=(const Robot &other) = default;
-  ~Robot() = default;
+  Robot(const Robot &other) = delete;
+  Robot &operator=(const Robot &other) = delete;
+
+  /**
+   * @brief Cancels any hunger events still pending on the TimerWheel.
+   */
+  ~Robot() override;
 
   /**
    * @brief Reset the Robot to a newly constructed state (needed for reset
@@ -89,12 +107,79 @@ class Robot : public ArenaMobileEntity {
    */
   void TimestepUpdate(unsigned int dt) override;
 
+  /**
+   * @brief A sleeping robot skips the timestep unless its sensor readings
+   * have changed by more than SLEEP_READING_TOLERANCE since it fell asleep,
+   * in which case it wakes up.
+   */
+  bool CanSkipTimestep() override;
+
+  /**
+   * @brief Whether the next TimestepUpdate reads the light sensors. A
+   * starving robot, or a hungry one that does not ignore hunger, only
+   * follows food.
+   */
+  bool IsSensingLight() const {
+    return !starving_ && (ignore_hunger_ || !hungry_); }
+
+  /**
+   * @brief Whether the next TimestepUpdate reads the food sensors, i.e. the
+   * robot is hungry or starving and does not ignore hunger.
+   */
+  bool IsSensingFood() const {
+    return !ignore_hunger_ && (hungry_ || starving_); }
+
+  /**
+   * @brief Wake the robot so it is updated on the next timestep.
+   */
+  void Wake() { asleep_ = false; }
+
+  bool IsAsleep() const { return asleep_; }
+
   /**
    * @brief Handles the collision by setting the sensor to activated.
    * Also sets invincibility to true and records the current time.
    */
   void HandleCollision(EntityType object_type, ArenaEntity * object = NULL);
 
+  /**
+   * @brief The robot has eaten. Clears hungry/starving and restarts the
+   * hunger transitions from now.
+   *
+   * @return Whether the meal ended hunger, i.e. the robot was hungry or
+   * starving.
+   */
+  bool Eat();
+
+  /**
+   * @brief Drive the robot with these wheel velocities (e.g. from an
+   * external controller) instead of its behaviors until
+   * clear_external_velocity(). Collisions still override them.
+   */
+  void set_external_velocity(const WheelVelocity &velocity);
+
+  /**
+   * @brief Hand the robot back to its behaviors.
+   */
+  void clear_external_velocity();
+
+  bool get_external_control() const { return external_control_; }
+
+  /**
+   * @brief Set the TimerWheel the hunger transitions are scheduled on.
+   *
+   * Any events pending on a previous wheel are moved over, keeping the time
+   * since the last meal.
+   */
+  void set_timer_wheel(TimerWheel * wheel);
+
+  /**
+   * @brief Set the function called when the robot starves. Arena uses it to
+   * end the simulation.
+   */
+  void set_starved_callback(std::function<void(Robot *)> callback) {
+    starved_callback_ = callback; }
+
   /**
    * @brief Get the behavior of the Robot for visualization and for debugging.
    */
@@ -111,13 +196,26 @@ class Robot : public ArenaMobileEntity {
   MotionBehaviorDifferential get_motion_behavior() const {
     return motion_behavior_; }
 
-  LightSensor * get_left_lightsensor() const { return left_lightsensor_; }
+  Sensor * get_left_lightsensor() const { return left_lightsensor_; }
 
-  LightSensor * get_right_lightsensor() const { return right_lightsensor_; }
+  Sensor * get_right_lightsensor() const { return right_lightsensor_; }
 
-  FoodSensor * get_left_foodsensor() const { return left_foodsensor_; }
+  Sensor * get_left_foodsensor() const { return left_foodsensor_; }
 
-  FoodSensor * get_right_foodsensor() const { return right_foodsensor_; }
+  Sensor * get_right_foodsensor() const { return right_foodsensor_; }
+
+  /**
+   * @brief Replace the light and food sensors with ones whose readings fall
+   * off with distance as falloff says (see sensor_falloff.h), placed and
+   * configured as the old ones were.
+   */
+  template <typename Falloff>
+  void set_sensor_falloff(const Falloff &falloff) {
+    ReplaceSensors(new BasicLightSensor<Falloff>(falloff),
+      new BasicLightSensor<Falloff>(falloff),
+      new BasicFoodSensor<Falloff>(falloff),
+      new BasicFoodSensor<Falloff>(falloff));
+  }
 
   RobotType get_robot_type() const { return robot_type_; }
 
@@ -125,8 +223,20 @@ class Robot : public ArenaMobileEntity {
 
   RobotBehavior * get_robot_behavior() const { return robot_behavior_; }
 
-  void set_robot_behavior(RobotBehavior * robotBehavior) {
-    robot_behavior_ = robotBehavior; }
+  /**
+   * @brief Set how the robot reacts to light. The robot takes ownership of
+   * the behavior and deletes the one it had.
+   */
+  void set_robot_behavior(RobotBehavior * robotBehavior);
+
+  RobotBehavior * get_food_behavior() const { return food_behavior_; }
+
+  /**
+   * @brief Set how the robot reacts to food when hungry (aggressive by
+   * default). The robot takes ownership of the behavior and deletes the one
+   * it had.
+   */
+  void set_food_behavior(RobotBehavior * foodBehavior);
 
   bool get_hungry() const { return hungry_; }
 
@@ -142,26 +252,77 @@ class Robot : public ArenaMobileEntity {
 
   bool get_ignore_hunger() { return ignore_hunger_; }
 
-  void set_ignore_hunger(bool ignoreHunger) { ignore_hunger_ = ignoreHunger; }
+  /**
+   * @brief Turn hunger on or off. The time since the last meal does not
+   * advance while hunger is ignored.
+   */
+  void set_ignore_hunger(bool ignoreHunger);
 
-  bool get_time_since_last_meal() { return time_since_last_meal_; }
+  int get_time_since_last_meal() const;
 
-  void set_time_since_last_meal(int timeSinceLastMeal) {
-    time_since_last_meal_ = timeSinceLastMeal; }
+  /**
+   * @brief A sensor reading the robot used (or slept through) in its last
+   * timestep. The sensors themselves are cleared at the end of each
+   * timestep.
+   *
+   * @param sensor 0 and 1 for the left and right light sensors, 2 and 3 for
+   * the left and right food sensors.
+   */
+  double get_last_reading(int sensor) const { return last_readings_[sensor]; }
+
+  /**
+   * @brief Mean of the left and right light sensor readings of the last
+   * timestep.
+   */
+  double get_last_light_reading() const {
+    return (last_readings_[0] + last_readings_[1]) / 2; }
+
+  /**
+   * @brief Set the time since the last meal and reschedule the hunger
+   * transitions accordingly.
+   */
+  void set_time_since_last_meal(int timeSinceLastMeal);
 
  private:
+  /**
+   * @brief Cancel the hunger timer and start the transitions over from the
+   * time since the last meal: the ones already due happen right away.
+   */
+  void ScheduleHungerEvents();
+
+  void CancelHungerEvents();
+
+  /**
+   * @brief Make the hunger transitions that are due since the last meal
+   * happen, and set the timer for the next one, if any.
+   */
+  void ArmHungerTimer();
+
+  /**
+   * @brief Zero all sensor readings so they can be summed up again, keeping
+   * them for get_last_reading().
+   */
+  void ClearSensorReadings();
+
+  /**
+   * @brief Take over the position, offset, look and reading of each sensor
+   * and delete the old ones.
+   */
+  void ReplaceSensors(Sensor *left_light, Sensor *right_light,
+    Sensor *left_food, Sensor *right_food);
+
   // Manages pose and wheel velocities that change with time and collisions.
   MotionHandlerRobot motion_handler_;
   // Calculates changes in pose Foodd on elapsed time and wheel velocities.
   MotionBehaviorDifferential motion_behavior_;
 
   // two light sensors for sensing light.
-  LightSensor * left_lightsensor_;
-  LightSensor * right_lightsensor_;
+  Sensor * left_lightsensor_;
+  Sensor * right_lightsensor_;
 
   // two food sensors for sensing food
-  FoodSensor * left_foodsensor_;
-  FoodSensor * right_foodsensor_;
+  Sensor * left_foodsensor_;
+  Sensor * right_foodsensor_;
 
   RobotType robot_type_;  // enum for robot type for behavior
 
@@ -182,8 +343,18 @@ class Robot : public ArenaMobileEntity {
       starving_time_{1920},  // approximately 120s
       starved_time_{2400};  // approximately 150s
 
-  // time since robot has last collided with a Food object (internal timer)
-  int time_since_last_meal_{0};
+  // hunger transitions are scheduled on this wheel, owned by the arena
+  TimerWheel * timer_wheel_{nullptr};
+  TimerWheel::TimerId hunger_timer_{0};
+  // tick the hunger timer is due at
+  uint64_t hunger_timer_tick_{0};
+  // # of transitions (hungry, starving, starved) since the last meal
+  int hunger_stage_{0};
+  // tick of the robot's last meal
+  uint64_t last_meal_tick_{0};
+  // time since the last meal when hunger started being ignored
+  int paused_meal_time_{0};
+  std::function<void(Robot *)> starved_callback_{};
 
   // time which the override controls last from a collsion
   int collision_override_duration_{10},
@@ -191,6 +362,17 @@ class Robot : public ArenaMobileEntity {
   bool collision_override_{false};
   // velocity robot will have when override is active
   WheelVelocity override_velocity_{-10, -9};
+
+  // wheel velocities set from outside, used instead of the behaviors
+  bool external_control_{false};
+  WheelVelocity external_velocity_{0, 0};
+
+  // a robot that has stopped sleeps until its readings change
+  bool asleep_{false};
+  // left/right light and left/right food readings when it fell asleep
+  double sleep_readings_[4]{};
+  // left/right light and left/right food readings of the last timestep
+  double last_readings_[4]{};
 };
 
 NAMESPACE_END(csci3081);
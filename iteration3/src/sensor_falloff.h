@@ -0,0 +1,220 @@
+/**
+ * @file sensor_falloff.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_SENSOR_FALLOFF_H_
+#define SRC_SENSOR_FALLOFF_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+#include "src/vehicle_kernel.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+// Falloff policies: how the reading a sensor gets from one emitter falls off
+// with the distance to it. Each is a small copyable object whose call
+// operator returns the reading for a numerator (the emitter's strength) and
+// a distance, so code templated on the policy (VehiclePopulation,
+// VehicleEnsemble) compiles its sensing loop for one curve, with no branch
+// on the model per sensor and emitter.
+
+/**
+ * @brief numerator / distance^base, the arena's model (SensorResponse()).
+ */
+template <typename Scalar>
+struct PowerFalloff {
+  Scalar base{static_cast<Scalar>(1.08)};
+
+  Scalar operator()(Scalar numerator, Scalar distance) const {
+    return SensorResponse(numerator, distance, base);
+  }
+};
+
+/**
+ * @brief numerator / distance^2, without pow.
+ */
+template <typename Scalar>
+struct InverseSquareFalloff {
+  Scalar operator()(Scalar numerator, Scalar distance) const {
+    return numerator / (distance * distance);
+  }
+};
+
+/**
+ * @brief numerator * e^(-distance / length).
+ */
+template <typename Scalar>
+struct ExponentialFalloff {
+  Scalar length{100};
+
+  Scalar operator()(Scalar numerator, Scalar distance) const {
+    return numerator * std::exp(-distance / length);
+  }
+};
+
+/**
+ * @brief numerator * e^(-distance^2 / (2 sigma^2)).
+ */
+template <typename Scalar>
+struct GaussianFalloff {
+  Scalar sigma{100};
+
+  Scalar operator()(Scalar numerator, Scalar distance) const {
+    return numerator * std::exp(-distance * distance / (2 * sigma * sigma));
+  }
+};
+
+/**
+ * @brief numerator times a curve looked up in a table, for curves given
+ * as points or too costly to evaluate per emitter.
+ *
+ * The curve is sampled at evenly spaced distances from 0 to a maximum once,
+ * when the table is made; a lookup interpolates linearly between the two
+ * nearest samples, and distances past the maximum get the last sample.
+ * Tables are made with at least 2 samples; a table whose maximum is not
+ * positive holds the curve's value at distance 0 for every distance.
+ */
+template <typename Scalar>
+class TabulatedFalloff {
+ public:
+  typedef std::pair<double, double> knot;
+
+  /**
+   * @brief The piecewise linear curve through knots, (distance, factor)
+   * pairs sorted by distance, held level before the first knot and after
+   * the last. Without knots the curve is 0.
+   *
+   * @param max_distance The table covers distances up to this.
+   * @param n_samples # of samples; fewer than 2 make 2.
+   */
+  TabulatedFalloff(const std::vector<knot> &knots, double max_distance,
+      size_t n_samples = 1024)
+      : TabulatedFalloff(max_distance, n_samples) {
+    if (knots.empty()) {
+      return;  // the samples are all 0
+    }
+    for (size_t i = 0; i < get_size(); ++i) {
+      double distance = SampleDistance(i);
+      auto after = std::upper_bound(knots.begin(), knots.end(), distance,
+        [](double value, const knot &k) { return value < k.first; });
+      if (after == knots.begin()) {
+        samples_[i] = static_cast<Scalar>(knots.front().second);
+      } else if (after == knots.end()) {
+        samples_[i] = static_cast<Scalar>(knots.back().second);
+      } else {
+        const knot &before = *(after - 1);
+        double fraction = (distance - before.first) /
+          (after->first - before.first);
+        samples_[i] = static_cast<Scalar>(before.second +
+          (after->second - before.second) * fraction);
+      }
+    }
+    samples_[get_size()] = samples_[get_size() - 1];
+  }
+
+  /**
+   * @brief The table of another falloff policy, e.g. to look up a
+   * GaussianFalloff instead of calling exp.
+   */
+  template <typename Falloff>
+  static TabulatedFalloff Tabulate(const Falloff &falloff,
+      double max_distance, size_t n_samples = 1024) {
+    TabulatedFalloff table(max_distance, n_samples);
+    size_t n = table.get_size();
+    for (size_t i = 0; i < n; ++i) {
+      table.samples_[i] = falloff(static_cast<Scalar>(1),
+        static_cast<Scalar>(table.SampleDistance(i)));
+    }
+    table.samples_[n] = table.samples_[n - 1];
+    return table;
+  }
+
+  Scalar operator()(Scalar numerator, Scalar distance) const {
+    // clamping instead of branching; the sample after the last repeats it,
+    // so the last position needs no special case either
+    Scalar position = std::min(distance * lookup_scale_, last_);
+    size_t i = static_cast<size_t>(position);
+    Scalar fraction = position - static_cast<Scalar>(i);
+    return numerator * (samples_[i] + (samples_[i + 1] - samples_[i]) *
+      fraction);
+  }
+
+  size_t get_size() const { return samples_.size() - 1; }
+
+ private:
+  TabulatedFalloff(double max_distance, size_t n_samples)
+      : scale_(max_distance > 0 ?
+          (AtLeastTwo(n_samples) - 1) / max_distance : 0),
+        lookup_scale_(static_cast<Scalar>(scale_)),
+        last_(static_cast<Scalar>(AtLeastTwo(n_samples) - 1)),
+        samples_(AtLeastTwo(n_samples) + 1) {}
+
+  static size_t AtLeastTwo(size_t n_samples) {
+    return std::max(n_samples, static_cast<size_t>(2));
+  }
+
+  /**
+   * @brief The distance sample i is taken at.
+   */
+  double SampleDistance(size_t i) const {
+    return scale_ > 0 ? i / scale_ : 0;
+  }
+
+  // samples per unit of distance; 0 if the table covers no distance
+  double scale_;
+  Scalar lookup_scale_;
+  // the position of the last sample
+  Scalar last_;
+  std::vector<Scalar> samples_;
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief The mean reading, for a numerator of 1, over the pairs of sensor
+ * and emitter positions in an x_dim by y_dim arena that are further apart
+ * than range.
+ *
+ * Both are sampled on an n_samples x n_samples grid; only the offsets
+ * between samples matter, so each offset is weighted by the # of pairs of
+ * samples that far apart.
+ */
+template <typename Falloff>
+double MeanFarReading(const Falloff &falloff, double x_dim, double y_dim,
+    double range, int n_samples = 64) {
+  double step_x = x_dim / n_samples;
+  double step_y = y_dim / n_samples;
+  double sum = 0;
+  double pairs = 0;
+  for (int i = 1 - n_samples; i < n_samples; ++i) {
+    for (int j = 1 - n_samples; j < n_samples; ++j) {
+      double distance = std::hypot(i * step_x, j * step_y);
+      if (distance > range) {
+        double weight = (n_samples - std::abs(i)) * (n_samples - std::abs(j));
+        sum += weight * falloff(1, distance);
+        pairs += weight;
+      }
+    }
+  }
+  return pairs > 0 ? sum / pairs : 0;
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SENSOR_FALLOFF_H_
@@ -0,0 +1,247 @@
+/**
+ * @file software_rasterizer.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+
+#include "src/software_rasterizer.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+// Lowest and highest pixel index whose center (i + 0.5) is in [low, high]
+int FirstPixel(double low) {
+  return static_cast<int>(std::ceil(low - 0.5));
+}
+int LastPixel(double high) {
+  return static_cast<int>(std::floor(high - 0.5));
+}
+
+void AppendBigEndian(std::vector<uint8_t> *out, uint32_t value) {
+  out->push_back(static_cast<uint8_t>(value >> 24));
+  out->push_back(static_cast<uint8_t>(value >> 16));
+  out->push_back(static_cast<uint8_t>(value >> 8));
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+std::array<uint32_t, 256> MakeCrcTable() {
+  std::array<uint32_t, 256> table;
+  for (uint32_t n = 0; n < 256; ++n) {
+    uint32_t c = n;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[n] = c;
+  }
+  return table;
+}
+
+uint32_t Crc32(const uint8_t *data, size_t length) {
+  // initialized once, even with several threads writing frames
+  static const std::array<uint32_t, 256> table = MakeCrcTable();
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < length; ++i) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+// A PNG chunk: length, type, data and the CRC of type and data
+void AppendChunk(std::vector<uint8_t> *png, const char *type,
+    const std::vector<uint8_t> &data) {
+  AppendBigEndian(png, static_cast<uint32_t>(data.size()));
+  size_t start = png->size();
+  png->insert(png->end(), type, type + 4);
+  png->insert(png->end(), data.begin(), data.end());
+  AppendBigEndian(png, Crc32(png->data() + start, png->size() - start));
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+    : width_(width),
+      height_(height),
+      pixels_(static_cast<size_t>(width) * height * 4, 0) {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SoftwareRasterizer::Clear(const RgbColor &color) {
+  for (int y = 0; y < height_; ++y) {
+    FillSpan(y, 0, width_, color);
+  }
+}
+
+void SoftwareRasterizer::Draw(const RenderBatcher &batcher, double zoom,
+    double x_dim, double y_dim) {
+  StrokeRect(x_dim * zoom, y_dim * zoom, RgbColor(255, 255, 255));
+  for (auto &batch : batcher.get_batches()) {
+    for (auto &circle : batch.circles) {
+      FillCircle(circle.x * zoom, circle.y * zoom, circle.radius * zoom,
+        batch.fill);
+    }
+    for (auto &circle : batch.circles) {
+      StrokeCircle(circle.x * zoom, circle.y * zoom, circle.radius * zoom,
+        batch.stroke);
+    }
+  }
+}
+
+void SoftwareRasterizer::FillCircle(double x, double y, double radius,
+    const RgbColor &color) {
+  int first_row = std::max(FirstPixel(y - radius), 0);
+  int last_row = std::min(LastPixel(y + radius), height_ - 1);
+  for (int row = first_row; row <= last_row; ++row) {
+    double dy = row + 0.5 - y;
+    double half_width = std::sqrt(std::max(radius * radius - dy * dy, 0.0));
+    FillSpan(row, FirstPixel(x - half_width), LastPixel(x + half_width) + 1,
+      color);
+  }
+}
+
+void SoftwareRasterizer::StrokeCircle(double x, double y, double radius,
+    const RgbColor &color) {
+  double outer = radius + 0.5;
+  double inner = radius - 0.5;
+  int first_row = std::max(FirstPixel(y - outer), 0);
+  int last_row = std::min(LastPixel(y + outer), height_ - 1);
+  for (int row = first_row; row <= last_row; ++row) {
+    double dy = row + 0.5 - y;
+    double outer_half = std::sqrt(std::max(outer * outer - dy * dy, 0.0));
+    double inner_squared = inner * inner - dy * dy;
+    if (inner < 0 || inner_squared < 0) {
+      // above or below the hole: the whole row of the circle is outline
+      FillSpan(row, FirstPixel(x - outer_half), LastPixel(x + outer_half) + 1,
+        color);
+      continue;
+    }
+    double inner_half = std::sqrt(inner_squared);
+    FillSpan(row, FirstPixel(x - outer_half), LastPixel(x - inner_half) + 1,
+      color);
+    FillSpan(row, FirstPixel(x + inner_half), LastPixel(x + outer_half) + 1,
+      color);
+  }
+}
+
+void SoftwareRasterizer::StrokeRect(double width, double height,
+    const RgbColor &color) {
+  int right = static_cast<int>(std::lround(width)) - 1;
+  int bottom = static_cast<int>(std::lround(height)) - 1;
+  FillSpan(0, 0, right + 1, color);
+  FillSpan(bottom, 0, right + 1, color);
+  for (int row = 1; row < bottom; ++row) {
+    FillSpan(row, 0, 1, color);
+    FillSpan(row, right, right + 1, color);
+  }
+}
+
+void SoftwareRasterizer::FillSpan(int y, int x_begin, int x_end,
+    const RgbColor &color) {
+  if (y < 0 || y >= height_) {
+    return;
+  }
+  x_begin = std::max(x_begin, 0);
+  x_end = std::min(x_end, width_);
+  uint8_t *pixel =
+    pixels_.data() + (static_cast<size_t>(y) * width_ + x_begin) * 4;
+  for (int x = x_begin; x < x_end; ++x) {
+    pixel[0] = static_cast<uint8_t>(color.r);
+    pixel[1] = static_cast<uint8_t>(color.g);
+    pixel[2] = static_cast<uint8_t>(color.b);
+    pixel[3] = 255;
+    pixel += 4;
+  }
+}
+
+bool SoftwareRasterizer::WritePPM(const std::string &path) const {
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  file << "P6\n" << width_ << " " << height_ << "\n255\n";
+  std::vector<char> row(static_cast<size_t>(width_) * 3);
+  for (int y = 0; y < height_; ++y) {
+    const uint8_t *pixel =
+      pixels_.data() + static_cast<size_t>(y) * width_ * 4;
+    for (int x = 0; x < width_; ++x) {
+      row[x * 3] = static_cast<char>(pixel[x * 4]);
+      row[x * 3 + 1] = static_cast<char>(pixel[x * 4 + 1]);
+      row[x * 3 + 2] = static_cast<char>(pixel[x * 4 + 2]);
+    }
+    file.write(row.data(), row.size());
+  }
+  return static_cast<bool>(file);
+}
+
+bool SoftwareRasterizer::WritePNG(const std::string &path) const {
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+  // 8 bit RGBA, no interlacing
+  std::vector<uint8_t> header;
+  AppendBigEndian(&header, static_cast<uint32_t>(width_));
+  AppendBigEndian(&header, static_cast<uint32_t>(height_));
+  header.insert(header.end(), {8, 6, 0, 0, 0});
+  AppendChunk(&png, "IHDR", header);
+
+  // Each row is prefixed with filter type 0 (none)
+  size_t row_size = static_cast<size_t>(width_) * 4;
+  std::vector<uint8_t> raw;
+  raw.reserve((row_size + 1) * height_);
+  for (int y = 0; y < height_; ++y) {
+    raw.push_back(0);
+    auto row = pixels_.begin() + y * row_size;
+    raw.insert(raw.end(), row, row + row_size);
+  }
+
+  // zlib stream of stored (uncompressed) deflate blocks
+  std::vector<uint8_t> data = {0x78, 0x01};
+  const size_t kMaxBlock = 65535;
+  size_t offset = 0;
+  do {
+    size_t length = std::min(kMaxBlock, raw.size() - offset);
+    bool last = offset + length == raw.size();
+    data.push_back(last ? 1 : 0);
+    data.push_back(static_cast<uint8_t>(length));
+    data.push_back(static_cast<uint8_t>(length >> 8));
+    data.push_back(static_cast<uint8_t>(~length));
+    data.push_back(static_cast<uint8_t>(~length >> 8));
+    data.insert(data.end(), raw.begin() + offset,
+      raw.begin() + offset + length);
+    offset += length;
+  } while (offset < raw.size());
+  uint32_t a = 1, b = 0;  // Adler-32 of the uncompressed data
+  for (uint8_t byte : raw) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  AppendBigEndian(&data, (b << 16) | a);
+  AppendChunk(&png, "IDAT", data);
+  AppendChunk(&png, "IEND", std::vector<uint8_t>());
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(png.data()), png.size());
+  return static_cast<bool>(file);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,104 @@
+/**
+ * @file software_rasterizer.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_SOFTWARE_RASTERIZER_H_
+#define SRC_SOFTWARE_RASTERIZER_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/common.h"
+#include "src/render_batch.h"
+#include "src/rgb_color.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Draws the arena into an in-memory RGBA image on the CPU, so frames
+ * can be rendered without a display or OpenGL.
+ *
+ * It draws the same batches as GraphicsArenaViewer: filled circles with a
+ * 1 pixel outline, over the arena's border. Text labels are not drawn, since
+ * there is no font renderer. Pixels are row-major, 4 bytes per pixel, with
+ * the top row first.
+ */
+class SoftwareRasterizer {
+ public:
+  SoftwareRasterizer(int width, int height);
+
+  /**
+   * @brief Fill the whole image with one color.
+   */
+  void Clear(const RgbColor &color);
+
+  /**
+   * @brief Draw the arena border and every batch of batcher.
+   *
+   * @param batcher Batches built for this image's size and zoom.
+   * @param zoom Pixels per arena unit.
+   * @param x_dim Width of the arena.
+   * @param y_dim Height of the arena.
+   */
+  void Draw(const RenderBatcher &batcher, double zoom, double x_dim,
+    double y_dim);
+
+  void FillCircle(double x, double y, double radius, const RgbColor &color);
+
+  /**
+   * @brief Draw a 1 pixel wide outline centered on the circle's edge.
+   */
+  void StrokeCircle(double x, double y, double radius,
+    const RgbColor &color);
+
+  /**
+   * @brief Draw a 1 pixel wide outline of the rectangle from (0, 0) to
+   * (width, height).
+   */
+  void StrokeRect(double width, double height, const RgbColor &color);
+
+  /**
+   * @brief Write the image as a binary PPM (P6). Alpha is dropped.
+   *
+   * @return false if the file could not be written.
+   */
+  bool WritePPM(const std::string &path) const;
+
+  /**
+   * @brief Write the image as an RGBA PNG. The image data is stored without
+   * compression, so no compression library is needed.
+   *
+   * @return false if the file could not be written.
+   */
+  bool WritePNG(const std::string &path) const;
+
+  int get_width() const { return width_; }
+  int get_height() const { return height_; }
+  const std::vector<uint8_t> &get_pixels() const { return pixels_; }
+
+ private:
+  /**
+   * @brief Set pixels [x_begin, x_end) of row y, clipped to the image.
+   */
+  void FillSpan(int y, int x_begin, int x_end, const RgbColor &color);
+
+  int width_;
+  int height_;
+  std::vector<uint8_t> pixels_;
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SOFTWARE_RASTERIZER_H_
@@ -0,0 +1,715 @@
+/**
+ * @file step_engine.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_STEP_ENGINE_H_
+#define SRC_STEP_ENGINE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+#include "src/entity_type.h"
+#include "src/food.h"
+#include "src/interaction_table.h"
+#include "src/light.h"
+#include "src/params.h"
+#include "src/robot.h"
+#include "src/step_stats.h"
+#include "src/sweep_and_prune.h"
+#include "src/swept_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief The EntityType of the entities of class T.
+ */
+template <typename T>
+struct EntityTypeOf;
+
+template <>
+struct EntityTypeOf<Robot> : std::integral_constant<EntityType, kRobot> {};
+
+template <>
+struct EntityTypeOf<Light> : std::integral_constant<EntityType, kLight> {};
+
+template <>
+struct EntityTypeOf<Food> : std::integral_constant<EntityType, kFood> {};
+
+/**
+ * @brief GetInteraction() for the entity classes A and B, at compile time.
+ */
+template <typename A, typename B>
+struct InteractionRule : std::integral_constant<Interaction,
+  GetInteraction(EntityTypeOf<A>::value, EntityTypeOf<B>::value)> {};
+
+/**
+ * @brief Whether entities of type T move. Mobile entities are updated,
+ * swept and kept inside the walls every timestep; immobile ones are only
+ * counted.
+ */
+template <typename T>
+struct IsMobile : std::true_type {};
+
+template <>
+struct IsMobile<Food> : std::false_type {};
+
+/**
+ * @brief Whether entities of type T bounce off the walls.
+ */
+template <typename T>
+struct CollidesWithWalls : std::integral_constant<bool, IsMobile<T>::value &&
+  GetInteraction(EntityTypeOf<T>::value, kLeftWall) == kCollide> {};
+
+/**
+ * @brief Whether entities of type T collide with the entities of any of
+ * Others.
+ */
+template <typename T, typename... Others>
+struct CollidesWithAny : std::false_type {};
+
+template <typename T, typename Other, typename... Others>
+struct CollidesWithAny<T, Other, Others...> : std::integral_constant<bool,
+  InteractionRule<T, Other>::value == kCollide ||
+  CollidesWithAny<T, Others...>::value> {};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief The movement and collision part of an arena timestep, compiled for
+ * a fixed set of entity types.
+ *
+ * Each type has its own range of entities (e.g. the arena's vector of
+ * Robots), so every loop works on concrete types: HandleCollision is called
+ * directly, without dynamic_cast. Which loops exist is decided by the
+ * interaction table (see GetInteraction()): pairs of types that collide get
+ * the sweep and overlap tests, pairs where one senses the other only get
+ * the cheap sensing pass, and loops over pairs that ignore each other are
+ * never generated.
+ *
+ * Within a type, entities are visited in the order of their range, so the
+ * results are the same as a single loop over all mobile entities with the
+ * types in the order of Types.
+ *
+ * The pairs of entities that may collide are found by the broadphase (see
+ * set_broadphase()). Whichever finds them, the pairs are handled in the
+ * same order, so the broadphase does not change the results.
+ *
+ * @tparam Types The entity types, e.g. Robot, Light, Food.
+ */
+template <typename... Types>
+class StepEngine {
+ public:
+  /**
+   * @param ranges The entities of each type. The vectors are not owned and
+   * may change between timesteps.
+   */
+  explicit StepEngine(std::vector<Types *> *... ranges)
+      : ranges_(ranges...) {}
+
+  /**
+   * @brief Set read-only copies of entities owned elsewhere (see GhostPool).
+   * Entities sense ghosts and are separated from the ghosts they collide
+   * with, but ghosts are never updated or swept.
+   *
+   * @param ghosts The ghosts of each type. The vectors are not owned.
+   */
+  void set_ghosts(std::vector<Types *> *... ghosts) {
+    ghosts_ = std::make_tuple(ghosts...);
+  }
+
+  /**
+   * @brief Choose how the pairs of entities that may collide are found.
+   * Brute force tests every pair, which is fastest for a few entities;
+   * sweep and prune only tests the pairs whose bounding boxes overlap,
+   * however closely the entities are clustered.
+   */
+  void set_broadphase(Broadphase broadphase) { broadphase_ = broadphase; }
+  Broadphase get_broadphase() const { return broadphase_; }
+
+  /**
+   * @brief Remember where every mobile entity starts, then update the ones
+   * that are awake and due (see ArenaMobileEntity::IsUpdateDue()) by dt for
+   * each timestep since their last update.
+   *
+   * @param[out] stats Gets the # of active, deferred, sleeping and static
+   * entities.
+   */
+  void Update(unsigned int dt, StepStats *stats) {
+    ForEachType([&](auto i) {
+      this->UpdateType<decltype(i)::value>(dt, stats,
+        IsMobile<TypeAt<decltype(i)::value>>());
+    });
+  }
+
+  /**
+   * @brief Call world->Sense(ent, other) for every entity and every other
+   * entity (or ghost) it senses, skipping the entities for which
+   * world->IsSensing(ent, other type) is false this step. If
+   * world->SenseInRange(ent, other type) is true, the world has sensed the
+   * entities near ent itself (e.g. with a neighbor query); otherwise there
+   * is no distance test, and how far away the other entity is, is up to the
+   * sensors.
+   *
+   * @param world Handles each sensed pair (e.g. the Arena).
+   */
+  template <typename World>
+  void Sense(World *world) {
+    ForEachType([&](auto i) {
+      ForEachType([&](auto j) {
+        this->SensePairs<decltype(i)::value, decltype(j)::value>(world,
+          Senses<decltype(i)::value, decltype(j)::value>());
+      });
+    });
+  }
+
+  /**
+   * @brief Continuous collision detection for the motion of the timestep.
+   * Each mobile entity is stopped where it first reaches a wall, then every
+   * pair of entities that collide is swept and moved back to where they
+   * touched.
+   *
+   * @param world Provides the walls (e.g. the Arena).
+   * @param[out] stats Gets a collision counted for each entity hit.
+   */
+  template <typename World>
+  void SweepCollisions(World *world, StepStats *stats) {
+    ForEachType([&](auto i) {
+      this->SweepWalls<decltype(i)::value>(world, stats,
+        CollidesWithWalls<TypeAt<decltype(i)::value>>());
+    });
+    if (kSweepAndPrune == broadphase_) {
+      FindSweptPairs();
+    }
+    ForEachType([&](auto i) {
+      ForEachType([&](auto j) {
+        this->SweepPairs<decltype(i)::value, decltype(j)::value>(stats,
+          SweepsPair<decltype(i)::value, decltype(j)::value>());
+      });
+    });
+  }
+
+  /**
+   * @brief Separate the entities that were updated this timestep from the
+   * walls and from the entities they collide with, where they still overlap
+   * (e.g. because they started the step overlapping).
+   *
+   * @param world Provides the walls and the overlap tests (e.g. the Arena).
+   * @param[out] stats Gets a collision counted for each entity hit.
+   */
+  template <typename World>
+  void ResolveOverlaps(World *world, StepStats *stats) {
+    if (kSweepAndPrune == broadphase_) {
+      SortOverlapBoxes();
+    }
+    ForEachType([&](auto i) {
+      this->ResolveType<decltype(i)::value>(world, stats,
+        IsMobile<TypeAt<decltype(i)::value>>());
+    });
+  }
+
+ private:
+  template <size_t I>
+  using TypeAt = typename std::tuple_element<I, std::tuple<Types...>>::type;
+
+  template <size_t I, size_t J>
+  using Collides = std::integral_constant<bool,
+    InteractionRule<TypeAt<I>, TypeAt<J>>::value == kCollide>;
+
+  template <size_t I>
+  using CollidesWithEntities =
+    typename CollidesWithAny<TypeAt<I>, Types...>::type;
+
+  template <size_t I, size_t J>
+  using Senses = std::integral_constant<bool,
+    InteractionRule<TypeAt<I>, TypeAt<J>>::value == kSense>;
+
+  // each unordered pair of types is swept once, from the lower index
+  template <size_t I, size_t J>
+  using SweepsPair = std::integral_constant<bool,
+    I <= J && Collides<I, J>::value>;
+
+  /**
+   * @brief Call f(std::integral_constant<size_t, I>()) for the index I of
+   * each type, in order.
+   */
+  template <typename F>
+  static void ForEachType(F &&f) {
+    ForEachIndex(f, std::index_sequence_for<Types...>());
+  }
+
+  template <typename F, size_t... I>
+  static void ForEachIndex(F &f, std::index_sequence<I...>) {
+    int expand[] = {0, (f(std::integral_constant<size_t, I>()), 0)...};
+    static_cast<void>(expand);
+  }
+
+  /**
+   * @brief Call f(ent) for every entity and then every ghost of type J.
+   */
+  template <size_t J, typename F>
+  void ForEachOther(F &&f) {
+    for (auto ent : *std::get<J>(ranges_)) {
+      f(ent);
+    }
+    if (std::get<J>(ghosts_) != nullptr) {
+      for (auto ghost : *std::get<J>(ghosts_)) {
+        f(ghost);
+      }
+    }
+  }
+
+  template <size_t I>
+  void UpdateType(unsigned int dt, StepStats *stats, std::true_type) {
+    std::vector<TypeAt<I> *> &range = *std::get<I>(ranges_);
+    std::vector<TypeAt<I> *> &active = std::get<I>(active_);
+    active.clear();
+    active_indices_[I].clear();
+    for (auto ent : range) {
+      ent->set_step_start_pose(ent->get_pose());
+    }
+    size_t deferred = 0;
+    for (size_t index = 0; index < range.size(); ++index) {
+      TypeAt<I> *ent = range[index];
+      if (!ent->IsUpdateDue()) {
+        ent->DeferTimestep();
+        ++deferred;
+        continue;
+      }
+      // catch up on the timesteps deferred by a lower level of detail
+      unsigned int steps = ent->TakeDeferredSteps();
+      if (ent->CanSkipTimestep()) {
+        continue;
+      }
+      ent->TimestepUpdate(dt * steps);
+      active.push_back(ent);
+      active_indices_[I].push_back(static_cast<uint32_t>(index));
+    }
+    stats->active_entities += active.size();
+    stats->deferred_entities += deferred;
+    stats->sleeping_entities +=
+      std::get<I>(ranges_)->size() - active.size() - deferred;
+  }
+
+  template <size_t I>
+  void UpdateType(unsigned int, StepStats *stats, std::false_type) {
+    stats->static_entities += std::get<I>(ranges_)->size();
+  }
+
+  template <size_t I, size_t J, typename World>
+  void SensePairs(World *world, std::true_type) {
+    for (auto ent : *std::get<I>(ranges_)) {
+      // the typed null pointer only selects the overloads
+      TypeAt<J> * const type = nullptr;
+      if (world->IsSensing(ent, type) && !world->SenseInRange(ent, type)) {
+        ForEachOther<J>([&](TypeAt<J> *other) { world->Sense(ent, other); });
+      }
+    }
+  }
+
+  template <size_t I, size_t J, typename World>
+  void SensePairs(World *, std::false_type) {}
+
+  template <size_t I, typename World>
+  void SweepWalls(World *world, StepStats *stats, std::true_type) {
+    for (auto ent : *std::get<I>(ranges_)) {
+      double toi;
+      EntityType wall = world->GetSweptCollisionWall(ent, &toi);
+      if (kUndefined != wall) {
+        ent->set_pose(InterpolatePosition(ent->get_step_start_pose(),
+          ent->get_pose(), toi));
+        world->AdjustWallOverlap(ent, wall);
+        ent->HandleCollision(wall);
+        ++stats->collisions;
+      }
+    }
+  }
+
+  template <size_t I, typename World>
+  void SweepWalls(World *, StepStats *, std::false_type) {}
+
+  // An entity moved back by an earlier contact is swept up to its new
+  // position.
+  template <size_t I, size_t J>
+  void SweepPairs(StepStats *stats, std::true_type) {
+    static_assert(Collides<J, I>::value,
+      "entities can only collide with entities that collide with them");
+    std::vector<TypeAt<I> *> &range1 = *std::get<I>(ranges_);
+    std::vector<TypeAt<J> *> &range2 = *std::get<J>(ranges_);
+    if (kSweepAndPrune == broadphase_) {
+      // in the order of the loops below
+      std::vector<SweepAndPrune::slot_pair> &pairs =
+        pair_buckets_[I * sizeof...(Types) + J];
+      std::sort(pairs.begin(), pairs.end());
+      for (auto &pair : pairs) {
+        SweepPair(range1[pair.first], range2[pair.second], stats);
+      }
+      return;
+    }
+    for (size_t a = 0; a < range1.size(); ++a) {
+      for (size_t b = (I == J ? a + 1 : 0); b < range2.size(); ++b) {
+        SweepPair(range1[a], range2[b], stats);
+      }
+    }
+  }
+
+  template <size_t I, size_t J>
+  void SweepPairs(StepStats *, std::false_type) {}
+
+  template <typename T1, typename T2>
+  void SweepPair(T1 *ent1, T2 *ent2, StepStats *stats) {
+    double toi = SweptCircleTimeOfImpact(
+      ent1->get_step_start_pose(), ent1->get_pose(),
+      ent2->get_step_start_pose(), ent2->get_pose(),
+      ent1->get_radius() + ent2->get_radius() + COLLISION_SKIN);
+    if (toi < 0) {
+      return;
+    }
+    ent1->set_pose(InterpolatePosition(ent1->get_step_start_pose(),
+      ent1->get_pose(), toi));
+    ent2->set_pose(InterpolatePosition(ent2->get_step_start_pose(),
+      ent2->get_pose(), toi));
+    ent1->HandleCollision(ent2->get_type(), ent2);
+    ent2->HandleCollision(ent1->get_type(), ent1);
+    stats->collisions += 2;
+  }
+
+  /**
+   * @brief Sort the pairs of entities whose motion this step may bring them
+   * into contact into pair_buckets_, by their types and indices.
+   *
+   * Each entity's box holds its whole motion, grown by its radius and the
+   * collision skin. Entities only move back along their motion while the
+   * pairs are swept, so no pair that is not found can collide.
+   */
+  void FindSweptPairs() {
+    size_t n_slots = NumberSlots(&swept_slots_, false);
+    swept_sap_.Resize(n_slots);
+    ForEachType([&](auto i) {
+      this->SetSweptBoxes<decltype(i)::value>(
+        CollidesWithEntities<decltype(i)::value>());
+    });
+    swept_sap_.FindPairs(&slot_pairs_);
+    for (auto &pairs : pair_buckets_) {
+      pairs.clear();
+    }
+    for (auto &pair : slot_pairs_) {
+      // slots are numbered type by type, so type1 <= type2
+      size_t type1 = TypeOfSlot(swept_slots_, pair.first);
+      size_t type2 = TypeOfSlot(swept_slots_, pair.second);
+      pair_buckets_[type1 * sizeof...(Types) + type2].emplace_back(
+        pair.first - swept_slots_[type1], pair.second - swept_slots_[type2]);
+    }
+  }
+
+  template <size_t I>
+  void SetSweptBoxes(std::true_type) {
+    std::vector<TypeAt<I> *> &range = *std::get<I>(ranges_);
+    for (size_t index = 0; index < range.size(); ++index) {
+      const Pose &start = range[index]->get_step_start_pose();
+      const Pose &end = range[index]->get_pose();
+      double reach = range[index]->get_radius() + COLLISION_SKIN;
+      swept_sap_.set_box(swept_slots_[I] + index,
+        std::min(start.x, end.x) - reach, std::min(start.y, end.y) - reach,
+        std::max(start.x, end.x) + reach, std::max(start.y, end.y) + reach);
+    }
+  }
+
+  template <size_t I>
+  void SetSweptBoxes(std::false_type) {}
+
+  /**
+   * @brief Number the entities (and, with_ghosts, then the ghosts) of each
+   * type that collides with anything, type by type. That is the order the
+   * brute force loops visit them in.
+   *
+   * @param[out] first The first slot of each type, and the # of slots last.
+   *
+   * @return The # of slots.
+   */
+  template <size_t N>
+  size_t NumberSlots(std::array<size_t, N> *first, bool with_ghosts) {
+    size_t n_slots = 0;
+    ForEachType([&](auto i) {
+      constexpr size_t I = decltype(i)::value;
+      (*first)[I] = n_slots;
+      if (CollidesWithEntities<I>::value) {
+        n_slots += std::get<I>(ranges_)->size();
+        if (with_ghosts && std::get<I>(ghosts_) != nullptr) {
+          n_slots += std::get<I>(ghosts_)->size();
+        }
+      }
+    });
+    (*first)[N - 1] = n_slots;
+    return n_slots;
+  }
+
+  template <size_t N>
+  static size_t TypeOfSlot(const std::array<size_t, N> &first,
+      size_t slot) {
+    return std::upper_bound(first.begin(), first.end() - 1, slot) -
+      first.begin() - 1;
+  }
+
+  template <size_t I, typename World>
+  void ResolveType(World *world, StepStats *stats, std::true_type) {
+    if (kSweepAndPrune == broadphase_) {
+      ResolveTypePruned<I>(world, stats);
+      return;
+    }
+    for (auto ent1 : std::get<I>(active_)) {
+      ResolveWalls(world, stats, ent1, CollidesWithWalls<TypeAt<I>>());
+      ForEachType([&](auto j) {
+        this->ResolvePairs<decltype(j)::value>(world, stats, ent1,
+          Collides<I, decltype(j)::value>());
+      });
+    }
+  }
+
+  template <size_t I, typename World>
+  void ResolveType(World *, StepStats *, std::false_type) {}
+
+  /**
+   * @brief ResolveType() with the boxes sorted by SortOverlapBoxes().
+   *
+   * Only the entities whose boxes overlap an entity's box can collide with
+   * it. When it is moved, its box is moved with it and the entities after
+   * the one it was moved away from are found again around where it is now,
+   * so the pairs are tested in the order brute force tests them.
+   */
+  template <size_t I, typename World>
+  void ResolveTypePruned(World *world, StepStats *stats) {
+    for (size_t k = 0; k < std::get<I>(active_).size(); ++k) {
+      TypeAt<I> *ent1 = std::get<I>(active_)[k];
+      size_t slot = overlap_slots_[I] + active_indices_[I][k];
+      bool moved = ResolveWalls(world, stats, ent1,
+        CollidesWithWalls<TypeAt<I>>());
+      // only the slots from next on are still to be tested
+      size_t next = 0;
+      while (true) {
+        if (moved) {
+          SetOverlapBox(slot, ent1, &SweepAndPrune::MoveBox);
+          moved = false;
+        }
+        candidates_.clear();
+        double reach = ent1->get_radius() + COLLISION_SKIN;
+        overlap_sap_.QueryBox(ent1->get_pose().x - reach,
+          ent1->get_pose().y - reach, ent1->get_pose().x + reach,
+          ent1->get_pose().y + reach, &candidates_);
+        std::sort(candidates_.begin(), candidates_.end());
+        for (auto other : candidates_) {
+          if (other >= next && ResolveSlot<I>(world, stats, ent1, other)) {
+            moved = true;
+            next = other + 1;
+            break;
+          }
+        }
+        if (!moved) {
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Call (overlap_sap_.*set)(slot, box) with the box of ent, grown by
+   * its radius and the collision skin.
+   */
+  template <typename T>
+  void SetOverlapBox(size_t slot, const T *ent,
+      void (SweepAndPrune::*set)(size_t, double, double, double, double)) {
+    double reach = ent->get_radius() + COLLISION_SKIN;
+    (overlap_sap_.*set)(slot, ent->get_pose().x - reach,
+      ent->get_pose().y - reach, ent->get_pose().x + reach,
+      ent->get_pose().y + reach);
+  }
+
+  /**
+   * @brief Box every entity (and ghost) of the types that collide, grown by
+   * its radius and the collision skin, where it is now, for
+   * ResolveTypePruned().
+   */
+  void SortOverlapBoxes() {
+    size_t n_slots = NumberSlots(&overlap_slots_, true);
+    overlap_sap_.Resize(n_slots);
+    ForEachType([&](auto i) {
+      constexpr size_t I = decltype(i)::value;
+      if (!CollidesWithEntities<I>::value) {
+        return;
+      }
+      size_t slot = overlap_slots_[I];
+      this->ForEachOther<I>([&](TypeAt<I> *ent) {
+        this->SetOverlapBox(slot++, ent, &SweepAndPrune::set_box);
+      });
+    });
+    overlap_sap_.Sort();
+  }
+
+  /**
+   * @brief ResolveOne() for ent1 and the entity (or ghost) in slot of the
+   * overlap slots, if their types collide.
+   *
+   * @return true if ent1 was moved.
+   */
+  template <size_t I, typename World, typename T>
+  bool ResolveSlot(World *world, StepStats *stats, T *ent1, size_t slot) {
+    bool moved = false;
+    ForEachType([&](auto j) {
+      constexpr size_t J = decltype(j)::value;
+      if (slot < overlap_slots_[J] || slot >= overlap_slots_[J + 1] ||
+          !Collides<I, J>::value) {
+        return;
+      }
+      std::vector<TypeAt<J> *> &range = *std::get<J>(ranges_);
+      size_t index = slot - overlap_slots_[J];
+      bool ghost = index >= range.size();
+      TypeAt<J> *ent2 = ghost ?
+        (*std::get<J>(ghosts_))[index - range.size()] : range[index];
+      moved = this->ResolveOne(world, stats, ent1, ent2, ghost);
+    });
+    return moved;
+  }
+
+  /**
+   * @brief Move ent away from every wall and obstacle it touches, telling
+   * it of each once. Moving it off one may push it into another (e.g. in a
+   * corner), so the contacts are found again until it is clear, as
+   * ObstacleMap::Separate() does with its segments.
+   *
+   * @return true if ent was moved away from a wall.
+   */
+  template <typename World, typename T>
+  bool ResolveWalls(World *world, StepStats *stats, T *ent, std::true_type) {
+    static const EntityType kWalls[] = {kRightWall, kLeftWall, kBottomWall,
+      kTopWall, kObstacle};
+    unsigned int told = 0;
+    for (int pass = 0; pass < kWallPasses; ++pass) {
+      unsigned int touched = world->GetCollisionWalls(ent);
+      if (0 == touched) {
+        break;
+      }
+      for (EntityType wall : kWalls) {
+        if (touched & (1u << wall)) {
+          world->AdjustWallOverlap(ent, wall);
+        }
+      }
+      for (EntityType wall : kWalls) {
+        if (touched & ~told & (1u << wall)) {
+          ent->HandleCollision(wall);
+          ++stats->collisions;
+        }
+      }
+      told |= touched;
+    }
+    return told != 0;
+  }
+
+  template <typename World, typename T>
+  bool ResolveWalls(World *, StepStats *, T *, std::false_type) {
+    return false;
+  }
+
+  template <size_t J, typename World, typename T>
+  void ResolvePairs(World *world, StepStats *stats, T *ent1,
+      std::true_type) {
+    for (auto ent2 : *std::get<J>(ranges_)) {
+      ResolveOne(world, stats, ent1, ent2, false);
+    }
+    if (std::get<J>(ghosts_) != nullptr) {
+      for (auto ghost : *std::get<J>(ghosts_)) {
+        ResolveOne(world, stats, ent1, ghost, true);
+      }
+    }
+  }
+
+  /**
+   * @brief Separate ent1 from ent2 if they collide, and tell both, as
+   * SweepPair() does. ent2 may be asleep and not resolved itself this step,
+   * so telling it is what wakes it. Ghosts and immobile entities are not
+   * told.
+   *
+   * @return true if ent1 was moved.
+   */
+  template <typename World, typename T1, typename T2>
+  bool ResolveOne(World *world, StepStats *stats, T1 *ent1, T2 *ent2,
+      bool ghost) {
+    if (static_cast<ArenaEntity *>(ent2) == ent1 ||
+        !world->IsColliding(ent1, ent2)) {
+      return false;
+    }
+    world->SeparateEntities(ent1, ent2);
+    ent1->HandleCollision(ent2->get_type(), ent2);
+    ++stats->collisions;
+    if (!ghost) {
+      TellOther(stats, ent2, ent1, std::is_base_of<ArenaMobileEntity, T2>());
+    }
+    // being pushed off ent2 must not push ent1 through a wall
+    ResolveWalls(world, stats, ent1, CollidesWithWalls<T1>());
+    return true;
+  }
+
+  /**
+   * @brief Tell ent2 that ent1 hit it, if ent2 can move and so react.
+   */
+  template <typename T1, typename T2>
+  static void TellOther(StepStats *stats, T2 *ent2, T1 *ent1,
+      std::true_type) {
+    ent2->HandleCollision(ent1->get_type(), ent1);
+    ++stats->collisions;
+  }
+
+  template <typename T1, typename T2>
+  static void TellOther(StepStats *, T2 *, T1 *, std::false_type) {}
+
+  template <size_t J, typename World, typename T>
+  void ResolvePairs(World *, StepStats *, T *, std::false_type) {}
+
+  // times ResolveWalls() looks for contacts again, for corners that push
+  // back and forth
+  static constexpr int kWallPasses = 4;
+
+  std::tuple<std::vector<Types *> *...> ranges_;
+  // copies of entities owned elsewhere; null where there are none
+  std::tuple<std::vector<Types *> *...> ghosts_{};
+  // the mobile entities of each type updated this timestep, and their
+  // indices in the ranges
+  std::tuple<std::vector<Types *>...> active_{};
+  std::array<std::vector<uint32_t>, sizeof...(Types)> active_indices_{};
+
+  Broadphase broadphase_{kBruteForce};
+  // the first slot of each type in swept_sap_ and overlap_sap_, then the #
+  // of slots
+  std::array<size_t, sizeof...(Types) + 1> swept_slots_{};
+  std::array<size_t, sizeof...(Types) + 1> overlap_slots_{};
+  // kept between timesteps, so that they only re-sort what moved
+  SweepAndPrune swept_sap_{};
+  SweepAndPrune overlap_sap_{};
+  std::vector<SweepAndPrune::slot_pair> slot_pairs_{};
+  // the pairs of indices of each pair of types that may collide this step
+  std::array<std::vector<SweepAndPrune::slot_pair>,
+    sizeof...(Types) * sizeof...(Types)> pair_buckets_{};
+  // the slots ResolveTypePruned() tests an entity against
+  std::vector<uint32_t> candidates_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_STEP_ENGINE_H_
@@ -0,0 +1,53 @@
+/**
+ * @file step_stats.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_STEP_STATS_H_
+#define SRC_STEP_STATS_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Counts of the work done by Arena in the last timestep.
+ *
+ * Filled in by Arena::UpdateEntitiesTimestep() and available through
+ * Arena::get_step_stats().
+ */
+struct StepStats {
+  // mobile entities that were updated
+  size_t active_entities{0};
+  // mobile entities that slept through the step
+  size_t sleeping_entities{0};
+  // mobile entities not due for an update under their level of detail
+  size_t deferred_entities{0};
+  // immobile entities, which are never updated
+  size_t static_entities{0};
+  // collisions handled (with walls or other entities)
+  size_t collisions{0};
+  // meals that ended a robot's hunger
+  size_t meals{0};
+  // light sensor lines of sight cast through the obstacles, light sightings
+  // reused from the occlusion cache, and lines of sight found blocked
+  size_t occlusion_rays{0};
+  size_t occlusion_cache_hits{0};
+  size_t occluded_readings{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_STEP_STATS_H_
@@ -0,0 +1,189 @@
+/**
+ * @file sweep_and_prune.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <numeric>
+
+#include "src/sweep_and_prune.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+namespace {
+
+/**
+ * @brief n times the variance of values.
+ */
+double Spread(const std::vector<double> &values) {
+  if (values.empty()) {
+    return 0;
+  }
+  double mean = std::accumulate(values.begin(), values.end(), 0.0) /
+    values.size();
+  double spread = 0;
+  for (double value : values) {
+    spread += (value - mean) * (value - mean);
+  }
+  return spread;
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void SweepAndPrune::Resize(size_t n_slots) {
+  if (n_slots == min_x_.size()) {
+    return;
+  }
+  min_x_.resize(n_slots);
+  min_y_.resize(n_slots);
+  max_x_.resize(n_slots);
+  max_y_.resize(n_slots);
+  order_x_.resize(n_slots);
+  order_y_.resize(n_slots);
+  std::iota(order_x_.begin(), order_x_.end(), 0);
+  std::iota(order_y_.begin(), order_y_.end(), 0);
+}
+
+void SweepAndPrune::Sort() {
+  swaps_ = 0;
+  SortAxis(min_x_, &order_x_);
+  SortAxis(min_y_, &order_y_);
+  sweep_x_ = Spread(min_x_) >= Spread(min_y_);
+  max_width_x_ = 0;
+  max_width_y_ = 0;
+  for (size_t slot = 0; slot < min_x_.size(); ++slot) {
+    max_width_x_ = std::max(max_width_x_, max_x_[slot] - min_x_[slot]);
+    max_width_y_ = std::max(max_width_y_, max_y_[slot] - min_y_[slot]);
+  }
+  rank_x_.resize(order_x_.size());
+  rank_y_.resize(order_y_.size());
+  for (size_t rank = 0; rank < order_x_.size(); ++rank) {
+    rank_x_[order_x_[rank]] = static_cast<uint32_t>(rank);
+    rank_y_[order_y_[rank]] = static_cast<uint32_t>(rank);
+  }
+}
+
+void SweepAndPrune::MoveBox(size_t slot, double min_x, double min_y,
+    double max_x, double max_y) {
+  set_box(slot, min_x, min_y, max_x, max_y);
+  max_width_x_ = std::max(max_width_x_, max_x - min_x);
+  max_width_y_ = std::max(max_width_y_, max_y - min_y);
+  Reinsert(slot, min_x_, &order_x_, &rank_x_);
+  Reinsert(slot, min_y_, &order_y_, &rank_y_);
+}
+
+void SweepAndPrune::FindPairs(std::vector<slot_pair> *pairs) {
+  pairs->clear();
+  Sort();
+  if (sweep_x_) {
+    SweepAxis(order_x_, min_x_, max_x_, min_y_, max_y_, pairs);
+  } else {
+    SweepAxis(order_y_, min_y_, max_y_, min_x_, max_x_, pairs);
+  }
+}
+
+void SweepAndPrune::QueryBox(double min_x, double min_y, double max_x,
+    double max_y, std::vector<uint32_t> *found) const {
+  // scan the axis with fewer boxes in the way
+  if (CountAxis(order_x_, min_x_, max_width_x_, min_x, max_x) <=
+      CountAxis(order_y_, min_y_, max_width_y_, min_y, max_y)) {
+    QueryAxis(order_x_, min_x_, max_x_, max_width_x_, min_y_, max_y_, min_x,
+      max_x, min_y, max_y, found);
+  } else {
+    QueryAxis(order_y_, min_y_, max_y_, max_width_y_, min_x_, max_x_, min_y,
+      max_y, min_x, max_x, found);
+  }
+}
+
+void SweepAndPrune::SortAxis(const std::vector<double> &mins,
+    std::vector<uint32_t> *order) {
+  std::vector<uint32_t> &sorted = *order;
+  for (size_t i = 1; i < sorted.size(); ++i) {
+    uint32_t slot = sorted[i];
+    size_t j = i;
+    for (; j > 0 && mins[sorted[j - 1]] > mins[slot]; --j) {
+      sorted[j] = sorted[j - 1];
+    }
+    sorted[j] = slot;
+    swaps_ += i - j;
+  }
+}
+
+void SweepAndPrune::Reinsert(size_t slot, const std::vector<double> &mins,
+    std::vector<uint32_t> *order, std::vector<uint32_t> *ranks) {
+  std::vector<uint32_t> &sorted = *order;
+  size_t rank = (*ranks)[slot];
+  for (; rank > 0 && mins[sorted[rank - 1]] > mins[slot]; --rank) {
+    sorted[rank] = sorted[rank - 1];
+    (*ranks)[sorted[rank]] = static_cast<uint32_t>(rank);
+  }
+  for (; rank + 1 < sorted.size() && mins[sorted[rank + 1]] < mins[slot];
+      ++rank) {
+    sorted[rank] = sorted[rank + 1];
+    (*ranks)[sorted[rank]] = static_cast<uint32_t>(rank);
+  }
+  sorted[rank] = static_cast<uint32_t>(slot);
+  (*ranks)[slot] = static_cast<uint32_t>(rank);
+}
+
+void SweepAndPrune::SweepAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, const std::vector<double> &maxes,
+    const std::vector<double> &other_mins,
+    const std::vector<double> &other_maxes,
+    std::vector<slot_pair> *pairs) const {
+  for (size_t i = 0; i < order.size(); ++i) {
+    uint32_t slot = order[i];
+    // every box after this one starts at or after its min, so the boxes it
+    // overlaps on this axis are the ones that start before its max
+    for (size_t j = i + 1; j < order.size() && mins[order[j]] <= maxes[slot];
+        ++j) {
+      uint32_t other = order[j];
+      if (other_mins[other] <= other_maxes[slot] &&
+          other_mins[slot] <= other_maxes[other]) {
+        pairs->emplace_back(std::min(slot, other), std::max(slot, other));
+      }
+    }
+  }
+}
+
+size_t SweepAndPrune::CountAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, double max_width, double min,
+    double max) {
+  auto by_min = [&](uint32_t slot, double value) {
+    return mins[slot] < value; };
+  auto first = std::lower_bound(order.begin(), order.end(), min - max_width,
+    by_min);
+  auto last = std::lower_bound(first, order.end(), max, by_min);
+  return last - first;
+}
+
+void SweepAndPrune::QueryAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, const std::vector<double> &maxes,
+    double max_width, const std::vector<double> &other_mins,
+    const std::vector<double> &other_maxes, double min, double max,
+    double other_min, double other_max, std::vector<uint32_t> *found) const {
+  // no box that starts before min - max_width reaches min
+  auto first = std::lower_bound(order.begin(), order.end(), min - max_width,
+    [&](uint32_t slot, double value) { return mins[slot] < value; });
+  for (auto it = first; it != order.end() && mins[*it] <= max; ++it) {
+    if (maxes[*it] >= min && other_mins[*it] <= other_max &&
+        other_maxes[*it] >= other_min) {
+      found->push_back(*it);
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
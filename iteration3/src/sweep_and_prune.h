@@ -0,0 +1,165 @@
+/**
+ * @file sweep_and_prune.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_SWEEP_AND_PRUNE_H_
+#define SRC_SWEEP_AND_PRUNE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief How the StepEngine finds the pairs of entities that may collide.
+ */
+enum Broadphase {
+  // test every pair
+  kBruteForce,
+  // only test the pairs a SweepAndPrune finds overlapping
+  kSweepAndPrune
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief Finds the overlapping pairs of a set of axis-aligned boxes by
+ * sorting them along the x and y axes.
+ *
+ * The boxes are numbered by slot. The sorted lists are kept between calls to
+ * FindPairs() and re-sorted with insertion sort, which is close to linear
+ * when the boxes moved little since the last call, as entities do from one
+ * timestep to the next. Unlike a uniform grid, the cost does not depend on
+ * how many boxes pile up in one place, only on how many actually overlap.
+ */
+class SweepAndPrune {
+ public:
+  typedef std::pair<uint32_t, uint32_t> slot_pair;
+
+  SweepAndPrune() {}
+
+  /**
+   * @brief Set the # of boxes. If it changes, the sorted lists start over
+   * from slot order.
+   */
+  void Resize(size_t n_slots);
+
+  size_t get_size() const { return min_x_.size(); }
+
+  void set_box(size_t slot, double min_x, double min_y, double max_x,
+      double max_y) {
+    min_x_[slot] = min_x;
+    min_y_[slot] = min_y;
+    max_x_[slot] = max_x;
+    max_y_[slot] = max_y;
+  }
+
+  /**
+   * @brief Re-sort the boxes along both axes, after they were set.
+   */
+  void Sort();
+
+  /**
+   * @brief Set the box of slot after a Sort() and move it to its place in
+   * the sorted lists, for boxes that move a little between queries.
+   */
+  void MoveBox(size_t slot, double min_x, double min_y, double max_x,
+    double max_y);
+
+  /**
+   * @brief Sort() and find every pair of boxes that overlaps (touching
+   * counts). The pairs are swept along the axis the boxes are more spread
+   * out on.
+   *
+   * @param[out] pairs Replaced by the overlapping pairs, each with the lower
+   * slot first, in no particular order.
+   */
+  void FindPairs(std::vector<slot_pair> *pairs);
+
+  /**
+   * @brief Every box that overlaps the given box, as of the last Sort().
+   *
+   * @param[out] found The slots of the boxes are appended here.
+   */
+  void QueryBox(double min_x, double min_y, double max_x, double max_y,
+    std::vector<uint32_t> *found) const;
+
+  /**
+   * @brief # of swaps the insertion sorts of the last Sort() made; low
+   * when the boxes kept their order.
+   */
+  size_t get_swaps() const { return swaps_; }
+
+ private:
+  /**
+   * @brief Insertion sort order by mins, counting the swaps.
+   */
+  void SortAxis(const std::vector<double> &mins,
+    std::vector<uint32_t> *order);
+
+  /**
+   * @brief Move slot, whose min changed, to its place in order and fix the
+   * ranks of the slots it passes.
+   */
+  static void Reinsert(size_t slot, const std::vector<double> &mins,
+    std::vector<uint32_t> *order, std::vector<uint32_t> *ranks);
+
+  /**
+   * @brief About how many boxes QueryAxis() looks at.
+   */
+  static size_t CountAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, double max_width, double min,
+    double max);
+
+  /**
+   * @brief The boxes in order, sorted by mins, that overlap [min, max] on
+   * that axis and [other_min, other_max] on the other.
+   */
+  void QueryAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, const std::vector<double> &maxes,
+    double max_width, const std::vector<double> &other_mins,
+    const std::vector<double> &other_maxes, double min, double max,
+    double other_min, double other_max, std::vector<uint32_t> *found) const;
+
+  void SweepAxis(const std::vector<uint32_t> &order,
+    const std::vector<double> &mins, const std::vector<double> &maxes,
+    const std::vector<double> &other_mins,
+    const std::vector<double> &other_maxes,
+    std::vector<slot_pair> *pairs) const;
+
+  std::vector<double> min_x_{};
+  std::vector<double> min_y_{};
+  std::vector<double> max_x_{};
+  std::vector<double> max_y_{};
+  // slots by min_x_ and by min_y_, kept between calls
+  std::vector<uint32_t> order_x_{};
+  std::vector<uint32_t> order_y_{};
+  // where each slot is in order_x_ and order_y_, as of Sort()
+  std::vector<uint32_t> rank_x_{};
+  std::vector<uint32_t> rank_y_{};
+  // the widest box along each axis, and whether x is swept, as of Sort()
+  double max_width_x_{0};
+  double max_width_y_{0};
+  bool sweep_x_{true};
+  size_t swaps_{0};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEEP_AND_PRUNE_H_
@@ -0,0 +1,122 @@
+/**
+ * @file swept_collision.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/swept_collision.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+double SweptCircleTimeOfImpact(const Pose &start_a, const Pose &end_a,
+    const Pose &start_b, const Pose &end_b, double distance) {
+  // Work in the frame of circle a: b starts at d and moves by v.
+  double dx = start_b.x - start_a.x;
+  double dy = start_b.y - start_a.y;
+  double vx = (end_b.x - start_b.x) - (end_a.x - start_a.x);
+  double vy = (end_b.y - start_b.y) - (end_a.y - start_a.y);
+
+  // Solve |d + t * v| = distance for the smaller root
+  double a = vx * vx + vy * vy;
+  double b = 2 * (dx * vx + dy * vy);
+  double c = dx * dx + dy * dy - distance * distance;
+  if (c <= 0 || a <= 0 || b >= 0) {
+    return -1;  // already touching, not moving, or moving apart
+  }
+  double discriminant = b * b - 4 * a * c;
+  if (discriminant < 0) {
+    return -1;  // closest approach is still too far
+  }
+  double t = (-b - sqrt(discriminant)) / (2 * a);
+  return (t <= 1) ? t : -1;
+}
+
+double SweptCircleSegmentTimeOfImpact(const Pose &start, const Pose &end,
+    double x0, double y0, double x1, double y1, double distance) {
+  Pose closest = ClosestPointOnSegment(start.x, start.y, x0, y0, x1, y1);
+  double cx = start.x - closest.x;
+  double cy = start.y - closest.y;
+  if (cx * cx + cy * cy <= distance * distance) {
+    return -1;  // already touching
+  }
+
+  // the circle first touches either an end of the segment or its side
+  Pose end0(x0, y0);
+  Pose end1(x1, y1);
+  double first = SweptCircleTimeOfImpact(start, end, end0, end0, distance);
+  double t1 = SweptCircleTimeOfImpact(start, end, end1, end1, distance);
+  if (t1 >= 0 && (first < 0 || t1 < first)) {
+    first = t1;
+  }
+
+  double ux = x1 - x0;
+  double uy = y1 - y0;
+  double length = sqrt(ux * ux + uy * uy);
+  if (length > 0) {
+    // signed distance from the line, and its change over the step
+    double nx = -uy / length;
+    double ny = ux / length;
+    double side = (start.x - x0) * nx + (start.y - y0) * ny;
+    double change = (end.x - start.x) * nx + (end.y - start.y) * ny;
+    double target = side > 0 ? distance : -distance;
+    if (std::fabs(side) > distance && change * side < 0) {
+      double t = (target - side) / change;
+      // the side is only touched between the ends
+      double along = ((start.x + (end.x - start.x) * t - x0) * ux +
+        (start.y + (end.y - start.y) * t - y0) * uy) / (length * length);
+      if (t <= 1 && along >= 0 && along <= 1 && (first < 0 || t < first)) {
+        first = t;
+      }
+    }
+  }
+  return first;
+}
+
+Pose ClosestPointOnSegment(double x, double y, double x0, double y0,
+    double x1, double y1) {
+  double ux = x1 - x0;
+  double uy = y1 - y0;
+  double length_squared = ux * ux + uy * uy;
+  double along = length_squared > 0 ?
+    ((x - x0) * ux + (y - y0) * uy) / length_squared : 0;
+  along = std::min(std::max(along, 0.0), 1.0);
+  return Pose(x0 + ux * along, y0 + uy * along);
+}
+
+double SweptLimitTimeOfImpact(double start, double end, double limit,
+    bool increasing) {
+  if (increasing) {
+    if (end < limit) {
+      return -1;
+    } else if (start >= limit) {
+      return 0;
+    }
+  } else {
+    if (end > limit) {
+      return -1;
+    } else if (start <= limit) {
+      return 0;
+    }
+  }
+  return (limit - start) / (end - start);
+}
+
+Pose InterpolatePosition(const Pose &start, const Pose &end, double t) {
+  return Pose(start.x + (end.x - start.x) * t,
+              start.y + (end.y - start.y) * t,
+              end.theta);
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,92 @@
+/**
+ * @file swept_collision.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_SWEPT_COLLISION_H_
+#define SRC_SWEPT_COLLISION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "src/common.h"
+#include "src/pose.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/*
+ * Continuous collision detection for circles that move in a straight line
+ * from a start to an end position during one timestep. Times of impact are
+ * fractions of the step: 0 is the start position, 1 the end position. A
+ * negative time of impact means there is no contact during the step.
+ */
+
+/**
+ * @brief Earliest time at which two moving circles come within distance of
+ * each other (center to center).
+ *
+ * Circles that are already within distance at the start of the step are not
+ * reported, since they are separating or stuck and the discrete overlap
+ * check handles them.
+ *
+ * @param start_a Position of the first circle at the start of the step.
+ * @param end_a Position of the first circle at the end of the step.
+ * @param start_b Position of the second circle at the start of the step.
+ * @param end_b Position of the second circle at the end of the step.
+ * @param distance Center distance at which the circles touch.
+ *
+ * @return The time of impact in [0, 1], or -1 if there is none.
+ */
+double SweptCircleTimeOfImpact(const Pose &start_a, const Pose &end_a,
+    const Pose &start_b, const Pose &end_b, double distance);
+
+/**
+ * @brief Earliest time at which a circle moving from start to end comes
+ * within distance (of its center) of the segment from (x0, y0) to (x1, y1).
+ *
+ * As with SweptCircleTimeOfImpact(), a circle already within distance at
+ * the start of the step is not reported.
+ *
+ * @return The time of impact in [0, 1], or -1 if there is none.
+ */
+double SweptCircleSegmentTimeOfImpact(const Pose &start, const Pose &end,
+    double x0, double y0, double x1, double y1, double distance);
+
+/**
+ * @brief The point of the segment from (x0, y0) to (x1, y1) closest to
+ * (x, y).
+ */
+Pose ClosestPointOnSegment(double x, double y, double x0, double y0,
+    double x1, double y1);
+
+/**
+ * @brief Earliest time at which a coordinate moving from start to end
+ * reaches limit.
+ *
+ * @param start Coordinate at the start of the step.
+ * @param end Coordinate at the end of the step.
+ * @param limit The coordinate that must not be reached.
+ * @param increasing true if the limit is reached from below (e.g. the right
+ * wall), false if it is reached from above (e.g. the left wall).
+ *
+ * @return The time of impact in [0, 1], or -1 if there is none.
+ */
+double SweptLimitTimeOfImpact(double start, double end, double limit,
+    bool increasing);
+
+/**
+ * @brief The position a fraction t of the way from start to end. The heading
+ * of end is kept.
+ */
+Pose InterpolatePosition(const Pose &start, const Pose &end, double t);
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_SWEPT_COLLISION_H_
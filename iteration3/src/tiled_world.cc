@@ -0,0 +1,189 @@
+/**
+ * @file tiled_world.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+
+#include "src/tiled_world.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TiledWorld::TiledWorld(const world_params &params)
+    : columns_(std::max(params.columns, 1u)),
+      rows_(std::max(params.rows, 1u)),
+      tile_x_dim_(params.tile.x_dim),
+      tile_y_dim_(params.tile.y_dim),
+      halo_(params.halo),
+      pool_(params.n_threads) {
+  arena_params tile_params = params.tile;
+  for (unsigned int row = 0; row < rows_; ++row) {
+    for (unsigned int column = 0; column < columns_; ++column) {
+      if (params.tile.seed != 0) {
+        tile_params.seed = params.tile.seed +
+          static_cast<unsigned int>(tiles_.size());
+      }
+      Arena *tile = new Arena(&tile_params);
+      // only the outside of the world has walls
+      tile->set_wall_enabled(kLeftWall, column == 0);
+      tile->set_wall_enabled(kRightWall, column == columns_ - 1);
+      tile->set_wall_enabled(kTopWall, row == 0);
+      tile->set_wall_enabled(kBottomWall, row == rows_ - 1);
+      tiles_.emplace_back(tile);
+    }
+  }
+  lod_reports_.resize(tiles_.size());
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void TiledWorld::AdvanceTime(double dt) {
+  ExchangeHalos();
+  // entities move too little between coarse updates to leave the margins
+  // of the view and interactions, so the levels of detail are only chosen
+  // again once per coarse update
+  bool apply_lod = lod_ != nullptr &&
+    step_count_ % std::max(lod_->get_params().coarse_interval, 1u) == 0;
+  pool_.ParallelFor(tiles_.size(), [this, dt, apply_lod](size_t i) {
+    if (apply_lod) {
+      lod_reports_[i] = lod_->Apply(tiles_[i].get(), dt, get_tile_origin(i));
+    }
+    tiles_[i]->AdvanceTime(dt);
+  });
+  Migrate();
+  ++step_count_;
+}
+
+void TiledWorld::ExchangeHalos() {
+  // each tile only writes its own ghosts and reads its neighbors' entities
+  pool_.ParallelFor(tiles_.size(), [this](size_t i) {
+    tiles_[i]->ClearGhosts();
+    int column = static_cast<int>(i % columns_);
+    int row = static_cast<int>(i / columns_);
+    for (int r = std::max(row - 1, 0);
+        r <= std::min(row + 1, static_cast<int>(rows_) - 1); ++r) {
+      for (int c = std::max(column - 1, 0);
+          c <= std::min(column + 1, static_cast<int>(columns_) - 1); ++c) {
+        if (r != row || c != column) {
+          CopyGhosts(c, r, i);
+        }
+      }
+    }
+  });
+}
+
+void TiledWorld::CopyGhosts(unsigned int column, unsigned int row,
+    size_t into) {
+  Arena *from = get_tile(column, row);
+  Arena *to = tiles_[into].get();
+  // the offset from the neighbor's coordinates to the tile's
+  Pose from_origin = get_tile_origin(column, row);
+  Pose to_origin = get_tile_origin(into);
+  double dx = from_origin.x - to_origin.x;
+  double dy = from_origin.y - to_origin.y;
+
+  auto copy = [&](const ArenaEntity *ent) {
+    Pose pose = ent->get_pose();
+    pose.x += dx;
+    pose.y += dy;
+    if (pose.x >= -halo_ && pose.x <= tile_x_dim_ + halo_ &&
+        pose.y >= -halo_ && pose.y <= tile_y_dim_ + halo_) {
+      to->AddGhost(ent->get_type(), pose, ent->get_radius());
+    }
+  };
+  for (auto robot : from->get_robots()) {
+    copy(robot);
+  }
+  for (auto light : from->get_lights()) {
+    copy(light);
+  }
+  for (auto food : from->get_foods()) {
+    copy(food);
+  }
+}
+
+void TiledWorld::Migrate() {
+  for (size_t i = 0; i < tiles_.size(); ++i) {
+    Arena *tile = tiles_[i].get();
+    // copies, since releasing an entity changes the tile's vectors
+    std::vector<Robot *> robots = tile->get_robots();
+    std::vector<Light *> lights = tile->get_lights();
+    for (auto robot : robots) {
+      size_t to = MoveToTile(i, robot);
+      if (to != i) {
+        tile->ReleaseRobot(robot);
+        tiles_[to]->RegisterRobot(robot);
+      }
+    }
+    for (auto light : lights) {
+      size_t to = MoveToTile(i, light);
+      if (to != i) {
+        tile->ReleaseLight(light);
+        tiles_[to]->RegisterLight(light);
+      }
+    }
+  }
+}
+
+size_t TiledWorld::MoveToTile(size_t from, ArenaMobileEntity *ent) {
+  Pose origin = get_tile_origin(from);
+  size_t to = TileAt(origin.x + ent->get_pose().x,
+    origin.y + ent->get_pose().y);
+  if (to != from) {
+    Pose to_origin = get_tile_origin(to);
+    ent->set_position(ent->get_pose().x + origin.x - to_origin.x,
+      ent->get_pose().y + origin.y - to_origin.y);
+    ++migration_count_;
+  }
+  return to;
+}
+
+size_t TiledWorld::TileAt(double x, double y) const {
+  int column = static_cast<int>(std::floor(x / tile_x_dim_));
+  int row = static_cast<int>(std::floor(y / tile_y_dim_));
+  column = std::min(std::max(column, 0), static_cast<int>(columns_) - 1);
+  row = std::min(std::max(row, 0), static_cast<int>(rows_) - 1);
+  return static_cast<size_t>(row) * columns_ + static_cast<size_t>(column);
+}
+
+size_t TiledWorld::get_mobile_count() const {
+  size_t count = 0;
+  for (auto &tile : tiles_) {
+    count += tile->get_robots().size() + tile->get_lights().size();
+  }
+  return count;
+}
+
+lod_report TiledWorld::get_lod_report() const {
+  lod_report total;
+  for (auto &report : lod_reports_) {
+    total.fine_entities += report.fine_entities;
+    total.coarse_entities += report.coarse_entities;
+    total.divergence_bound = std::max(total.divergence_bound,
+      report.divergence_bound);
+  }
+  return total;
+}
+
+int TiledWorld::get_game_status() const {
+  for (auto &tile : tiles_) {
+    if (tile->get_game_status() == LOST) {
+      return LOST;
+    }
+  }
+  return PLAYING;
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,179 @@
+/**
+ * @file tiled_world.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_TILED_WORLD_H_
+#define SRC_TILED_WORLD_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <memory>
+#include <vector>
+
+#include "src/arena.h"
+#include "src/arena_params.h"
+#include "src/common.h"
+#include "src/lod_scheduler.h"
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Parameters of a TiledWorld.
+ */
+struct world_params {
+  // # of tiles across and down
+  unsigned int columns{4};
+  unsigned int rows{4};
+  // the size of each tile and the entities created in it. Tiles with a
+  // non-zero seed are seeded with seed + their index.
+  arena_params tile{};
+  // entities this close to a tile are copied into it as ghosts
+  double halo{100};
+  // # of threads stepping tiles, 0 for one per core
+  unsigned int n_threads{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A world larger than one Arena, split into a grid of tiles that are
+ * stepped in parallel.
+ *
+ * Each tile is an Arena with its own coordinates, from (0, 0) to its x_dim
+ * and y_dim, and steps with the usual Arena semantics. Only the walls on the
+ * outside of the world are on, so entities can cross from one tile into the
+ * next. Each step:
+ *
+ * 1. Halo exchange: the entities within `halo` of a tile's border in the
+ *    neighboring tiles are copied into it as ghosts, so its entities sense
+ *    them, do not overlap them and can eat ghost food.
+ * 2. The tiles are stepped in parallel on a WorkerPool, after the
+ *    LodScheduler (if any) chooses the level of detail of their entities. A
+ *    tile only changes its own entities and ghosts, so no locking is needed.
+ * 3. Migration: entities that ended the step outside their tile are moved
+ *    to the tile they are in, keeping their hunger state.
+ *
+ * Sensing is limited to the halo across borders: a robot does not sense
+ * lights or food further than `halo` into a neighboring tile.
+ */
+class TiledWorld {
+ public:
+  explicit TiledWorld(const world_params &params);
+
+  TiledWorld(const TiledWorld &other) = delete;
+  TiledWorld &operator=(const TiledWorld &other) = delete;
+
+  /**
+   * @brief Exchange halos, advance every tile by dt and migrate the entities
+   * that left their tile.
+   */
+  void AdvanceTime(double dt);
+
+  /**
+   * @brief Choose the level of detail of every tile's entities with lod, in
+   * world coordinates, before every coarse_interval-th step. nullptr (the
+   * default) updates every entity every step.
+   */
+  void set_lod_scheduler(const LodScheduler *lod) { lod_ = lod; }
+
+  /**
+   * @brief What the LodScheduler did to all the tiles the last time.
+   */
+  lod_report get_lod_report() const;
+
+  /**
+   * @brief The tile in the given column and row.
+   */
+  Arena *get_tile(unsigned int column, unsigned int row) {
+    return tiles_[row * columns_ + column].get(); }
+  Arena *get_tile(size_t index) { return tiles_[index].get(); }
+
+  size_t get_tile_count() const { return tiles_.size(); }
+
+  /**
+   * @brief The position of a tile's (0, 0) in world coordinates.
+   */
+  Pose get_tile_origin(unsigned int column, unsigned int row) const {
+    return {column * tile_x_dim_, row * tile_y_dim_}; }
+  Pose get_tile_origin(size_t index) const {
+    return get_tile_origin(static_cast<unsigned int>(index % columns_),
+      static_cast<unsigned int>(index / columns_)); }
+
+  double get_x_dim() const { return columns_ * tile_x_dim_; }
+  double get_y_dim() const { return rows_ * tile_y_dim_; }
+
+  /**
+   * @brief # of robots and lights in all tiles.
+   */
+  size_t get_mobile_count() const;
+
+  /**
+   * @brief # of entities moved to another tile so far.
+   */
+  size_t get_migration_count() const { return migration_count_; }
+
+  /**
+   * @brief LOST once a robot in any tile has starved, PLAYING until then.
+   */
+  int get_game_status() const;
+
+ private:
+  /**
+   * @brief Replace each tile's ghosts with copies of the entities near it in
+   * the neighboring tiles.
+   */
+  void ExchangeHalos();
+
+  /**
+   * @brief Copy the entities of the tile at (column, row) near the tile at
+   * index `into` into that tile as ghosts.
+   */
+  void CopyGhosts(unsigned int column, unsigned int row, size_t into);
+
+  /**
+   * @brief Move every robot and light outside its tile to the tile it is in.
+   */
+  void Migrate();
+
+  /**
+   * @brief If ent, an entity of the tile at index `from`, is outside that
+   * tile, change its pose to the coordinates of the tile it is in.
+   *
+   * @return The index of the tile ent is in.
+   */
+  size_t MoveToTile(size_t from, ArenaMobileEntity *ent);
+
+  /**
+   * @brief The index of the tile containing the world position (x, y). A
+   * position outside the world belongs to the nearest tile.
+   */
+  size_t TileAt(double x, double y) const;
+
+  unsigned int columns_;
+  unsigned int rows_;
+  double tile_x_dim_;
+  double tile_y_dim_;
+  double halo_;
+  std::vector<std::unique_ptr<Arena>> tiles_{};
+  WorkerPool pool_;
+  size_t migration_count_{0};
+  const LodScheduler *lod_{nullptr};
+  size_t step_count_{0};
+  // each tile's report from the last step
+  std::vector<lod_report> lod_reports_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TILED_WORLD_H_
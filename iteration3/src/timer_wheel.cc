@@ -0,0 +1,120 @@
+/**
+ * @file timer_wheel.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <utility>
+
+#include "src/timer_wheel.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+TimerWheel::TimerWheel() : slots_() {}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+TimerWheel::TimerId TimerWheel::Schedule(uint64_t delay, Callback callback) {
+  if (delay == 0) {
+    delay = 1;  // the current tick has already been processed
+  }
+  TimerId id = next_id_++;
+  uint64_t expiry = current_tick_ + delay;
+  timers_.emplace(id, Timer{expiry, std::move(callback)});
+  Insert(id, expiry);
+  return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+  // The slot still holds the id, but it is skipped once it is not in timers_
+  return timers_.erase(id) > 0;
+}
+
+void TimerWheel::Advance(uint64_t ticks) {
+  for (uint64_t i = 0; i < ticks; ++i) {
+    Tick();
+  }
+}
+
+void TimerWheel::Clear() {
+  for (auto &level : slots_) {
+    for (auto &slot : level) {
+      slot.clear();
+    }
+  }
+  overflow_.clear();
+  timers_.clear();
+  current_tick_ = 0;
+}
+
+void TimerWheel::Tick() {
+  ++current_tick_;
+
+  // Cascade from the top down, so that timers dropping out of a high level
+  // can keep falling through the levels that wrap on this same tick.
+  for (int level = kLevels - 1; level > 0; --level) {
+    uint64_t span_mask = (uint64_t(1) << (kSlotBits * level)) - 1;
+    if ((current_tick_ & span_mask) == 0) {
+      Cascade(level, (current_tick_ >> (kSlotBits * level)) & kSlotMask);
+    }
+  }
+  uint64_t top_mask = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+  if ((current_tick_ & top_mask) == 0 && !overflow_.empty()) {
+    std::vector<TimerId> parked;
+    parked.swap(overflow_);
+    for (TimerId id : parked) {
+      auto timer = timers_.find(id);
+      if (timer != timers_.end()) {
+        Insert(id, timer->second.expiry);
+      }
+    }
+  }
+
+  // Fire everything due now. Callbacks may schedule new timers, which never
+  // land in the slot being processed since their delay is at least 1.
+  std::vector<TimerId> due;
+  due.swap(slots_[0][current_tick_ & kSlotMask]);
+  for (TimerId id : due) {
+    auto timer = timers_.find(id);
+    if (timer == timers_.end()) {
+      continue;  // cancelled
+    }
+    Callback callback = std::move(timer->second.callback);
+    timers_.erase(timer);
+    callback();
+  }
+}
+
+void TimerWheel::Insert(TimerId id, uint64_t expiry) {
+  uint64_t delta = expiry - current_tick_;
+  for (int level = 0; level < kLevels; ++level) {
+    if (delta < (uint64_t(1) << (kSlotBits * (level + 1)))) {
+      slots_[level][(expiry >> (kSlotBits * level)) & kSlotMask].push_back(id);
+      return;
+    }
+  }
+  overflow_.push_back(id);
+}
+
+void TimerWheel::Cascade(int level, uint64_t slot) {
+  std::vector<TimerId> moving;
+  moving.swap(slots_[level][slot]);
+  for (TimerId id : moving) {
+    auto timer = timers_.find(id);
+    if (timer != timers_.end()) {
+      Insert(id, timer->second.expiry);
+    }
+  }
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,127 @@
+/**
+ * @file timer_wheel.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A hierarchical timer wheel for scheduling events some number of
+ * timesteps into the future.
+ *
+ * The wheel has 4 levels of 64 slots. Level 0 has a resolution of 1 tick,
+ * level 1 a resolution of 64 ticks, and so on. A timer is placed in the
+ * lowest level that can hold its delay and is moved down (cascaded) a level
+ * when the level below wraps around, so each timer is touched only a handful
+ * of times no matter how far in the future it fires. Timers further away
+ * than the wheel can hold are parked and re-examined when the top level wraps.
+ *
+ * Arena advances the wheel once per timestep. Entities schedule their own
+ * timed state changes (e.g. a Robot's hunger transitions) instead of
+ * counting and checking every step.
+ */
+class TimerWheel {
+ public:
+  /**
+   * @brief Function run when a timer fires.
+   */
+  typedef std::function<void()> Callback;
+
+  /**
+   * @brief Handle used to cancel a timer. 0 is never a valid handle.
+   */
+  typedef uint64_t TimerId;
+
+  TimerWheel();
+
+  /**
+   * @brief Schedule callback to run delay ticks from now.
+   *
+   * @param delay # of ticks until the timer fires. A delay of 0 fires on
+   * the next tick.
+   * @param callback The function to run.
+   *
+   * @return A handle that can be passed to Cancel().
+   */
+  TimerId Schedule(uint64_t delay, Callback callback);
+
+  /**
+   * @brief Cancel a pending timer.
+   *
+   * @return true if the timer was still pending.
+   */
+  bool Cancel(TimerId id);
+
+  /**
+   * @brief Advance the wheel by the given # of ticks, running every timer
+   * that comes due along the way, in order of expiry.
+   */
+  void Advance(uint64_t ticks);
+
+  /**
+   * @brief Cancel every pending timer and rewind the clock to 0.
+   */
+  void Clear();
+
+  uint64_t get_current_tick() const { return current_tick_; }
+
+  size_t get_pending_count() const { return timers_.size(); }
+
+ private:
+  static const int kLevels = 4;
+  static const int kSlotBits = 6;
+  static const uint64_t kSlots = 1 << kSlotBits;
+  static const uint64_t kSlotMask = kSlots - 1;
+
+  struct Timer {
+    uint64_t expiry{0};
+    Callback callback{};
+  };
+
+  /**
+   * @brief Advance exactly one tick.
+   */
+  void Tick();
+
+  /**
+   * @brief Place a timer in the slot matching its expiry.
+   */
+  void Insert(TimerId id, uint64_t expiry);
+
+  /**
+   * @brief Re-insert every timer of a slot so it drops to a lower level.
+   */
+  void Cascade(int level, uint64_t slot);
+
+  std::vector<TimerId> slots_[kLevels][kSlots];
+  // timers too far in the future for the top level
+  std::vector<TimerId> overflow_{};
+  // cancelled timers are only removed from here; their slot entry is skipped
+  std::unordered_map<TimerId, Timer> timers_{};
+  uint64_t current_tick_{0};
+  TimerId next_id_{1};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_TIMER_WHEEL_H_
@@ -0,0 +1,159 @@
+/**
+ * @file vehicle_kernel.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_VEHICLE_KERNEL_H_
+#define SRC_VEHICLE_KERNEL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <cmath>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Pose with a chosen precision, for the kernels below. Pose is the
+ * double precision pose of the entities.
+ */
+template <typename Scalar>
+struct BasicPose {
+  Scalar x{0};
+  Scalar y{0};
+  // degrees
+  Scalar theta{0};
+};
+
+/**
+ * @brief WheelVelocity with a chosen precision.
+ */
+template <typename Scalar>
+struct BasicWheelVelocity {
+  Scalar left{0};
+  Scalar right{0};
+};
+
+/**
+ * @brief A stretch of motion with constant wheel velocities: a straight line
+ * or a circular arc from start. See BeginSegment() and SegmentPose().
+ */
+template <typename Scalar>
+struct MotionSegment {
+  BasicPose<Scalar> start{};
+  BasicWheelVelocity<Scalar> vel{};
+  // of the heading at start, so that points on the segment need no trig
+  // for straight lines
+  Scalar cos_heading{1};
+  Scalar sin_heading{0};
+};
+
+/*******************************************************************************
+ * Non-Member Functions
+ ******************************************************************************/
+/**
+ * @brief Where a differential drive with the wheel velocities vel moves
+ * pose to in dt. This is the motion of MotionBehaviorDifferential, which
+ * uses it with Scalar = double.
+ *
+ * The drive is modelled with a wheel base of 0.5 regardless of the radius of
+ * the entity, as the arena always has.
+ */
+template <typename Scalar>
+BasicPose<Scalar> DifferentialDrive(const BasicPose<Scalar> &pose,
+    const BasicWheelVelocity<Scalar> &vel, Scalar dt) {
+  const Scalar to_radians = static_cast<Scalar>(M_PI);
+  BasicPose<Scalar> moved;
+  if (std::fabs(vel.left - vel.right) > 0) {
+    // rotate about the instantaneous center of curvature
+    Scalar omega = (vel.left - vel.right) / static_cast<Scalar>(0.5);
+    Scalar icc_radius = static_cast<Scalar>(0.25) * (vel.left + vel.right) /
+      (vel.left - vel.right);
+    Scalar heading = pose.theta * to_radians / static_cast<Scalar>(180.0);
+    Scalar icc_x = pose.x - icc_radius * std::sin(heading);
+    Scalar icc_y = pose.y + icc_radius * std::cos(heading);
+    Scalar cos_turn = std::cos(omega * dt);
+    Scalar sin_turn = std::sin(omega * dt);
+    moved.x = (pose.x - icc_x) * cos_turn + (pose.y - icc_y) * -sin_turn +
+      icc_x;
+    moved.y = (pose.x - icc_x) * sin_turn + (pose.y - icc_y) * cos_turn +
+      icc_y;
+    moved.theta = pose.theta + omega * dt;
+  } else {
+    // drive straight along the heading
+    Scalar heading = pose.theta * to_radians / static_cast<Scalar>(180.0);
+    moved.x = pose.x + std::cos(heading) * vel.left * dt;
+    moved.y = pose.y + std::sin(heading) * vel.left * dt;
+    moved.theta = pose.theta;
+  }
+  return moved;
+}
+
+/**
+ * @brief The segment driven from start with the wheel velocities vel.
+ */
+template <typename Scalar>
+MotionSegment<Scalar> BeginSegment(const BasicPose<Scalar> &start,
+    const BasicWheelVelocity<Scalar> &vel) {
+  const Scalar to_radians = static_cast<Scalar>(M_PI);
+  Scalar heading = start.theta * to_radians / static_cast<Scalar>(180.0);
+  MotionSegment<Scalar> segment;
+  segment.start = start;
+  segment.vel = vel;
+  segment.cos_heading = std::cos(heading);
+  segment.sin_heading = std::sin(heading);
+  return segment;
+}
+
+/**
+ * @brief Where segment has got to after time t, in closed form. This is
+ * DifferentialDrive(segment.start, segment.vel, t), to the bit.
+ */
+template <typename Scalar>
+BasicPose<Scalar> SegmentPose(const MotionSegment<Scalar> &segment,
+    Scalar t) {
+  const BasicPose<Scalar> &pose = segment.start;
+  const BasicWheelVelocity<Scalar> &vel = segment.vel;
+  BasicPose<Scalar> moved;
+  if (std::fabs(vel.left - vel.right) > 0) {
+    Scalar omega = (vel.left - vel.right) / static_cast<Scalar>(0.5);
+    Scalar icc_radius = static_cast<Scalar>(0.25) * (vel.left + vel.right) /
+      (vel.left - vel.right);
+    Scalar icc_x = pose.x - icc_radius * segment.sin_heading;
+    Scalar icc_y = pose.y + icc_radius * segment.cos_heading;
+    Scalar cos_turn = std::cos(omega * t);
+    Scalar sin_turn = std::sin(omega * t);
+    moved.x = (pose.x - icc_x) * cos_turn + (pose.y - icc_y) * -sin_turn +
+      icc_x;
+    moved.y = (pose.x - icc_x) * sin_turn + (pose.y - icc_y) * cos_turn +
+      icc_y;
+    moved.theta = pose.theta + omega * t;
+  } else {
+    moved.x = pose.x + segment.cos_heading * vel.left * t;
+    moved.y = pose.y + segment.sin_heading * vel.left * t;
+    moved.theta = pose.theta;
+  }
+  return moved;
+}
+
+/**
+ * @brief The reading a light or food sensor gets from one emitter at the
+ * given distance: numerator / distance^base.
+ */
+template <typename Scalar>
+Scalar SensorResponse(Scalar numerator, Scalar distance, Scalar base) {
+  return numerator / std::pow(distance, base);
+}
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_VEHICLE_KERNEL_H_
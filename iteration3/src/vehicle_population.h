@@ -0,0 +1,355 @@
+/**
+ * @file vehicle_population.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_VEHICLE_POPULATION_H_
+#define SRC_VEHICLE_POPULATION_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "src/common.h"
+#include "src/params.h"
+#include "src/sensor_falloff.h"
+#include "src/vehicle_kernel.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Structure Definitions
+ ******************************************************************************/
+/**
+ * @brief Parameters of a VehiclePopulation.
+ */
+struct population_params {
+  size_t n_vehicles{4096};
+  size_t n_lights{16};
+  double x_dim{4000};
+  double y_dim{4000};
+  unsigned int seed{1};
+  // count the other vehicles within this range of each vehicle every step;
+  // 0 turns the neighbor query off
+  double neighbor_range{0};
+  // reorder the vehicles along a Morton curve every this many steps; 0
+  // keeps them in creation order
+  unsigned int sort_interval{0};
+};
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A large population of light sensing vehicles stepped with the
+ * arena's kernels at a chosen precision, for headless runs where the
+ * precision of double is not needed.
+ *
+ * The state is kept as one array per component, so a step streams through
+ * memory; with Scalar = float it moves half the bytes. The model is the
+ * light seeking part of the arena: each vehicle has two light sensors
+ * (with the arena's PowerFalloff unless another Falloff is chosen),
+ * drives its wheels from them directly (fear) or crossed (aggressive),
+ * limited to ROBOT_MAX_SPEED, and moves with
+ * DifferentialDrive(). The lights are fixed, and the world wraps around
+ * instead of having walls, so there are no collisions. With a
+ * neighbor_range, each step also counts the other vehicles within it of
+ * each vehicle (get_neighbor_count()), through a grid rebuilt every step;
+ * the counts do not change how the vehicles move.
+ *
+ * Vehicles are identified by the id they were created with. With a
+ * sort_interval, the arrays are reordered along a Z-order (Morton) curve of
+ * the positions, so that vehicles near each other in the world are near
+ * each other in memory and the neighbor query reads contiguous memory.
+ * get_index() maps an id to the vehicle's current index. The order never
+ * changes the result of a step.
+ *
+ * @tparam Scalar float or double.
+ * @tparam Falloff The sensor response (see sensor_falloff.h).
+ */
+template <typename Scalar, typename Falloff = PowerFalloff<Scalar>>
+class VehiclePopulation {
+ public:
+  /**
+   * @brief Place the vehicles and lights at random. Populations with the
+   * same params start from the same state whatever their Scalar and
+   * Falloff, up to rounding.
+   */
+  explicit VehiclePopulation(const population_params &params,
+      const Falloff &falloff = Falloff())
+      : falloff_(falloff),
+        x_dim_(static_cast<Scalar>(params.x_dim)),
+        y_dim_(static_cast<Scalar>(params.y_dim)),
+        neighbor_range_(static_cast<Scalar>(params.neighbor_range)),
+        sort_interval_(params.sort_interval),
+        x_(params.n_vehicles), y_(params.n_vehicles),
+        theta_(params.n_vehicles), ids_(params.n_vehicles),
+        index_of_(params.n_vehicles), neighbor_counts_(params.n_vehicles),
+        light_x_(params.n_lights), light_y_(params.n_lights) {
+    for (uint32_t id = 0; id < ids_.size(); ++id) {
+      ids_[id] = id;
+      index_of_[id] = id;
+    }
+    if (params.neighbor_range > 0) {
+      columns_ = std::max(1, static_cast<int>(params.x_dim /
+        params.neighbor_range));
+      rows_ = std::max(1, static_cast<int>(params.y_dim /
+        params.neighbor_range));
+      cell_start_.resize(columns_ * rows_ + 1);
+      cell_members_.resize(params.n_vehicles);
+      cell_of_.resize(params.n_vehicles);
+    }
+    std::mt19937 random(params.seed);
+    std::uniform_real_distribution<double> unit(0, 1);
+    for (size_t i = 0; i < x_.size(); ++i) {
+      x_[i] = static_cast<Scalar>(unit(random) * params.x_dim);
+      y_[i] = static_cast<Scalar>(unit(random) * params.y_dim);
+      theta_[i] = static_cast<Scalar>(unit(random) * 360);
+    }
+    for (size_t i = 0; i < light_x_.size(); ++i) {
+      light_x_[i] = static_cast<Scalar>(unit(random) * params.x_dim);
+      light_y_[i] = static_cast<Scalar>(unit(random) * params.y_dim);
+    }
+  }
+
+  /**
+   * @brief Sense the lights and move every vehicle by dt.
+   */
+  void Step(Scalar dt) {
+    if (sort_interval_ > 0 && step_count_ % sort_interval_ == 0) {
+      SortMorton();
+    }
+    ++step_count_;
+    if (neighbor_range_ > 0) {
+      CountNeighbors();
+    }
+    const Scalar to_radians = static_cast<Scalar>(M_PI / 180.0);
+    const Scalar offset = static_cast<Scalar>(ANGLE_OFFSET);
+    const Scalar radius = static_cast<Scalar>(ROBOT_RADIUS);
+    const Scalar numerator = static_cast<Scalar>(1200);
+    const Scalar max_speed = static_cast<Scalar>(ROBOT_MAX_SPEED);
+    for (size_t i = 0; i < x_.size(); ++i) {
+      Scalar left_heading = (theta_[i] - offset) * to_radians;
+      Scalar right_heading = (theta_[i] + offset) * to_radians;
+      Scalar left_x = x_[i] + radius * std::cos(left_heading);
+      Scalar left_y = y_[i] + radius * std::sin(left_heading);
+      Scalar right_x = x_[i] + radius * std::cos(right_heading);
+      Scalar right_y = y_[i] + radius * std::sin(right_heading);
+      Scalar left = 0;
+      Scalar right = 0;
+      for (size_t j = 0; j < light_x_.size(); ++j) {
+        Scalar left_dx = light_x_[j] - left_x;
+        Scalar left_dy = light_y_[j] - left_y;
+        Scalar right_dx = light_x_[j] - right_x;
+        Scalar right_dy = light_y_[j] - right_y;
+        left += falloff_(numerator,
+          std::sqrt(left_dx * left_dx + left_dy * left_dy));
+        right += falloff_(numerator,
+          std::sqrt(right_dx * right_dx + right_dy * right_dy));
+      }
+      BasicWheelVelocity<Scalar> vel;
+      // even vehicles fear the light, odd ones are aggressive
+      bool fear = ids_[i] % 2 == 0;
+      vel.left = std::min(fear ? left : right, max_speed);
+      vel.right = std::min(fear ? right : left, max_speed);
+      BasicPose<Scalar> moved = DifferentialDrive<Scalar>(
+        {x_[i], y_[i], theta_[i]}, vel, dt);
+      x_[i] = Wrap(moved.x, x_dim_);
+      y_[i] = Wrap(moved.y, y_dim_);
+      theta_[i] = std::fmod(moved.theta, static_cast<Scalar>(360));
+    }
+  }
+
+  size_t get_size() const { return x_.size(); }
+
+  /**
+   * @brief The pose of the vehicle at index i.
+   */
+  BasicPose<Scalar> get_pose(size_t i) const {
+    return {x_[i], y_[i], theta_[i]}; }
+
+  /**
+   * @brief The position of light j.
+   */
+  BasicPose<Scalar> get_light(size_t j) const {
+    return {light_x_[j], light_y_[j], 0}; }
+
+  /**
+   * @brief The current index of the vehicle with the given id, and the id
+   * of the vehicle at index i.
+   */
+  size_t get_index(uint32_t id) const { return index_of_[id]; }
+  uint32_t get_id(size_t i) const { return ids_[i]; }
+
+  /**
+   * @brief The # of other vehicles within neighbor_range of the vehicle at
+   * index i in the last step.
+   */
+  unsigned int get_neighbor_count(size_t i) const {
+    return neighbor_counts_[i]; }
+
+  /**
+   * @brief The distance from (x0, y0) to (x1, y1) across the wrapped world.
+   */
+  double WrappedDistance(double x0, double y0, double x1, double y1) const {
+    double dx = std::fabs(x1 - x0);
+    double dy = std::fabs(y1 - y0);
+    dx = std::min<double>(dx, x_dim_ - dx);
+    dy = std::min<double>(dy, y_dim_ - dy);
+    return std::hypot(dx, dy);
+  }
+
+ private:
+  static Scalar Wrap(Scalar value, Scalar size) {
+    value = std::fmod(value, size);
+    return value < 0 ? value + size : value;
+  }
+
+  /**
+   * @brief Spread the low 16 bits of v over the even bits of the result.
+   */
+  static uint32_t SpreadBits(uint32_t v) {
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+  }
+
+  /**
+   * @brief Reorder the vehicles by the Morton code of their position on a
+   * 65536 x 65536 grid over the world, keeping the ids with them.
+   */
+  void SortMorton() {
+    size_t n = x_.size();
+    std::vector<std::pair<uint32_t, uint32_t>> order(n);
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t column = static_cast<uint32_t>(x_[i] / x_dim_ * 65535);
+      uint32_t row = static_cast<uint32_t>(y_[i] / y_dim_ * 65535);
+      order[i] = {SpreadBits(column) | (SpreadBits(row) << 1),
+        static_cast<uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end());
+    Permute(order, &x_);
+    Permute(order, &y_);
+    Permute(order, &theta_);
+    Permute(order, &ids_);
+    for (size_t i = 0; i < n; ++i) {
+      index_of_[ids_[i]] = static_cast<uint32_t>(i);
+    }
+  }
+
+  /**
+   * @brief Move values[order[i].second] to values[i].
+   */
+  template <typename T>
+  static void Permute(const std::vector<std::pair<uint32_t, uint32_t>> &order,
+      std::vector<T> *values) {
+    std::vector<T> permuted(values->size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      permuted[i] = (*values)[order[i].second];
+    }
+    values->swap(permuted);
+  }
+
+  int CellColumn(Scalar x) const {
+    return std::min(static_cast<int>(x / x_dim_ * columns_), columns_ - 1);
+  }
+
+  int CellRow(Scalar y) const {
+    return std::min(static_cast<int>(y / y_dim_ * rows_), rows_ - 1);
+  }
+
+  /**
+   * @brief Bucket the vehicles by grid cell (a counting sort, so each cell's
+   * members are in index order), then count the others within
+   * neighbor_range
+   * of each vehicle in its own and the 8 neighboring cells, which wrap
+   * around like the world.
+   */
+  void CountNeighbors() {
+    size_t n = x_.size();
+    std::fill(cell_start_.begin(), cell_start_.end(), 0);
+    for (size_t i = 0; i < n; ++i) {
+      cell_of_[i] = static_cast<uint32_t>(CellRow(y_[i]) * columns_ +
+        CellColumn(x_[i]));
+      ++cell_start_[cell_of_[i] + 1];
+    }
+    for (size_t c = 1; c < cell_start_.size(); ++c) {
+      cell_start_[c] += cell_start_[c - 1];
+    }
+    std::vector<uint32_t> next(cell_start_.begin(), cell_start_.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+      cell_members_[next[cell_of_[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    // with fewer than 3 cells across, visit each column (row) only once
+    int column_span = std::min(columns_, 3);
+    int row_span = std::min(rows_, 3);
+    Scalar range_squared = neighbor_range_ * neighbor_range_;
+    for (size_t i = 0; i < n; ++i) {
+      int column = static_cast<int>(cell_of_[i]) % columns_;
+      int row = static_cast<int>(cell_of_[i]) / columns_;
+      unsigned int count = 0;
+      for (int r = 0; r < row_span; ++r) {
+        int cell_row = (row + r - row_span / 2 + rows_) % rows_;
+        for (int c = 0; c < column_span; ++c) {
+          int cell_column = (column + c - column_span / 2 + columns_) %
+            columns_;
+          int cell = cell_row * columns_ + cell_column;
+          for (uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1];
+              ++k) {
+            uint32_t j = cell_members_[k];
+            Scalar dx = std::fabs(x_[j] - x_[i]);
+            Scalar dy = std::fabs(y_[j] - y_[i]);
+            dx = std::min(dx, x_dim_ - dx);
+            dy = std::min(dy, y_dim_ - dy);
+            if (j != i && dx * dx + dy * dy <= range_squared) {
+              ++count;
+            }
+          }
+        }
+      }
+      neighbor_counts_[i] = count;
+    }
+  }
+
+  Falloff falloff_;
+  Scalar x_dim_;
+  Scalar y_dim_;
+  Scalar neighbor_range_;
+  unsigned int sort_interval_;
+  unsigned int step_count_{0};
+  std::vector<Scalar> x_;
+  std::vector<Scalar> y_;
+  std::vector<Scalar> theta_;
+  // the id of the vehicle at each index, and the index of each id
+  std::vector<uint32_t> ids_;
+  std::vector<uint32_t> index_of_;
+  // # of vehicles within neighbor_range of each vehicle
+  std::vector<unsigned int> neighbor_counts_;
+  std::vector<Scalar> light_x_;
+  std::vector<Scalar> light_y_;
+  // the neighbor grid: the vehicles in cell c are
+  // cell_members_[cell_start_[c]] to cell_members_[cell_start_[c + 1] - 1]
+  int columns_{1};
+  int rows_{1};
+  std::vector<uint32_t> cell_start_{};
+  std::vector<uint32_t> cell_members_{};
+  std::vector<uint32_t> cell_of_{};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_VEHICLE_POPULATION_H_
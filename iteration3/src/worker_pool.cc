@@ -0,0 +1,102 @@
+/**
+ * @file worker_pool.cc
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <algorithm>
+
+#include "src/worker_pool.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Constructors/Destructor
+ ******************************************************************************/
+WorkerPool::WorkerPool(unsigned int n_threads) {
+  if (n_threads == 0) {
+    n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  for (unsigned int i = 1; i < n_threads; ++i) {
+    threads_.emplace_back(&WorkerPool::WorkerLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  loop_started_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+/*******************************************************************************
+ * Member Functions
+ ******************************************************************************/
+void WorkerPool::ParallelFor(size_t n,
+    const std::function<void(size_t)> &body) {
+  if (threads_.empty() || n <= 1) {
+    for (size_t i = 0; i < n; ++i) {
+      body(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    n_ = n;
+    next_ = 0;
+    ++loop_id_;
+  }
+  loop_started_.notify_all();
+
+  RunIterations(body, n);
+
+  // Wait for workers still running an iteration, then end the loop so that
+  // late workers do not join it.
+  std::unique_lock<std::mutex> lock(mutex_);
+  worker_done_.wait(lock, [this]() { return busy_ == 0; });
+  body_ = nullptr;
+}
+
+void WorkerPool::RunIterations(const std::function<void(size_t)> &body,
+    size_t n) {
+  for (size_t i = next_++; i < n; i = next_++) {
+    body(i);
+  }
+}
+
+void WorkerPool::WorkerLoop() {
+  uint64_t last_loop = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    loop_started_.wait(lock, [this, last_loop]() {
+      return stopping_ || (body_ != nullptr && loop_id_ != last_loop); });
+    if (stopping_) {
+      return;
+    }
+    last_loop = loop_id_;
+    const std::function<void(size_t)> *body = body_;
+    size_t n = n_;
+    ++busy_;
+    lock.unlock();
+
+    RunIterations(*body, n);
+
+    lock.lock();
+    --busy_;
+    worker_done_.notify_one();
+  }
+}
+
+NAMESPACE_END(csci3081);
@@ -0,0 +1,97 @@
+/**
+ * @file worker_pool.h
+ *
+ * @copyright 2018 Dawood Khan
+ */
+
+#ifndef SRC_WORKER_POOL_H_
+#define SRC_WORKER_POOL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/common.h"
+
+/*******************************************************************************
+ * Namespaces
+ ******************************************************************************/
+NAMESPACE_BEGIN(csci3081);
+
+/*******************************************************************************
+ * Class Definitions
+ ******************************************************************************/
+/**
+ * @brief A fixed set of threads that run the iterations of a loop in
+ * parallel.
+ *
+ * The threads are started once and wait between loops, so ParallelFor can be
+ * called every timestep or every generation without the cost of starting
+ * threads. The calling thread works on the loop too.
+ */
+class WorkerPool {
+ public:
+  /**
+   * @param n_threads Total # of threads working on a loop, including the
+   * caller. 0 uses one per core.
+   */
+  explicit WorkerPool(unsigned int n_threads = 0);
+
+  /**
+   * @brief Stop and join the threads.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &other) = delete;
+  WorkerPool &operator=(const WorkerPool &other) = delete;
+
+  /**
+   * @brief Run body(i) for every i in [0, n), spread over the threads, and
+   * return once all have finished. Iterations run in no particular order, so
+   * they must be independent of each other. body must not throw.
+   */
+  void ParallelFor(size_t n, const std::function<void(size_t)> &body);
+
+  /**
+   * @brief # of threads working on a loop, including the caller.
+   */
+  unsigned int get_thread_count() const {
+    return static_cast<unsigned int>(threads_.size()) + 1; }
+
+ private:
+  void WorkerLoop();
+
+  /**
+   * @brief Run iterations of the current loop until none are left.
+   */
+  void RunIterations(const std::function<void(size_t)> &body, size_t n);
+
+  std::vector<std::thread> threads_{};
+  std::mutex mutex_{};
+  // signaled when a loop starts or the pool stops
+  std::condition_variable loop_started_{};
+  // signaled when a worker is done with a loop
+  std::condition_variable worker_done_{};
+
+  // the current loop; body_ is null between loops
+  const std::function<void(size_t)> *body_{nullptr};
+  size_t n_{0};
+  std::atomic<size_t> next_{0};
+  // incremented for each loop, so workers join each loop once
+  uint64_t loop_id_{0};
+  // workers running iterations of the current loop
+  unsigned int busy_{0};
+  bool stopping_{false};
+};
+
+NAMESPACE_END(csci3081);
+
+#endif  // SRC_WORKER_POOL_H_
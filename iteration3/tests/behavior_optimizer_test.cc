@@ -0,0 +1,54 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+
+// Project code from the ../src directory
+#include "../src/behavior_optimizer.h"
+#include "../src/explore_behavior.h"
+#include "../src/fear_behavior.h"
+
+#ifdef BEHAVIOR_OPTIMIZER_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The fixed behaviors are special cases of the parametric one
+TEST(BehaviorOptimizerTest, parametricMatchesFixed) {
+  csci3081::FearBehavior fear;
+  csci3081::ExploreBehavior explore;
+  csci3081::ParametricBehavior::Parameters fear_weights = {{1, 0, 0, 1, 0, 0}};
+  csci3081::ParametricBehavior::Parameters explore_weights =
+    {{0, -1, -1, 0, 60, 60}};
+  csci3081::ParametricBehavior parametric_fear(fear_weights);
+  csci3081::ParametricBehavior parametric_explore(explore_weights);
+
+  double readings[][2] = {{0, 0}, {12.5, 3}, {40, 59}};
+  for (auto &r : readings) {
+    csci3081::WheelVelocity expected = fear.processReading(r[0], r[1]);
+    csci3081::WheelVelocity actual =
+      parametric_fear.processReading(r[0], r[1]);
+    EXPECT_DOUBLE_EQ(actual.left, expected.left);
+    EXPECT_DOUBLE_EQ(actual.right, expected.right);
+
+    expected = explore.processReading(r[0], r[1]);
+    actual = parametric_explore.processReading(r[0], r[1]);
+    EXPECT_DOUBLE_EQ(actual.left, expected.left);
+    EXPECT_DOUBLE_EQ(actual.right, expected.right);
+  }
+}
+
+// A genome evaluated twice in the same seeded arena gets the same fitness,
+// which is what makes the fitness cache valid
+TEST(BehaviorOptimizerTest, evaluationIsRepeatable) {
+  csci3081::BehaviorOptimizer::Genome genome =
+    csci3081::BehaviorOptimizer::FearGenome();
+  genome[4] = 5;  // drive forward a little even without light
+  unsigned int first =
+    csci3081::BehaviorOptimizer::EvaluateGenome(genome, 42, 300);
+  unsigned int second =
+    csci3081::BehaviorOptimizer::EvaluateGenome(genome, 42, 300);
+  EXPECT_EQ(first, second) << "FAIL: evaluationIsRepeatable - Fitness differs";
+  EXPECT_LE(first, 300u);
+}
+
+#endif
@@ -0,0 +1,106 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/headless_runner.h"
+
+#ifdef COMMAND_LINE_TEST
+
+namespace {
+
+/**
+ * @brief Arguments as a mode's Parse*Options function gets them.
+ */
+class Arguments {
+ public:
+  explicit Arguments(const std::vector<std::string> &args)
+      : args_(args), argv_() {
+    for (std::string &arg : args_) {
+      argv_.push_back(&arg[0]);
+    }
+  }
+
+  int argc() const { return static_cast<int>(argv_.size()); }
+  char **argv() { return argv_.data(); }
+
+ private:
+  std::vector<std::string> args_;
+  std::vector<char *> argv_;
+};
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Each flag sets its option, and a flag left out keeps its default
+TEST(CommandLineTest, setsOptions) {
+  Arguments args({"--steps", "7", "--format", "png", "--zoom", "0.5",
+    "--frames", "out/frame_"});
+  csci3081::headless_options options;
+  ASSERT_TRUE(csci3081::ParseHeadlessOptions(args.argc(), args.argv(),
+    &options)) << "FAIL: setsOptions - Valid options rejected";
+  EXPECT_EQ(options.n_steps, 7u);
+  EXPECT_EQ(options.frame_format, csci3081::kPNG);
+  EXPECT_DOUBLE_EQ(options.frame_zoom, 0.5);
+  EXPECT_EQ(options.frame_prefix, "out/frame_");
+  EXPECT_EQ(options.step_size, 1u);
+
+  Arguments spawn({"--size", "300", "--foods", "12", "--seed", "9"});
+  csci3081::spawn_options spawning;
+  ASSERT_TRUE(csci3081::ParseSpawnOptions(spawn.argc(), spawn.argv(),
+    &spawning)) << "FAIL: setsOptions - Valid spawn options rejected";
+  EXPECT_EQ(spawning.arena.x_dim, 300u);
+  EXPECT_EQ(spawning.arena.y_dim, 300u);
+  EXPECT_EQ(spawning.arena.n_Foods, 12u);
+  EXPECT_EQ(spawning.arena.seed, 9u);
+}
+
+// Unknown flags, missing values and values that are not wholly numbers are
+// all rejected
+TEST(CommandLineTest, rejectsBadArguments) {
+  std::vector<std::vector<std::string>> bad = {
+    {"--stepz", "7"}, {"--steps"}, {"--steps", "12abc"}, {"--steps", "-1"},
+    {"--steps", "99999999999"}, {"--step-size", "0"}, {"--zoom", "-2"},
+    {"--zoom", "nan"}, {"--format", "gif"}};
+  for (const std::vector<std::string> &arguments : bad) {
+    Arguments args(arguments);
+    csci3081::headless_options options;
+    EXPECT_FALSE(csci3081::ParseHeadlessOptions(args.argc(), args.argv(),
+      &options)) << "FAIL: rejectsBadArguments - Accepted " << arguments[0]
+                 << (arguments.size() > 1 ? " " + arguments[1] : "");
+    EXPECT_EQ(options.n_steps, 1000u)
+      << "FAIL: rejectsBadArguments - A bad value changed the options";
+  }
+}
+
+// --seed 0 would seed an arena from the clock, so no mode takes it
+TEST(CommandLineTest, seedZeroRejected) {
+  Arguments args({"--seed", "0"});
+  csci3081::evolution_params evolution;
+  csci3081::precision_options precision;
+  csci3081::locality_options locality;
+  csci3081::ensemble_options ensemble;
+  csci3081::falloff_options falloff;
+  csci3081::broadphase_options broadphase;
+  csci3081::spawn_options spawn;
+  EXPECT_FALSE(csci3081::ParseEvolutionOptions(args.argc(), args.argv(),
+    &evolution)) << "FAIL: seedZeroRejected - evolution";
+  EXPECT_FALSE(csci3081::ParsePrecisionOptions(args.argc(), args.argv(),
+    &precision)) << "FAIL: seedZeroRejected - precision";
+  EXPECT_FALSE(csci3081::ParseLocalityOptions(args.argc(), args.argv(),
+    &locality)) << "FAIL: seedZeroRejected - locality";
+  EXPECT_FALSE(csci3081::ParseEnsembleOptions(args.argc(), args.argv(),
+    &ensemble)) << "FAIL: seedZeroRejected - ensemble";
+  EXPECT_FALSE(csci3081::ParseFalloffOptions(args.argc(), args.argv(),
+    &falloff)) << "FAIL: seedZeroRejected - falloff";
+  EXPECT_FALSE(csci3081::ParseBroadphaseOptions(args.argc(), args.argv(),
+    &broadphase)) << "FAIL: seedZeroRejected - broadphase";
+  EXPECT_FALSE(csci3081::ParseSpawnOptions(args.argc(), args.argv(),
+    &spawn)) << "FAIL: seedZeroRejected - spawn";
+}
+
+#endif
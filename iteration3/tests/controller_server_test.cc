@@ -0,0 +1,108 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/controller_server.h"
+
+#ifdef CONTROLLER_SERVER_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A client gets every step's readings and drives the robots it controls
+TEST(ControllerServerTest, roundTrip) {
+  csci3081::arena_params params;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  std::string name = "/bv_test_" + std::to_string(getpid());
+  csci3081::ControllerServer server(name, arena.get_robots().size());
+  ASSERT_TRUE(server.IsOpen()) << "FAIL: roundTrip - No region";
+  arena.set_controller_server(&server);
+  csci3081::ControllerClient client(name);
+  ASSERT_TRUE(client.IsOpen()) << "FAIL: roundTrip - Could not attach";
+
+  int steps = 0;
+  size_t robots = 0;
+  std::thread controller([&]() {
+    while (steps < 10 && client.WaitForStep(1000)) {
+      robots = client.get_robot_count();
+      client.get_slot(0)->control = 1;
+      client.get_slot(0)->wheels[0] = 3;
+      client.get_slot(0)->wheels[1] = 3;
+      client.Reply();
+      ++steps;
+    }
+  });
+  for (int i = 0; i < 10; ++i) {
+    arena.AdvanceTime(0.05);
+  }
+  controller.join();
+
+  EXPECT_EQ(steps, 10) << "FAIL: roundTrip - Steps missed";
+  EXPECT_EQ(robots, arena.get_robots().size())
+    << "FAIL: roundTrip - Wrong # of robots published";
+  EXPECT_EQ(server.get_timeouts(), 0u) << "FAIL: roundTrip - Timed out";
+  EXPECT_TRUE(arena.get_robots()[0]->get_external_control())
+    << "FAIL: roundTrip - Robot 0 not controlled";
+  EXPECT_FALSE(arena.get_robots()[1]->get_external_control())
+    << "FAIL: roundTrip - Robot 1 controlled";
+  arena.set_controller_server(nullptr);
+}
+
+// Without a client the arena runs on its behaviors and never waits
+TEST(ControllerServerTest, noClient) {
+  csci3081::arena_params params;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  std::string name = "/bv_test_none_" + std::to_string(getpid());
+  csci3081::ControllerServer server(name, arena.get_robots().size(), 5000);
+  arena.set_controller_server(&server);
+  for (int i = 0; i < 10; ++i) {
+    arena.AdvanceTime(0.05);
+  }
+  EXPECT_EQ(server.get_timeouts(), 0u) << "FAIL: noClient - Waited";
+  EXPECT_FALSE(arena.get_robots()[0]->get_external_control())
+    << "FAIL: noClient - Robot controlled";
+  arena.set_controller_server(nullptr);
+}
+
+// A controller is sent all four readings, even those a fed robot skips
+TEST(ControllerServerTest, sensorsNotified) {
+  csci3081::arena_params params;
+  params.n_Lights = 1;
+  params.n_Foods = 1;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  csci3081::Robot *robot = arena.get_robots()[0];
+  auto step = [&]() {
+    robot->set_position(300, 300);
+    arena.get_lights()[0]->set_position(400, 300);
+    for (auto entity : arena.get_entities()) {
+      if (entity->get_type() == csci3081::kFood) {
+        entity->set_position(300, 420);
+      }
+    }
+    arena.AdvanceTime(0.05);
+  };
+  step();  // places the sensors on the robot
+
+  std::string name = "/bv_test_sensors_" + std::to_string(getpid());
+  csci3081::ControllerServer server(name, arena.get_robots().size(), 5000);
+  arena.set_controller_server(&server);
+  robot->set_hungry(false);
+  step();
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_GT(robot->get_last_reading(i), 0)
+      << "FAIL: sensorsNotified - Reading " << i
+      << " not sent to the controller";
+  }
+  arena.set_controller_server(nullptr);
+}
+
+#endif
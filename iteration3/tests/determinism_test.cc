@@ -0,0 +1,70 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/replay_harness.h"
+
+#ifdef DETERMINISM_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Every engine configuration steps the seeded scenario the same
+TEST(DeterminismTest, enginesMatch) {
+  csci3081::world_params scenario;
+  scenario.columns = 2;
+  scenario.rows = 2;
+  scenario.tile.seed = 3;
+  csci3081::ReplayHarness harness(scenario, 400, 0.05);
+
+  // everything in view, so every entity keeps full detail
+  csci3081::LodScheduler lod{csci3081::lod_params()};
+  std::vector<csci3081::replay_engine> engines(4);
+  engines[0].name = "serial";
+  engines[1].name = "threaded";
+  engines[1].n_threads = 4;
+  engines[2].name = "lod in view";
+  engines[2].lod = &lod;
+  engines[3].name = "sweep and prune";
+  engines[3].n_threads = 4;
+  engines[3].broadphase = csci3081::kSweepAndPrune;
+  std::vector<csci3081::replay_result> results = harness.Compare(engines);
+  csci3081::ReplayHarness::WriteTable(results, &std::cout);
+
+  for (auto &result : results) {
+    EXPECT_EQ(result.divergent_step, -1)
+      << "FAIL: enginesMatch - " << result.engine << " diverged at entity "
+      << result.divergent_entity;
+    EXPECT_EQ(csci3081::ReplayHarness::StepHash(result, 399),
+      csci3081::ReplayHarness::StepHash(results.front(), 399))
+      << "FAIL: enginesMatch - " << result.engine << " final hash";
+  }
+}
+
+// A run that is not stepped the same is caught at its first difference
+TEST(DeterminismTest, divergenceFound) {
+  csci3081::world_params scenario;
+  scenario.columns = 2;
+  scenario.rows = 1;
+  scenario.tile.seed = 3;
+  csci3081::ReplayHarness harness(scenario, 50, 0.05);
+
+  // nothing in view, so distant entities skip steps
+  csci3081::LodScheduler lod{csci3081::lod_params()};
+  lod.set_view(-1e6, -1e6, -1e6, -1e6);
+  std::vector<csci3081::replay_engine> engines(2);
+  engines[0].name = "serial";
+  engines[1].name = "lod coarse";
+  engines[1].lod = &lod;
+  std::vector<csci3081::replay_result> results = harness.Compare(engines);
+
+  EXPECT_EQ(results[1].divergent_step, 0)
+    << "FAIL: divergenceFound - Wrong step";
+  EXPECT_GE(results[1].divergent_entity, 0)
+    << "FAIL: divergenceFound - No entity";
+}
+
+#endif
@@ -0,0 +1,52 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/food_index.h"
+
+#ifdef FOOD_INDEX_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A range query finds exactly the food within range, across cells
+TEST(FoodIndexTest, queryRange) {
+  csci3081::FoodIndex index(1000, 800, 100);
+  csci3081::Food near, edge, far;
+  near.set_pose({410, 390});
+  edge.set_pose({500, 300});
+  far.set_pose({800, 700});
+  index.Insert(&near);
+  index.Insert(&edge);
+  index.Insert(&far);
+
+  std::vector<csci3081::Food *> found;
+  index.QueryRange({400, 400}, 142, &found);
+  ASSERT_EQ(found.size(), 2u) << "FAIL: queryRange - Wrong # of food found";
+  EXPECT_NE(std::find(found.begin(), found.end(), &near), found.end());
+  EXPECT_NE(std::find(found.begin(), found.end(), &edge), found.end());
+}
+
+// Removed food is no longer found, and food outside the arena is still kept
+TEST(FoodIndexTest, insertRemove) {
+  csci3081::FoodIndex index(1000, 800, 100);
+  csci3081::Food inside, outside;
+  inside.set_pose({50, 50});
+  outside.set_pose({-30, 900});
+  index.Insert(&inside);
+  index.Insert(&outside);
+  EXPECT_EQ(index.get_size(), 2u);
+
+  EXPECT_TRUE(index.Remove(&inside));
+  EXPECT_FALSE(index.Remove(&inside)) << "FAIL: insertRemove - Removed twice";
+
+  std::vector<csci3081::Food *> found;
+  index.QueryBox(-100, -100, 1100, 1000, &found);
+  ASSERT_EQ(found.size(), 1u);
+  EXPECT_EQ(found[0], &outside);
+}
+
+#endif
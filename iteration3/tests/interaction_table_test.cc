@@ -0,0 +1,43 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+
+// Project code from the ../src directory
+#include "../src/interaction_table.h"
+
+#ifdef INTERACTION_TABLE_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Entities collide with each other both ways or not at all
+TEST(InteractionTableTest, collideIsSymmetric) {
+  // walls do not react to anything, so only entity types are compared
+  for (int a = csci3081::kRobot; a <= csci3081::kEntity; ++a) {
+    for (int b = csci3081::kRobot; b <= csci3081::kEntity; ++b) {
+      csci3081::EntityType type_a = static_cast<csci3081::EntityType>(a);
+      csci3081::EntityType type_b = static_cast<csci3081::EntityType>(b);
+      EXPECT_EQ(csci3081::GetInteraction(type_a, type_b) == csci3081::kCollide,
+        csci3081::GetInteraction(type_b, type_a) == csci3081::kCollide)
+        << "FAIL: collideIsSymmetric - " << a << " and " << b;
+    }
+  }
+}
+
+// Robots bounce off robots and walls and only sense lights and food
+TEST(InteractionTableTest, robotRules) {
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kRobot, csci3081::kRobot),
+    csci3081::kCollide) << "FAIL: robotRules - robot and robot";
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kRobot, csci3081::kTopWall),
+    csci3081::kCollide) << "FAIL: robotRules - robot and wall";
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kRobot, csci3081::kLight),
+    csci3081::kSense) << "FAIL: robotRules - robot and light";
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kRobot, csci3081::kFood),
+    csci3081::kSense) << "FAIL: robotRules - robot and food";
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kLight, csci3081::kRobot),
+    csci3081::kIgnore) << "FAIL: robotRules - light and robot";
+  EXPECT_EQ(csci3081::GetInteraction(csci3081::kRobot, csci3081::kUndefined),
+    csci3081::kIgnore) << "FAIL: robotRules - robot and nothing";
+}
+
+#endif
@@ -0,0 +1,72 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/lod_scheduler.h"
+
+#ifdef LOD_SCHEDULER_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Robots out of view and away from everything are updated less often
+TEST(LodSchedulerTest, coarseOutOfView) {
+  csci3081::arena_params arena_params;
+  arena_params.n_Lights = 0;
+  arena_params.n_Foods = 0;
+  arena_params.seed = 3;
+  csci3081::Arena arena(&arena_params);
+  const std::vector<csci3081::Robot *> &robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_position(150 + 180.0 * (i % 5), 250 + 250.0 * (i / 5));
+  }
+
+  csci3081::lod_params params;
+  params.coarse_interval = 4;
+  params.margin = 0;
+  csci3081::LodScheduler lod(params);
+  lod.set_view(100, 200, 200, 300);
+  csci3081::lod_report report = lod.Apply(&arena, 0.05);
+
+  EXPECT_EQ(report.fine_entities, 1u) << "FAIL: coarseOutOfView - fine";
+  EXPECT_EQ(report.coarse_entities, robots.size() - 1)
+    << "FAIL: coarseOutOfView - coarse";
+  EXPECT_EQ(robots[0]->get_update_interval(), 1u)
+    << "FAIL: coarseOutOfView - Robot in view is coarse";
+  EXPECT_DOUBLE_EQ(report.divergence_bound, 2 * ROBOT_MAX_SPEED * 0.05 * 3)
+    << "FAIL: coarseOutOfView - divergence bound";
+
+  arena.AdvanceTime(0.05);
+  EXPECT_EQ(arena.get_step_stats().deferred_entities, robots.size() - 1)
+    << "FAIL: coarseOutOfView - Coarse robots updated";
+}
+
+// An entity near something it collides with gets full detail back
+TEST(LodSchedulerTest, fineNearInteraction) {
+  csci3081::arena_params arena_params;
+  arena_params.n_Lights = 0;
+  arena_params.n_Foods = 0;
+  arena_params.seed = 3;
+  csci3081::Arena arena(&arena_params);
+  const std::vector<csci3081::Robot *> &robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_position(150 + 180.0 * (i % 5), 250 + 250.0 * (i / 5));
+  }
+  robots[2]->set_position(robots[1]->get_pose().x + 60, 250);
+
+  csci3081::LodScheduler lod{csci3081::lod_params()};
+  lod.set_view(0, 0, 10, 10);
+  lod.Apply(&arena, 0.05);
+
+  EXPECT_EQ(robots[1]->get_update_interval(), 1u)
+    << "FAIL: fineNearInteraction - robot 1";
+  EXPECT_EQ(robots[2]->get_update_interval(), 1u)
+    << "FAIL: fineNearInteraction - robot 2";
+  EXPECT_GT(robots[4]->get_update_interval(), 1u)
+    << "FAIL: fineNearInteraction - robot 4";
+}
+
+#endif
@@ -0,0 +1,96 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/metrics_recorder.h"
+#include "../src/robot.h"
+
+#ifdef METRICS_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Only every decimation-th step is recorded, and the ring keeps the latest
+TEST(MetricsTest, decimatedRing) {
+  csci3081::arena_params params;
+  csci3081::Arena arena(&params);
+  csci3081::RingMetricsSink *ring = new csci3081::RingMetricsSink(3);
+  csci3081::MetricsRecorder recorder(5, 2);
+  recorder.AddSink(std::unique_ptr<csci3081::MetricsSink>(ring));
+  arena.set_metrics_recorder(&recorder);
+
+  for (int i = 0; i < 23; i++) {
+    arena.AdvanceTime(0.05);
+  }
+  recorder.Flush();
+  arena.set_metrics_recorder(nullptr);
+
+  std::vector<csci3081::step_metrics> recent = ring->GetRecent();
+  ASSERT_EQ(recent.size(), 3u) << "FAIL: decimatedRing - Wrong # of records";
+  EXPECT_EQ(recent[0].step, 10u);
+  EXPECT_EQ(recent[1].step, 15u);
+  EXPECT_EQ(recent[2].step, 20u);
+  EXPECT_EQ(recent[2].n_robots, arena.get_robots().size());
+}
+
+// Nothing is hungry at the start, and the time since the last meal grows
+TEST(MetricsTest, hungerAggregates) {
+  csci3081::arena_params params;
+  csci3081::Arena arena(&params);
+  csci3081::RingMetricsSink *ring = new csci3081::RingMetricsSink(10);
+  csci3081::MetricsRecorder recorder;
+  recorder.AddSink(std::unique_ptr<csci3081::MetricsSink>(ring));
+  arena.set_metrics_recorder(&recorder);
+
+  arena.AdvanceTime(0.05);
+  arena.AdvanceTime(0.05);
+  recorder.Flush();
+  arena.set_metrics_recorder(nullptr);
+
+  std::vector<csci3081::step_metrics> recent = ring->GetRecent();
+  ASSERT_EQ(recent.size(), 2u);
+  EXPECT_EQ(recent[0].n_hungry, 0u);
+  EXPECT_EQ(recent[0].n_starving, 0u);
+  EXPECT_LE(recent[1].mean_time_since_last_meal, 2.0);
+  EXPECT_GE(recent[1].mean_time_since_last_meal,
+    recent[0].mean_time_since_last_meal);
+}
+
+// A robot lingering at food counts one meal, when it ends the hunger, and
+// none while it is fed
+TEST(MetricsTest, mealsEndHunger) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 1;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  csci3081::ArenaEntity *food = nullptr;
+  for (auto entity : arena.get_entities()) {
+    if (entity->get_type() == csci3081::kFood) {
+      food = entity;
+    }
+  }
+  ASSERT_NE(food, nullptr);
+  csci3081::Robot *robot = arena.get_robots()[0];
+  robot->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  robot->set_pose(food->get_pose());
+  const csci3081::StepStats &stats = arena.get_step_stats();
+
+  arena.AdvanceTime(1);
+  EXPECT_EQ(stats.meals, 0u) << "FAIL: mealsEndHunger - Fed robot ate";
+  robot->set_hungry(true);
+  size_t meals = 0;
+  for (int step = 0; step < 5; ++step) {
+    arena.AdvanceTime(1);
+    meals += stats.meals;
+  }
+  EXPECT_EQ(meals, 1u) << "FAIL: mealsEndHunger - Meal counted every step";
+  EXPECT_FALSE(robot->get_hungry()) << "FAIL: mealsEndHunger - Still hungry";
+}
+
+#endif
@@ -0,0 +1,290 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/obstacle_map.h"
+#include "../src/occlusion_cache.h"
+#include "../src/swept_collision.h"
+
+#ifdef OBSTACLE_MAP_TEST
+
+namespace {
+
+/**
+ * @brief Distance from (x, y) to the closest point of segment.
+ */
+double DistanceTo(const csci3081::obstacle_segment &segment, double x,
+    double y) {
+  csci3081::Pose closest = csci3081::ClosestPointOnSegment(x, y, segment.x0,
+    segment.y0, segment.x1, segment.y1);
+  return std::hypot(x - closest.x, y - closest.y);
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The hierarchy finds the same segments as testing all of them
+TEST(ObstacleMapTest, queryCircle) {
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> corner(0, 1000);
+  std::uniform_real_distribution<double> offset(-30, 30);
+  csci3081::ObstacleMap obstacles;
+  for (int i = 0; i < 500; ++i) {
+    double x = corner(rng);
+    double y = corner(rng);
+    obstacles.AddSegment(x, y, x + offset(rng), y + offset(rng));
+  }
+  obstacles.Build();
+
+  for (int query = 0; query < 200; ++query) {
+    double x = corner(rng);
+    double y = corner(rng);
+    std::vector<uint32_t> found;
+    obstacles.QueryCircle(x, y, 40, &found);
+    std::sort(found.begin(), found.end());
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < obstacles.get_size(); ++i) {
+      if (DistanceTo(obstacles.get_segment(i), x, y) <= 40) {
+        expected.push_back(i);
+      }
+    }
+    EXPECT_EQ(found, expected) << "FAIL: queryCircle - Wrong segments for "
+                               << "query " << query;
+  }
+}
+
+// A moving circle stops where it first touches a side or an end
+TEST(ObstacleMapTest, sweepCircle) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddSegment(100, 0, 100, 200);
+  obstacles.AddSegment(300, 0, 300, 200);
+  obstacles.Build();
+  size_t segment = 9;
+
+  double toi = obstacles.SweepCircle(csci3081::Pose(50, 100),
+    csci3081::Pose(150, 100), 10, &segment);
+  EXPECT_NEAR(toi, 0.4, 1e-9) << "FAIL: sweepCircle - Side missed";
+  EXPECT_EQ(segment, 0u) << "FAIL: sweepCircle - Wrong segment";
+
+  toi = obstacles.SweepCircle(csci3081::Pose(100, 250),
+    csci3081::Pose(100, 150), 10, &segment);
+  EXPECT_NEAR(toi, 0.4, 1e-9) << "FAIL: sweepCircle - End missed";
+
+  // passing both ends, and staying clear of them
+  toi = obstacles.SweepCircle(csci3081::Pose(50, 250),
+    csci3081::Pose(350, 250), 10, &segment);
+  EXPECT_LT(toi, 0) << "FAIL: sweepCircle - Hit past the ends";
+}
+
+// A circle wedged into a corner is pushed out of both sides
+TEST(ObstacleMapTest, separateCorner) {
+  std::istringstream scenario(
+    "# a box, and a wall along it\n"
+    "polygon 100 100 200 100 200 200 100 200\n"
+    "\n"
+    "segment 0 300 400 300\n");
+  csci3081::ObstacleMap obstacles;
+  ASSERT_TRUE(obstacles.Read(&scenario))
+    << "FAIL: separateCorner - Scenario not read";
+  EXPECT_EQ(obstacles.get_size(), 5u)
+    << "FAIL: separateCorner - Wrong # of segments";
+
+  csci3081::Pose center(95, 105);
+  EXPECT_EQ(obstacles.Separate(&center, 10, 1), 2)
+    << "FAIL: separateCorner - Both sides are contacts";
+  for (size_t i = 0; i < obstacles.get_size(); ++i) {
+    EXPECT_GT(DistanceTo(obstacles.get_segment(i), center.x, center.y), 10)
+      << "FAIL: separateCorner - Still touching segment " << i;
+  }
+
+  std::istringstream bad("segment 0 0 1\n");
+  EXPECT_FALSE(csci3081::ObstacleMap().Read(&bad))
+    << "FAIL: separateCorner - Odd coordinates read";
+}
+
+// No light or robot gets into a box in the middle of the arena
+TEST(ObstacleMapTest, arenaKeepsOut) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddPolygon({csci3081::Pose(300, 300), csci3081::Pose(600, 300),
+    csci3081::Pose(600, 500), csci3081::Pose(300, 500)});
+  obstacles.Build();
+  csci3081::arena_params params;
+  params.n_Lights = 20;
+  params.seed = 7;
+  params.obstacles = &obstacles;
+  csci3081::Arena arena(&params);
+
+  std::vector<csci3081::ArenaEntity *> movers;
+  for (auto robot : arena.get_robots()) {
+    movers.push_back(robot);
+  }
+  for (auto light : arena.get_lights()) {
+    movers.push_back(light);
+  }
+  for (size_t i = 0; i < movers.size(); ++i) {
+    movers[i]->set_position(50 + 45.0 * (i % 20), i < 20 ? 100 : 650);
+  }
+
+  for (int step = 0; step < 1000; ++step) {
+    arena.AdvanceTime(0.5);
+    for (auto ent : movers) {
+      csci3081::Pose pose = ent->get_pose();
+      ASSERT_FALSE(pose.x > 300 && pose.x < 600 && pose.y > 300 &&
+        pose.y < 500) << "FAIL: arenaKeepsOut - In the box at step " << step;
+    }
+  }
+}
+
+// A robot pushed by another robot into the left wall and onto an obstacle
+// along it leaves both
+TEST(ObstacleMapTest, arenaWallAndObstacle) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddSegment(0, 400, 200, 400);
+  obstacles.Build();
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 7;
+  params.obstacles = &obstacles;
+  csci3081::Arena arena(&params);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_pose(csci3081::Pose(300 + 60.0 * i, 700));
+    robots[i]->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  }
+  // robots[0] is resolved first, and moved up and left, away from
+  // robots[1]
+  csci3081::Robot *robot = robots[0];
+  double radius = robot->get_radius();
+  robot->set_position(radius + 2, 400 + radius + 2);
+  robots[1]->set_position(robot->get_pose().x + radius / std::sqrt(2.0),
+    robot->get_pose().y + radius / std::sqrt(2.0));
+
+  arena.AdvanceTime(0.5);
+  EXPECT_GE(robot->get_pose().x, radius)
+    << "FAIL: arenaWallAndObstacle - Still in the wall";
+  EXPECT_GT(DistanceTo(obstacles.get_segment(0), robot->get_pose().x,
+    robot->get_pose().y), radius)
+    << "FAIL: arenaWallAndObstacle - Still on the obstacle";
+}
+
+// Rays cast through the hierarchy, alone or as a pair, are blocked by the
+// same segments as when testing all of them
+TEST(ObstacleMapTest, isBlocked) {
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> corner(0, 1000);
+  std::uniform_real_distribution<double> offset(-30, 30);
+  csci3081::ObstacleMap obstacles;
+  for (int i = 0; i < 300; ++i) {
+    double x = corner(rng);
+    double y = corner(rng);
+    obstacles.AddSegment(x, y, x + offset(rng), y + offset(rng));
+  }
+  // one straight along a ray below
+  obstacles.AddSegment(0, 2000, 100, 2000);
+  obstacles.Build();
+
+  int n_blocked = 0;
+  for (int cast = 0; cast < 300; ++cast) {
+    csci3081::Pose from(corner(rng), corner(rng));
+    csci3081::Pose beside(from.x + offset(rng), from.y + offset(rng));
+    csci3081::Pose to(corner(rng), corner(rng));
+    bool expected = false;
+    for (size_t i = 0; i < obstacles.get_size(); ++i) {
+      const csci3081::obstacle_segment &segment = obstacles.get_segment(i);
+      csci3081::ObstacleMap one;
+      one.AddSegment(segment.x0, segment.y0, segment.x1, segment.y1);
+      one.Build();
+      expected = expected || one.IsBlocked(from, to);
+    }
+    EXPECT_EQ(obstacles.IsBlocked(from, to), expected)
+      << "FAIL: isBlocked - Wrong for ray " << cast;
+    bool blocked_a = false;
+    bool blocked_b = false;
+    obstacles.IsBlockedPair(from, beside, to, &blocked_a, &blocked_b);
+    EXPECT_EQ(blocked_a, expected) << "FAIL: isBlocked - Packet differs";
+    EXPECT_EQ(blocked_b, obstacles.IsBlocked(beside, to))
+      << "FAIL: isBlocked - Packet differs";
+    n_blocked += expected ? 1 : 0;
+  }
+  EXPECT_GT(n_blocked, 0) << "FAIL: isBlocked - Nothing blocked";
+  EXPECT_TRUE(obstacles.IsBlocked(csci3081::Pose(50, 2000),
+    csci3081::Pose(200, 2000))) << "FAIL: isBlocked - Along a segment";
+  EXPECT_FALSE(obstacles.IsBlocked(csci3081::Pose(150, 2000),
+    csci3081::Pose(200, 2000))) << "FAIL: isBlocked - Past a segment";
+}
+
+// Lines of sight are only cast again once an end moved beyond the
+// tolerance
+TEST(ObstacleMapTest, occlusionCache) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddSegment(100, 0, 100, 200);
+  obstacles.Build();
+  csci3081::OcclusionCache cache(2.0);
+  csci3081::StepStats stats;
+  bool left = true;
+  bool right = true;
+  csci3081::Pose light(150, 100);
+
+  cache.GetVisibility(obstacles, nullptr, nullptr, csci3081::Pose(50, 100),
+    csci3081::Pose(50, 400), light, &left, &right, &stats);
+  EXPECT_FALSE(left) << "FAIL: occlusionCache - Not in the shadow";
+  EXPECT_TRUE(right) << "FAIL: occlusionCache - Around the end";
+  EXPECT_EQ(stats.occlusion_rays, 2u) << "FAIL: occlusionCache - Not cast";
+
+  cache.GetVisibility(obstacles, nullptr, nullptr, csci3081::Pose(51, 100),
+    csci3081::Pose(50, 401), light, &left, &right, &stats);
+  EXPECT_EQ(stats.occlusion_cache_hits, 1u)
+    << "FAIL: occlusionCache - Not reused";
+  EXPECT_FALSE(left) << "FAIL: occlusionCache - Wrong cached visibility";
+
+  cache.GetVisibility(obstacles, nullptr, nullptr, csci3081::Pose(50, 100),
+    csci3081::Pose(50, 400), csci3081::Pose(150, 250), &left, &right,
+    &stats);
+  EXPECT_EQ(stats.occlusion_rays, 4u)
+    << "FAIL: occlusionCache - Moved light not cast again";
+  EXPECT_EQ(stats.occluded_readings, 3u)
+    << "FAIL: occlusionCache - Wrong # of blocked readings";
+}
+
+// A light shut in a box casts no light on the robots outside it
+TEST(ObstacleMapTest, arenaShadows) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddPolygon({csci3081::Pose(100, 100), csci3081::Pose(400, 100),
+    csci3081::Pose(400, 400), csci3081::Pose(100, 400)});
+  obstacles.Build();
+  csci3081::arena_params params;
+  params.n_Lights = 1;
+  params.seed = 3;
+  params.obstacles = &obstacles;
+  csci3081::Arena arena(&params);
+  arena.get_lights()[0]->set_position(250, 250);
+  for (size_t i = 0; i < arena.get_robots().size(); ++i) {
+    arena.get_robots()[i]->set_position(80 + 90.0 * i, 600);
+  }
+  // the sensors follow the robots at their first update
+  arena.AdvanceTime(0.5);
+
+  size_t rays = 0;
+  for (int step = 0; step < 50; ++step) {
+    arena.AdvanceTime(0.5);
+    const csci3081::StepStats &stats = arena.get_step_stats();
+    EXPECT_EQ(stats.occluded_readings,
+      stats.occlusion_rays + 2 * stats.occlusion_cache_hits)
+      << "FAIL: arenaShadows - A sensor saw the light at step " << step;
+    rays += stats.occlusion_rays;
+  }
+  EXPECT_GT(rays, 0u) << "FAIL: arenaShadows - No lines of sight cast";
+}
+
+#endif
@@ -0,0 +1,122 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/obstacle_map.h"
+#include "../src/poisson_disk_sampler.h"
+
+#ifdef POISSON_DISK_TEST
+
+namespace {
+
+/**
+ * @brief # of pairs of entities closer than the sum of their radii.
+ */
+int CountOverlaps(const std::vector<csci3081::ArenaEntity *> &entities) {
+  int n_overlaps = 0;
+  for (size_t i = 0; i < entities.size(); ++i) {
+    for (size_t j = i + 1; j < entities.size(); ++j) {
+      const csci3081::Pose &a = entities[i]->get_pose();
+      const csci3081::Pose &b = entities[j]->get_pose();
+      if (std::hypot(a.x - b.x, a.y - b.y) <
+          entities[i]->get_radius() + entities[j]->get_radius()) {
+        ++n_overlaps;
+      }
+    }
+  }
+  return n_overlaps;
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Circles of mixed radii fill an arena without overlapping each other, the
+// circles added or the obstacles
+TEST(PoissonDiskSamplerTest, mixedRadii) {
+  csci3081::ObstacleMap obstacles;
+  obstacles.AddSegment(0, 500, 600, 500);
+  obstacles.Build();
+  csci3081::PoissonDiskSampler sampler(1000, 1000, 30, 1);
+  sampler.set_obstacles(&obstacles);
+  sampler.AddCircle(csci3081::Pose(900, 900), 30);
+
+  std::mt19937 rng(3);
+  std::vector<csci3081::Pose> centers{csci3081::Pose(900, 900)};
+  std::vector<double> radii{30};
+  for (int i = 0; i < 300; ++i) {
+    double radius = 5 + 25 * (i % 6) / 5.0;
+    csci3081::Pose center;
+    ASSERT_TRUE(sampler.Place(radius, &rng, &center))
+      << "FAIL: mixedRadii - No room for circle " << i;
+    EXPECT_TRUE(center.x >= radius && center.x <= 1000 - radius &&
+      center.y >= radius && center.y <= 1000 - radius)
+      << "FAIL: mixedRadii - Circle " << i << " outside the arena";
+    std::vector<uint32_t> touched;
+    obstacles.QueryCircle(center.x, center.y, radius, &touched);
+    EXPECT_TRUE(touched.empty())
+      << "FAIL: mixedRadii - Circle " << i << " on an obstacle";
+    for (size_t j = 0; j < centers.size(); ++j) {
+      EXPECT_GE(std::hypot(center.x - centers[j].x, center.y - centers[j].y),
+        radius + radii[j] + 1) << "FAIL: mixedRadii - Circles " << i
+                               << " and " << j << " overlap";
+    }
+    centers.push_back(center);
+    radii.push_back(radius);
+  }
+  EXPECT_EQ(sampler.get_size(), 301u) << "FAIL: mixedRadii - Wrong size";
+}
+
+// An arena too small for every circle places as many as fit and reports
+// the rest
+TEST(PoissonDiskSamplerTest, full) {
+  csci3081::PoissonDiskSampler sampler(100, 100, 10, 0);
+  std::mt19937 rng(5);
+  int n_placed = 0;
+  for (int i = 0; i < 100; ++i) {
+    csci3081::Pose center;
+    n_placed += sampler.Place(10, &rng, &center) ? 1 : 0;
+  }
+  // at most 25 circles of diameter 20 fit in a 100 x 100 square
+  EXPECT_GT(n_placed, 10) << "FAIL: full - Too few placed";
+  EXPECT_LE(n_placed, 25) << "FAIL: full - Too many placed";
+}
+
+// Entities spawn apart, in any arena size, and again after a reset
+TEST(PoissonDiskSamplerTest, arenaSpawn) {
+  csci3081::arena_params params;
+  params.x_dim = 3000;
+  params.y_dim = 500;
+  params.n_Lights = 40;
+  params.n_Foods = 40;
+  params.seed = 11;
+  csci3081::Arena arena(&params);
+  const std::vector<csci3081::ArenaEntity *> &entities =
+    arena.get_entities();
+  EXPECT_EQ(CountOverlaps(entities), 0)
+    << "FAIL: arenaSpawn - Entities overlap after construction";
+  double max_x = 0;
+  for (auto ent : entities) {
+    max_x = std::max(max_x, ent->get_pose().x);
+  }
+  EXPECT_GT(max_x, 1000) << "FAIL: arenaSpawn - Arena not filled";
+
+  arena.AdvanceTime(0.5);
+  arena.Reset();
+  EXPECT_EQ(CountOverlaps(entities), 0)
+    << "FAIL: arenaSpawn - Entities overlap after reset";
+
+  arena.AddEntity(csci3081::kFood, 20);
+  EXPECT_EQ(CountOverlaps(arena.get_entities()), 0)
+    << "FAIL: arenaSpawn - Added food overlaps";
+}
+
+#endif
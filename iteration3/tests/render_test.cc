@@ -0,0 +1,250 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/frame_recorder.h"
+#include "../src/params.h"
+#include "../src/render_batch.h"
+#include "../src/software_rasterizer.h"
+
+#ifdef RENDER_TEST
+
+namespace {
+
+/**
+ * @brief Move every robot but the first out of a width x height view, and
+ * the first to (x, y), with its sensors.
+ */
+csci3081::Robot *OneRobotInView(csci3081::Arena *arena, double x, double y,
+    int width, int height) {
+  std::vector<csci3081::Robot *> robots = arena->get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    csci3081::Pose pose(x, y, 0);
+    if (i > 0) {
+      pose = csci3081::Pose(width + 200.0, height + 200.0, 0);
+    }
+    robots[i]->set_pose(pose);
+    robots[i]->get_left_lightsensor()->
+      setSensorPositionBasedOnRobotPosition(pose);
+    robots[i]->get_right_lightsensor()->
+      setSensorPositionBasedOnRobotPosition(pose);
+  }
+  return robots[0];
+}
+
+/**
+ * @brief The color of pixel (x, y) as 0xRRGGBB.
+ */
+uint32_t PixelAt(const csci3081::SoftwareRasterizer &image, double x,
+    double y) {
+  const uint8_t *pixel = image.get_pixels().data() +
+    (static_cast<size_t>(y) * image.get_width() + static_cast<size_t>(x)) * 4;
+  return (static_cast<uint32_t>(pixel[0]) << 16) | (pixel[1] << 8) | pixel[2];
+}
+
+uint32_t BigEndianAt(const std::vector<uint8_t> &bytes, size_t offset) {
+  return (static_cast<uint32_t>(bytes[offset]) << 24) |
+    (static_cast<uint32_t>(bytes[offset + 1]) << 16) |
+    (static_cast<uint32_t>(bytes[offset + 2]) << 8) | bytes[offset + 3];
+}
+
+std::vector<uint8_t> ReadFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(file),
+    std::istreambuf_iterator<char>());
+}
+
+bool FileExists(const std::string &path) {
+  return static_cast<bool>(std::ifstream(path));
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Lights and food are labeled in a small arena at the default zoom, but not
+// zoomed out or once too many of them are in view
+TEST(RenderTest, labels) {
+  csci3081::arena_params params;
+  params.n_Lights = 4;
+  params.n_Foods = 4;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  csci3081::RenderBatcher batcher;
+  batcher.Build(&arena, 1.0, X_DIM, Y_DIM);
+  EXPECT_EQ(batcher.get_labels().size(), 8u)
+    << "FAIL: labels - Small arena not labeled";
+  batcher.Build(&arena, RENDER_LABEL_MIN_ZOOM / 2, X_DIM, Y_DIM);
+  EXPECT_TRUE(batcher.get_labels().empty())
+    << "FAIL: labels - Labeled when zoomed out";
+
+  params.n_Foods = RENDER_MAX_LABELS;
+  csci3081::Arena crowded(&params);
+  batcher.Build(&crowded, 1.0, X_DIM, Y_DIM);
+  EXPECT_TRUE(batcher.get_labels().empty())
+    << "FAIL: labels - Crowded arena labeled";
+  EXPECT_EQ(batcher.get_circle_count(), crowded.get_entities().size() +
+    2 * crowded.get_robots().size())
+    << "FAIL: labels - Entities or sensors left out with the labels";
+}
+
+// One robot drawn over the background, with its light sensors on top and
+// the arena border along the image's top and left edges
+TEST(RenderTest, rasterOneRobot) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  csci3081::Robot *robot = OneRobotInView(&arena, 100, 100, 200, 200);
+  csci3081::RenderBatcher batcher;
+  batcher.Build(&arena, 1.0, 200, 200);
+  csci3081::SoftwareRasterizer image(200, 200);
+  image.Clear(csci3081::RgbColor(0, 0, 0));
+  image.Draw(batcher, 1.0, arena.get_x_dim(), arena.get_y_dim());
+
+  EXPECT_EQ(PixelAt(image, 100, 100), 0x00FF00u)
+    << "FAIL: rasterOneRobot - Robot center not green";
+  csci3081::Pose left = robot->get_left_lightsensor()->get_position();
+  csci3081::Pose right = robot->get_right_lightsensor()->get_position();
+  EXPECT_EQ(PixelAt(image, left.x, left.y), 0xFFFFFFu)
+    << "FAIL: rasterOneRobot - Left light sensor not drawn";
+  EXPECT_EQ(PixelAt(image, right.x, right.y), 0xFFFFFFu)
+    << "FAIL: rasterOneRobot - Right light sensor not drawn";
+  EXPECT_EQ(PixelAt(image, 170, 170), 0u)
+    << "FAIL: rasterOneRobot - Background drawn over";
+  EXPECT_EQ(PixelAt(image, 50, 0), 0xFFFFFFu)
+    << "FAIL: rasterOneRobot - Top border not drawn";
+  EXPECT_EQ(PixelAt(image, 0, 50), 0xFFFFFFu)
+    << "FAIL: rasterOneRobot - Left border not drawn";
+}
+
+// The PNG's chunks carry valid CRCs and its image data inflates, with zlib,
+// to the rows of pixels, each after a filter type of 0. The image is large
+// enough to need more than one stored block.
+TEST(RenderTest, pngRoundTrip) {
+  const int kWidth = 200, kHeight = 100;
+  csci3081::SoftwareRasterizer image(kWidth, kHeight);
+  image.Clear(csci3081::RgbColor(10, 20, 30));
+  image.FillCircle(60, 40, 25, csci3081::RgbColor(0, 255, 0));
+  image.StrokeCircle(150, 70, 20, csci3081::RgbColor(255, 0, 0));
+  const std::string path = "render_test_round_trip.png";
+  ASSERT_TRUE(image.WritePNG(path)) << "FAIL: pngRoundTrip - Not written";
+  std::vector<uint8_t> png = ReadFile(path);
+  std::remove(path.c_str());
+
+  const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  ASSERT_GE(png.size(), sizeof(signature));
+  EXPECT_TRUE(std::equal(signature, signature + sizeof(signature),
+    png.begin())) << "FAIL: pngRoundTrip - Bad signature";
+
+  std::vector<std::string> types;
+  std::vector<uint8_t> header, data;
+  size_t offset = sizeof(signature);
+  while (offset + 12 <= png.size()) {
+    uint32_t length = BigEndianAt(png, offset);
+    ASSERT_LE(offset + 12 + length, png.size())
+      << "FAIL: pngRoundTrip - Chunk runs past the end of the file";
+    const uint8_t *type = png.data() + offset + 4;
+    types.emplace_back(type, type + 4);
+    uint32_t crc = crc32(0, type, 4 + length);
+    EXPECT_EQ(BigEndianAt(png, offset + 8 + length), crc)
+      << "FAIL: pngRoundTrip - Bad CRC in chunk " << types.back();
+    std::vector<uint8_t> *chunk = (types.back() == "IHDR") ? &header :
+      (types.back() == "IDAT") ? &data : nullptr;
+    if (chunk) {
+      chunk->insert(chunk->end(), type + 4, type + 4 + length);
+    }
+    offset += 12 + length;
+  }
+  EXPECT_EQ(offset, png.size()) << "FAIL: pngRoundTrip - Trailing bytes";
+  EXPECT_EQ(types, std::vector<std::string>({"IHDR", "IDAT", "IEND"}))
+    << "FAIL: pngRoundTrip - Wrong chunks";
+  ASSERT_EQ(header.size(), 13u) << "FAIL: pngRoundTrip - Bad header";
+  EXPECT_EQ(BigEndianAt(header, 0), static_cast<uint32_t>(kWidth))
+    << "FAIL: pngRoundTrip - Wrong width";
+  EXPECT_EQ(BigEndianAt(header, 4), static_cast<uint32_t>(kHeight))
+    << "FAIL: pngRoundTrip - Wrong height";
+
+  // one byte more than needed, to catch a stream that inflates to too much
+  size_t row_size = kWidth * 4;
+  std::vector<uint8_t> raw((row_size + 1) * kHeight + 1);
+  uLongf raw_size = raw.size();
+  ASSERT_EQ(uncompress(raw.data(), &raw_size, data.data(), data.size()),
+    Z_OK) << "FAIL: pngRoundTrip - Image data does not inflate";
+  ASSERT_EQ(raw_size, (row_size + 1) * kHeight)
+    << "FAIL: pngRoundTrip - Image data inflates to the wrong size";
+  const std::vector<uint8_t> &pixels = image.get_pixels();
+  for (int y = 0; y < kHeight; ++y) {
+    const uint8_t *row = raw.data() + y * (row_size + 1);
+    EXPECT_EQ(row[0], 0) << "FAIL: pngRoundTrip - Row " << y << " filtered";
+    EXPECT_TRUE(std::equal(row + 1, row + 1 + row_size,
+      pixels.begin() + y * row_size))
+      << "FAIL: pngRoundTrip - Row " << y << " differs from the image";
+  }
+}
+
+// Only every interval-th step is written, and a recorder destroyed with
+// frames still queued writes them all before it goes
+TEST(RenderTest, frameRecorder) {
+  csci3081::arena_params params;
+  params.n_Lights = 2;
+  params.n_Foods = 2;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  const int kWidth = 64, kHeight = 48;
+  const std::string prefix = "render_test_frame_";
+  auto path = [&prefix](unsigned int step) {
+    char number[16];
+    snprintf(number, sizeof(number), "%06u", step);
+    return prefix + number + ".ppm";
+  };
+
+  {
+    csci3081::FrameRecorder recorder(prefix, 3, csci3081::kPPM, kWidth,
+      kHeight, 0.1, 2);
+    for (unsigned int step = 0; step < 10; ++step) {
+      recorder.Capture(&arena, step);
+    }
+    recorder.Finish();
+    EXPECT_EQ(recorder.get_frames_written(), 4u)
+      << "FAIL: frameRecorder - Wrong # of frames written";
+    EXPECT_EQ(recorder.get_frames_failed(), 0u)
+      << "FAIL: frameRecorder - Frames failed";
+  }
+  for (unsigned int step = 0; step < 10; ++step) {
+    EXPECT_EQ(FileExists(path(step)), step % 3 == 0)
+      << "FAIL: frameRecorder - Step " << step;
+    std::remove(path(step).c_str());
+  }
+
+  // one worker, so most frames are still queued when the recorder goes
+  const unsigned int kSteps = 20;
+  {
+    csci3081::FrameRecorder recorder(prefix, 1, csci3081::kPPM, kWidth,
+      kHeight, 0.1, 1);
+    for (unsigned int step = 0; step < kSteps; ++step) {
+      recorder.Capture(&arena, step);
+    }
+  }
+  size_t frame_size = std::string("P6\n64 48\n255\n").size() +
+    kWidth * kHeight * 3;
+  for (unsigned int step = 0; step < kSteps; ++step) {
+    EXPECT_EQ(ReadFile(path(step)).size(), frame_size)
+      << "FAIL: frameRecorder - Frame " << step << " not written in full";
+    std::remove(path(step).c_str());
+  }
+}
+
+#endif
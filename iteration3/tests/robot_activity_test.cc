@@ -0,0 +1,234 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/params.h"
+#include "../src/robot.h"
+#include "../src/timer_wheel.h"
+
+#ifdef ROBOT_ACTIVITY_TEST
+
+namespace {
+
+/**
+ * @brief Let the robot see a light at position, as Arena::Sense() does.
+ */
+void SeeLight(csci3081::Robot *robot, const csci3081::Pose &position) {
+  robot->get_left_lightsensor()->Notify(position);
+  robot->get_right_lightsensor()->Notify(position);
+}
+
+/**
+ * @brief Stop the robot and update it once, so it falls asleep.
+ */
+void Stop(csci3081::Robot *robot) {
+  robot->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  robot->TimestepUpdate(1);
+}
+
+/**
+ * @brief Step arena with robot between a light and a food, returning the
+ * sum of its two light readings and the sum of its two food readings.
+ */
+std::vector<double> SenseLightAndFood(csci3081::Arena *arena,
+    csci3081::Robot *robot) {
+  robot->set_position(300, 300);
+  arena->get_lights()[0]->set_position(400, 300);
+  for (auto entity : arena->get_entities()) {
+    if (entity->get_type() == csci3081::kFood) {
+      entity->set_position(300, 420);
+    }
+  }
+  arena->AdvanceTime(0.05);
+  return std::vector<double>{
+    robot->get_last_reading(0) + robot->get_last_reading(1),
+    robot->get_last_reading(2) + robot->get_last_reading(3)};
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Stopped robots sleep through the step, and food is never updated
+TEST(RobotActivityTest, arenaCounts) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 3;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  for (auto robot : robots) {
+    robot->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  }
+
+  arena.AdvanceTime(0.5);
+  const csci3081::StepStats &stats = arena.get_step_stats();
+  EXPECT_EQ(stats.active_entities, robots.size())
+    << "FAIL: arenaCounts - Stopping robots not updated";
+  for (auto robot : robots) {
+    EXPECT_TRUE(robot->IsAsleep()) << "FAIL: arenaCounts - Robot "
+                                   << robot->get_id() << " awake";
+  }
+
+  arena.AdvanceTime(0.5);
+  EXPECT_EQ(stats.sleeping_entities, robots.size())
+    << "FAIL: arenaCounts - Sleeping robots not counted";
+  EXPECT_EQ(stats.active_entities, 0u)
+    << "FAIL: arenaCounts - Sleeping robots updated";
+  EXPECT_EQ(stats.static_entities, 3u)
+    << "FAIL: arenaCounts - Food not reported as static";
+}
+
+// Robots removed from the GUI go with their sensors, and the arena keeps
+// stepping those left
+TEST(RobotActivityTest, guiRemovesRobots) {
+  csci3081::arena_params params;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  arena.AcceptGUIParameters(1, 1, 4, 4, 1000);
+
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  ASSERT_EQ(robots.size(), 2u) << "FAIL: guiRemovesRobots - Wrong # of robots";
+  EXPECT_NE(robots[0]->get_robot_type(), robots[1]->get_robot_type())
+    << "FAIL: guiRemovesRobots - Not one fear and one explore robot";
+  for (int i = 0; i < 20; i++) {
+    arena.AdvanceTime(0.5);
+  }
+  EXPECT_EQ(arena.get_step_stats().active_entities +
+    arena.get_step_stats().sleeping_entities, 6u)
+    << "FAIL: guiRemovesRobots - Removed robots still stepped";
+}
+
+// A sleeping robot that an awake robot is moved into is told of the
+// collision, and wakes
+TEST(RobotActivityTest, wakeWhenPushed) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 3;
+  csci3081::Arena arena(&params);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_position(60 + 90.0 * i, 400);
+    robots[i]->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  }
+  arena.AdvanceTime(0.5);
+  arena.AdvanceTime(0.5);
+  csci3081::Robot *sleeper = robots[0];
+  csci3081::Robot *pusher = robots[1];
+  ASSERT_TRUE(sleeper->IsAsleep()) << "FAIL: wakeWhenPushed - Not asleep";
+
+  // already overlapping, so the overlap pass finds them rather than the
+  // sweep
+  pusher->set_position(sleeper->get_pose().x + sleeper->get_radius(), 400);
+  pusher->Wake();
+  arena.AdvanceTime(0.5);
+  EXPECT_FALSE(sleeper->IsAsleep())
+    << "FAIL: wakeWhenPushed - Slept through being pushed into";
+}
+
+// A sleeping robot wakes once a light moved enough to change a reading by
+// more than SLEEP_READING_TOLERANCE
+TEST(RobotActivityTest, wakeOnReading) {
+  csci3081::Robot robot;
+  csci3081::Pose light(robot.get_pose().x + 300, robot.get_pose().y);
+  SeeLight(&robot, light);
+  Stop(&robot);
+  ASSERT_TRUE(robot.IsAsleep()) << "FAIL: wakeOnReading - Not asleep";
+
+  // a hair's breadth changes the reading by less than the tolerance
+  SeeLight(&robot, csci3081::Pose(light.x + 1e-3, light.y));
+  double left = robot.get_left_lightsensor()->get_reading();
+  EXPECT_TRUE(robot.CanSkipTimestep())
+    << "FAIL: wakeOnReading - Woken by a small change";
+  EXPECT_TRUE(robot.IsAsleep()) << "FAIL: wakeOnReading - Woke up";
+
+  csci3081::Pose closer(light.x - 250, light.y);
+  SeeLight(&robot, closer);
+  EXPECT_GT(robot.get_left_lightsensor()->get_reading() - left,
+    SLEEP_READING_TOLERANCE) << "FAIL: wakeOnReading - Reading unchanged";
+  EXPECT_FALSE(robot.CanSkipTimestep())
+    << "FAIL: wakeOnReading - Slept through a change";
+  EXPECT_FALSE(robot.IsAsleep()) << "FAIL: wakeOnReading - Still asleep";
+}
+
+// Getting hungry and touching something wake a sleeping robot
+TEST(RobotActivityTest, wakeOnEvents) {
+  csci3081::TimerWheel wheel;
+  csci3081::Robot robot;
+  robot.set_timer_wheel(&wheel);
+  Stop(&robot);
+  ASSERT_TRUE(robot.IsAsleep()) << "FAIL: wakeOnEvents - Not asleep";
+  wheel.Advance(479);
+  EXPECT_TRUE(robot.CanSkipTimestep())
+    << "FAIL: wakeOnEvents - Woken before getting hungry";
+  wheel.Advance(1);
+  EXPECT_FALSE(robot.IsAsleep())
+    << "FAIL: wakeOnEvents - Slept through getting hungry";
+
+  Stop(&robot);
+  ASSERT_TRUE(robot.IsAsleep()) << "FAIL: wakeOnEvents - Not asleep";
+  robot.HandleCollision(csci3081::kRightWall);
+  EXPECT_FALSE(robot.IsAsleep())
+    << "FAIL: wakeOnEvents - Slept through a collision";
+  EXPECT_FALSE(robot.CanSkipTimestep())
+    << "FAIL: wakeOnEvents - Skipped after a collision";
+}
+
+// What the robot read in a timestep is kept after the sensors are cleared
+TEST(RobotActivityTest, lastReadings) {
+  csci3081::Robot robot;
+  robot.set_hungry(true);
+  csci3081::Pose pose = robot.get_pose();
+  SeeLight(&robot, csci3081::Pose(pose.x + 100, pose.y + 50));
+  robot.get_left_foodsensor()->Notify(csci3081::Pose(pose.x - 50, pose.y));
+  robot.get_right_foodsensor()->Notify(csci3081::Pose(pose.x - 50, pose.y));
+  csci3081::Sensor *sensors[] = {robot.get_left_lightsensor(),
+    robot.get_right_lightsensor(), robot.get_left_foodsensor(),
+    robot.get_right_foodsensor()};
+  double readings[4];
+  for (int i = 0; i < 4; ++i) {
+    readings[i] = sensors[i]->get_reading();
+    ASSERT_GT(readings[i], 0) << "FAIL: lastReadings - Sensor " << i;
+  }
+  robot.TimestepUpdate(1);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(sensors[i]->get_reading(), 0)
+      << "FAIL: lastReadings - Sensor " << i << " not cleared";
+    EXPECT_EQ(robot.get_last_reading(i), readings[i])
+      << "FAIL: lastReadings - Reading " << i << " not kept";
+  }
+  EXPECT_EQ(robot.get_last_light_reading(), (readings[0] + readings[1]) / 2)
+    << "FAIL: lastReadings - Wrong mean light reading";
+}
+
+
+// Robots only read the sensors their state uses: a fed robot its light
+// sensors and a hungry robot its food sensors
+TEST(RobotActivityTest, sensorsNotified) {
+  csci3081::arena_params params;
+  params.n_Lights = 1;
+  params.n_Foods = 1;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  csci3081::Robot *robot = arena.get_robots()[0];
+  SenseLightAndFood(&arena, robot);  // places the sensors on the robot
+
+  std::vector<double> fed = SenseLightAndFood(&arena, robot);
+  EXPECT_GT(fed[0], 0) << "FAIL: sensorsNotified - Fed robot missed light";
+  EXPECT_EQ(fed[1], 0) << "FAIL: sensorsNotified - Fed robot sensed food";
+
+  robot->set_hungry(true);
+  std::vector<double> hungry = SenseLightAndFood(&arena, robot);
+  EXPECT_EQ(hungry[0], 0)
+    << "FAIL: sensorsNotified - Hungry robot sensed light";
+  EXPECT_GT(hungry[1], 0)
+    << "FAIL: sensorsNotified - Hungry robot missed food";
+}
+
+#endif
@@ -0,0 +1,58 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <cmath>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+
+#ifdef SENSOR_RANGE_TEST
+
+namespace {
+
+/**
+ * @brief The mean light reading of the first robot, with one light near it
+ * and one far away.
+ */
+double LightReading(const csci3081::arena_params &params) {
+  csci3081::Arena arena(&params);
+  const std::vector<csci3081::Robot *> &robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_position(100 + 80.0 * i, 700);
+  }
+  robots[0]->set_position(300, 300);
+  arena.get_lights()[0]->set_position(400, 300);
+  arena.get_lights()[1]->set_position(900, 600);
+  // the sensors are placed on the robot by its first update
+  arena.AdvanceTime(0.05);
+  arena.AdvanceTime(0.05);
+  return robots[0]->get_last_light_reading();
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Lights out of range are not sensed; the far field makes up for them
+TEST(SensorRangeTest, lightRange) {
+  csci3081::arena_params params;
+  params.n_Lights = 2;
+  params.n_Foods = 0;
+  params.seed = 3;
+  double full = LightReading(params);
+
+  params.light_sensor_range = 200;
+  double ranged = LightReading(params);
+  EXPECT_GT(ranged, 0) << "FAIL: lightRange - Near light not sensed";
+  EXPECT_LT(ranged, full) << "FAIL: lightRange - Far light sensed";
+
+  params.far_field_correction = true;
+  double corrected = LightReading(params);
+  EXPECT_GT(corrected, ranged) << "FAIL: lightRange - No far field";
+  EXPECT_LT(std::fabs(corrected - full), full - ranged)
+    << "FAIL: lightRange - Far field does not approach the full reading";
+}
+
+#endif
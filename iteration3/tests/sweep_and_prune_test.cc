@@ -0,0 +1,109 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/sweep_and_prune.h"
+
+#ifdef SWEEP_AND_PRUNE_TEST
+
+namespace {
+
+typedef csci3081::SweepAndPrune::slot_pair slot_pair;
+
+/**
+ * @brief Give every slot of sap a random box, and return the pairs that
+ * overlap, found by testing all of them.
+ */
+std::vector<slot_pair> RandomBoxes(std::mt19937 *rng,
+    csci3081::SweepAndPrune *sap) {
+  std::uniform_real_distribution<double> corner(0, 500);
+  std::uniform_real_distribution<double> size(1, 40);
+  std::vector<double> boxes;
+  for (size_t slot = 0; slot < sap->get_size(); ++slot) {
+    double x = corner(*rng);
+    double y = corner(*rng);
+    boxes.insert(boxes.end(), {x, y, x + size(*rng), y + size(*rng)});
+    sap->set_box(slot, boxes[4 * slot], boxes[4 * slot + 1],
+      boxes[4 * slot + 2], boxes[4 * slot + 3]);
+  }
+  std::vector<slot_pair> pairs;
+  for (uint32_t a = 0; a < sap->get_size(); ++a) {
+    for (uint32_t b = a + 1; b < sap->get_size(); ++b) {
+      if (boxes[4 * a] <= boxes[4 * b + 2] &&
+          boxes[4 * b] <= boxes[4 * a + 2] &&
+          boxes[4 * a + 1] <= boxes[4 * b + 3] &&
+          boxes[4 * b + 1] <= boxes[4 * a + 3]) {
+        pairs.emplace_back(a, b);
+      }
+    }
+  }
+  return pairs;
+}
+
+/**
+ * @brief The poses of the entities of an arena with its lights piled in one
+ * corner, after some timesteps.
+ */
+std::vector<double> ClusteredPoses(csci3081::Broadphase broadphase) {
+  csci3081::arena_params params;
+  params.n_Lights = 60;
+  params.seed = 5;
+  params.broadphase = broadphase;
+  csci3081::Arena arena(&params);
+  const std::vector<csci3081::Light *> &lights = arena.get_lights();
+  for (size_t i = 0; i < lights.size(); ++i) {
+    lights[i]->set_position(100 + 25.0 * (i % 8), 100 + 25.0 * (i / 8));
+  }
+  for (int step = 0; step < 200; ++step) {
+    arena.AdvanceTime(0.05);
+  }
+  std::vector<double> poses;
+  for (auto ent : arena.get_entities()) {
+    poses.push_back(ent->get_pose().x);
+    poses.push_back(ent->get_pose().y);
+  }
+  return poses;
+}
+
+}  // namespace
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// The pairs found are the overlapping ones, also after the boxes move
+TEST(SweepAndPruneTest, findPairs) {
+  std::mt19937 rng(11);
+  csci3081::SweepAndPrune sap;
+  sap.Resize(300);
+  for (int round = 0; round < 3; ++round) {
+    std::vector<slot_pair> expected = RandomBoxes(&rng, &sap);
+    std::vector<slot_pair> found;
+    sap.FindPairs(&found);
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, expected) << "FAIL: findPairs - Wrong pairs in round "
+                               << round;
+  }
+
+  // a box moved after sorting is found where it is now
+  sap.MoveBox(7, 1000, 1000, 1010, 1010);
+  std::vector<uint32_t> near;
+  sap.QueryBox(1005, 1005, 1020, 1020, &near);
+  EXPECT_EQ(near, std::vector<uint32_t>{7})
+    << "FAIL: findPairs - Moved box not found";
+}
+
+// Sweep and prune finds the same collisions as brute force
+TEST(SweepAndPruneTest, sameAsBruteForce) {
+  EXPECT_EQ(ClusteredPoses(csci3081::kSweepAndPrune),
+    ClusteredPoses(csci3081::kBruteForce))
+    << "FAIL: sameAsBruteForce - The broadphases moved entities apart";
+}
+
+#endif
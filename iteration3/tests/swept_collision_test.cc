@@ -0,0 +1,157 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/robot.h"
+#include "../src/swept_collision.h"
+
+#ifdef SWEPT_COLLISION_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Circles closing in on each other report when they first touch, and
+// nothing when they cannot get closer
+TEST(SweptCollisionTest, circles) {
+  csci3081::Pose origin(0, 0);
+  EXPECT_NEAR(csci3081::SweptCircleTimeOfImpact(origin,
+    csci3081::Pose(100, 0), csci3081::Pose(100, 0), origin, 20), 0.4, 1e-12)
+    << "FAIL: circles - Head-on contact missed";
+
+  EXPECT_LT(csci3081::SweptCircleTimeOfImpact(origin, csci3081::Pose(50, 0),
+    csci3081::Pose(15, 0), csci3081::Pose(65, 0), 20), 0)
+    << "FAIL: circles - Already touching reported";
+  EXPECT_LT(csci3081::SweptCircleTimeOfImpact(origin, csci3081::Pose(50, 0),
+    csci3081::Pose(0, 30), csci3081::Pose(50, 30), 20), 0)
+    << "FAIL: circles - Parallel circles reported";
+  EXPECT_LT(csci3081::SweptCircleTimeOfImpact(origin, origin,
+    csci3081::Pose(30, 0), csci3081::Pose(60, 0), 20), 0)
+    << "FAIL: circles - Separating circles reported";
+  EXPECT_LT(csci3081::SweptCircleTimeOfImpact(origin, origin,
+    csci3081::Pose(0, 30), csci3081::Pose(100, 30), 20), 0)
+    << "FAIL: circles - Passing too far away reported";
+
+  // touching at the very end of the step
+  EXPECT_DOUBLE_EQ(csci3081::SweptCircleTimeOfImpact(origin, origin,
+    csci3081::Pose(30, 0), csci3081::Pose(20, 0), 20), 1)
+    << "FAIL: circles - Contact at t = 1 missed";
+  EXPECT_LT(csci3081::SweptCircleTimeOfImpact(origin, origin,
+    csci3081::Pose(30, 0), csci3081::Pose(21, 0), 20), 0)
+    << "FAIL: circles - Contact after the step reported";
+}
+
+// A coordinate reaches a wall from either side, at the end of the step or
+// not at all
+TEST(SweptCollisionTest, limits) {
+  EXPECT_DOUBLE_EQ(csci3081::SweptLimitTimeOfImpact(90, 110, 100, true), 0.5)
+    << "FAIL: limits - Right wall missed";
+  EXPECT_DOUBLE_EQ(csci3081::SweptLimitTimeOfImpact(110, 90, 100, false),
+    0.5) << "FAIL: limits - Left wall missed";
+  EXPECT_DOUBLE_EQ(csci3081::SweptLimitTimeOfImpact(90, 100, 100, true), 1)
+    << "FAIL: limits - Contact at t = 1 missed";
+  EXPECT_DOUBLE_EQ(csci3081::SweptLimitTimeOfImpact(100, 120, 100, true), 0)
+    << "FAIL: limits - Starting on the wall is not t = 0";
+  EXPECT_LT(csci3081::SweptLimitTimeOfImpact(90, 99, 100, true), 0)
+    << "FAIL: limits - Short of the wall reported";
+  EXPECT_LT(csci3081::SweptLimitTimeOfImpact(90, 80, 100, true), 0)
+    << "FAIL: limits - Moving away reported";
+
+  csci3081::Pose at = csci3081::InterpolatePosition(csci3081::Pose(0, 0, 10),
+    csci3081::Pose(100, -50, 30), 0.25);
+  EXPECT_DOUBLE_EQ(at.x, 25) << "FAIL: limits - Wrong x";
+  EXPECT_DOUBLE_EQ(at.y, -12.5) << "FAIL: limits - Wrong y";
+  EXPECT_DOUBLE_EQ(at.theta, 30) << "FAIL: limits - End heading not kept";
+}
+
+// Robots moving much further than their size each step stay inside the
+// walls
+TEST(SweptCollisionTest, arenaWalls) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  arena.set_step_size(50);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_heading(37.0 * i);
+    robots[i]->set_external_velocity(csci3081::WheelVelocity(10, 10));
+  }
+
+  for (int step = 0; step < 200; ++step) {
+    arena.AdvanceTime(0.5);
+    for (auto robot : robots) {
+      const csci3081::Pose &pose = robot->get_pose();
+      double radius = robot->get_radius();
+      ASSERT_TRUE(pose.x >= radius - 1e-9 && pose.x <= X_DIM - radius + 1e-9 &&
+        pose.y >= radius - 1e-9 && pose.y <= Y_DIM - radius + 1e-9)
+        << "FAIL: arenaWalls - Robot " << robot->get_id()
+        << " left the arena at step " << step;
+    }
+  }
+}
+
+// Two robots driving at each other stop at contact instead of passing
+// through
+TEST(SweptCollisionTest, arenaHeadOn) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  arena.set_step_size(50);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  // park the others out of the way
+  for (size_t i = 2; i < robots.size(); ++i) {
+    robots[i]->set_pose(csci3081::Pose(60 + 80.0 * i, 700));
+    robots[i]->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  }
+  csci3081::Robot *left = robots[0];
+  csci3081::Robot *right = robots[1];
+  left->set_pose(csci3081::Pose(300, 300, 0));
+  right->set_pose(csci3081::Pose(700, 300, 180));
+  left->set_external_velocity(csci3081::WheelVelocity(10, 10));
+  right->set_external_velocity(csci3081::WheelVelocity(10, 10));
+
+  for (int step = 0; step < 3; ++step) {
+    arena.AdvanceTime(0.5);
+    EXPECT_LT(left->get_pose().x, right->get_pose().x)
+      << "FAIL: arenaHeadOn - Robots passed through each other at step "
+      << step;
+  }
+}
+
+// A robot pushed into a corner by another robot it overlaps leaves both
+// walls
+TEST(SweptCollisionTest, arenaCorner) {
+  csci3081::arena_params params;
+  params.n_Lights = 0;
+  params.n_Foods = 0;
+  params.seed = 5;
+  csci3081::Arena arena(&params);
+  std::vector<csci3081::Robot *> robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_pose(csci3081::Pose(60 + 80.0 * i, 700));
+    robots[i]->set_external_velocity(csci3081::WheelVelocity(0, 0));
+  }
+  // robots[0] is resolved first, and moved up and right, away from
+  // robots[1]
+  csci3081::Robot *cornered = robots[0];
+  double radius = cornered->get_radius();
+  cornered->set_position(X_DIM - radius - 2, radius + 2);
+  robots[1]->set_position(cornered->get_pose().x - radius / std::sqrt(2.0),
+    cornered->get_pose().y + radius / std::sqrt(2.0));
+
+  arena.AdvanceTime(0.5);
+  EXPECT_LE(cornered->get_pose().x, X_DIM - radius)
+    << "FAIL: arenaCorner - Still in the right wall";
+  EXPECT_GE(cornered->get_pose().y, radius)
+    << "FAIL: arenaCorner - Still in the top wall";
+}
+
+#endif
@@ -0,0 +1,66 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+
+// Project code from the ../src directory
+#include "../src/tiled_world.h"
+
+#ifdef TILED_WORLD_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A robot that leaves its tile is moved to the neighbor, in its coordinates
+TEST(TiledWorldTest, migration) {
+  csci3081::world_params params;
+  params.columns = 2;
+  params.rows = 1;
+  params.tile.seed = 3;
+  params.n_threads = 1;
+  csci3081::TiledWorld world(params);
+  size_t n_mobile = world.get_mobile_count();
+
+  csci3081::Arena *left = world.get_tile(0, 0);
+  csci3081::Arena *right = world.get_tile(1, 0);
+  csci3081::Robot *robot = left->get_robots().front();
+  robot->set_position(left->get_x_dim() + 40, 300);
+  world.AdvanceTime(0.05);
+
+  const std::vector<csci3081::Robot *> &moved = right->get_robots();
+  EXPECT_NE(std::find(moved.begin(), moved.end(), robot), moved.end())
+    << "FAIL: migration - Robot not in the right tile";
+  EXPECT_LT(robot->get_pose().x, 100) << "FAIL: migration - Wrong position";
+  EXPECT_EQ(world.get_mobile_count(), n_mobile)
+    << "FAIL: migration - Entities lost";
+}
+
+// Entities near a border are seen as ghosts by the neighbor only
+TEST(TiledWorldTest, haloExchange) {
+  csci3081::world_params params;
+  params.columns = 2;
+  params.rows = 1;
+  params.tile.n_Lights = 0;
+  params.tile.n_Foods = 0;
+  params.tile.seed = 3;
+  params.n_threads = 1;
+  params.halo = 50;
+  csci3081::TiledWorld world(params);
+
+  csci3081::Arena *left = world.get_tile(0, 0);
+  csci3081::Arena *right = world.get_tile(1, 0);
+  // all robots of the left tile far from the border but one
+  for (auto robot : left->get_robots()) {
+    robot->set_position(100, 100);
+  }
+  for (auto robot : right->get_robots()) {
+    robot->set_position(right->get_x_dim() - 100, 100);
+  }
+  left->get_robots().front()->set_position(left->get_x_dim() - 20, 400);
+  world.AdvanceTime(0.05);
+
+  EXPECT_EQ(right->get_ghost_count(), 1u) << "FAIL: haloExchange - right";
+  EXPECT_EQ(left->get_ghost_count(), 0u) << "FAIL: haloExchange - left";
+}
+
+#endif
@@ -0,0 +1,116 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/timer_wheel.h"
+#include "../src/robot.h"
+
+#ifdef TIMER_WHEEL_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// A timer fires on the tick it is due and not before
+TEST(TimerWheelTest, firesWhenDue) {
+  csci3081::TimerWheel wheel;
+  int fired = 0;
+  wheel.Schedule(10, [&fired]() { fired++; });
+
+  wheel.Advance(9);
+  EXPECT_EQ(fired, 0) << "FAIL: firesWhenDue - Timer fired early";
+  wheel.Advance(1);
+  EXPECT_EQ(fired, 1) << "FAIL: firesWhenDue - Timer did not fire when due";
+  wheel.Advance(100);
+  EXPECT_EQ(fired, 1) << "FAIL: firesWhenDue - Timer fired more than once";
+}
+
+// Timers far enough away to be in the higher levels fire in expiry order
+TEST(TimerWheelTest, cascadesInOrder) {
+  csci3081::TimerWheel wheel;
+  std::vector<uint64_t> fired_at;
+  uint64_t delays[] = {5000, 63, 64, 4096, 300000, 1, 65};
+  for (uint64_t delay : delays) {
+    wheel.Schedule(delay, [&wheel, &fired_at]() {
+      fired_at.push_back(wheel.get_current_tick()); });
+  }
+  wheel.Advance(300000);
+
+  std::vector<uint64_t> expected = {1, 63, 64, 65, 4096, 5000, 300000};
+  EXPECT_EQ(fired_at, expected) <<
+    "FAIL: cascadesInOrder - Timers did not fire at their expiry";
+}
+
+// A cancelled timer never fires
+TEST(TimerWheelTest, cancel) {
+  csci3081::TimerWheel wheel;
+  int fired = 0;
+  csci3081::TimerWheel::TimerId id = wheel.Schedule(200, [&fired]() {
+    fired++; });
+
+  EXPECT_TRUE(wheel.Cancel(id)) << "FAIL: cancel - Timer was not pending";
+  wheel.Advance(500);
+  EXPECT_EQ(fired, 0) << "FAIL: cancel - Cancelled timer fired";
+  EXPECT_EQ(wheel.get_pending_count(), 0u) <<
+    "FAIL: cancel - Cancelled timer still pending";
+}
+
+// Robot hunger transitions happen at the same step the old counters did,
+// and a meal pushes them back
+TEST(TimerWheelTest, robotHunger) {
+  csci3081::TimerWheel wheel;
+  csci3081::Robot robot;
+  bool starved = false;
+  robot.set_starved_callback([&starved](csci3081::Robot *) {
+    starved = true; });
+  robot.set_timer_wheel(&wheel);
+
+  wheel.Advance(479);
+  EXPECT_FALSE(robot.get_hungry()) << "FAIL: robotHunger - Hungry too early";
+  wheel.Advance(1);
+  EXPECT_TRUE(robot.get_hungry()) << "FAIL: robotHunger - Not hungry at 480";
+
+  robot.Eat();
+  EXPECT_FALSE(robot.get_hungry()) << "FAIL: robotHunger - Meal ignored";
+  wheel.Advance(2399);
+  EXPECT_TRUE(robot.get_starving()) << "FAIL: robotHunger - Not starving";
+  EXPECT_FALSE(starved) << "FAIL: robotHunger - Starved too early";
+  wheel.Advance(1);
+  EXPECT_TRUE(robot.get_starved()) << "FAIL: robotHunger - Not starved";
+  EXPECT_TRUE(starved) << "FAIL: robotHunger - Starved callback not run";
+}
+
+// A robot eating every step keeps a single timer, and still gets hungry on
+// time once it stops, also after a meal between transitions
+TEST(TimerWheelTest, mealsKeepOneTimer) {
+  csci3081::TimerWheel wheel;
+  csci3081::Robot robot;
+  robot.set_timer_wheel(&wheel);
+  for (int tick = 0; tick < 3000; ++tick) {
+    robot.Eat();
+    wheel.Advance(1);
+    ASSERT_EQ(wheel.get_pending_count(), 1u)
+      << "FAIL: mealsKeepOneTimer - Timers piled up at tick " << tick;
+  }
+  EXPECT_FALSE(robot.get_hungry()) << "FAIL: mealsKeepOneTimer - Hungry";
+
+  robot.Eat();
+  wheel.Advance(479);
+  EXPECT_FALSE(robot.get_hungry())
+    << "FAIL: mealsKeepOneTimer - Hungry too early";
+  wheel.Advance(1);
+  EXPECT_TRUE(robot.get_hungry())
+    << "FAIL: mealsKeepOneTimer - Not hungry 480 after the last meal";
+
+  // the timer is now due at starving, later than the next hunger
+  wheel.Advance(20);
+  robot.Eat();
+  wheel.Advance(480);
+  EXPECT_TRUE(robot.get_hungry())
+    << "FAIL: mealsKeepOneTimer - Meal between transitions delayed hunger";
+  EXPECT_EQ(wheel.get_pending_count(), 1u)
+    << "FAIL: mealsKeepOneTimer - Timer not moved";
+}
+
+#endif
@@ -0,0 +1,288 @@
+// @copyright 2018 Dawood Khan
+// Google Test Framework
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Project code from the ../src directory
+#include "../src/arena.h"
+#include "../src/arena_params.h"
+#include "../src/light.h"
+#include "../src/sensor_falloff.h"
+#include "../src/vehicle_ensemble.h"
+#include "../src/vehicle_kernel.h"
+#include "../src/vehicle_population.h"
+
+#ifdef VEHICLE_KERNEL_TEST
+
+/*******************************************************************************
+ * Test Cases
+ ******************************************************************************/
+// Equal wheel velocities drive straight along the heading
+TEST(VehicleKernelTest, straightDrive) {
+  csci3081::BasicPose<float> pose{10, 20, 90};
+  csci3081::BasicPose<float> moved = csci3081::DifferentialDrive<float>(
+    pose, {4, 4}, 0.5f);
+  EXPECT_NEAR(moved.x, 10, 1e-4) << "FAIL: straightDrive - x";
+  EXPECT_NEAR(moved.y, 22, 1e-4) << "FAIL: straightDrive - y";
+  EXPECT_FLOAT_EQ(moved.theta, 90) << "FAIL: straightDrive - theta";
+}
+
+// A segment evaluated at any time is where the drive gets to in one step,
+// and an analytic light follows its segment
+TEST(VehicleKernelTest, analyticSegment) {
+  csci3081::BasicPose<double> start{10, 20, 30};
+  csci3081::BasicWheelVelocity<double> arc{-6, -3.5};
+  csci3081::MotionSegment<double> segment =
+    csci3081::BeginSegment(start, arc);
+  for (double t : {0.5, 3.0, 40.0}) {
+    csci3081::BasicPose<double> closed = csci3081::SegmentPose(segment, t);
+    csci3081::BasicPose<double> driven =
+      csci3081::DifferentialDrive(start, arc, t);
+    EXPECT_EQ(closed.x, driven.x) << "FAIL: analyticSegment - x at " << t;
+    EXPECT_EQ(closed.y, driven.y) << "FAIL: analyticSegment - y at " << t;
+  }
+
+  csci3081::Light stepped;
+  csci3081::Light analytic;
+  analytic.set_analytic(true);
+  for (csci3081::Light *light : {&stepped, &analytic}) {
+    light->set_pose(csci3081::Pose(100, 100, 45));
+    light->set_time(10);
+    for (int step = 0; step < 50; ++step) {
+      light->TimestepUpdate(1);
+    }
+  }
+  EXPECT_EQ(analytic.get_segment_time(), 50)
+    << "FAIL: analyticSegment - Segment restarted";
+  EXPECT_NEAR(analytic.get_pose().x, stepped.get_pose().x, 1e-9)
+    << "FAIL: analyticSegment - Light left the line";
+  EXPECT_NEAR(analytic.get_pose().y, stepped.get_pose().y, 1e-9)
+    << "FAIL: analyticSegment - Light left the line";
+  EXPECT_NEAR(analytic.PoseAt(25).x, 100 + 25 * std::sqrt(2.0), 1e-9)
+    << "FAIL: analyticSegment - Pose halfway";
+
+  // a pose set from outside begins a new segment
+  analytic.set_pose(csci3081::Pose(0, 0, 0));
+  analytic.TimestepUpdate(1);
+  EXPECT_EQ(analytic.get_segment_time(), 1)
+    << "FAIL: analyticSegment - Moved light kept its segment";
+  EXPECT_NEAR(analytic.get_pose().x, 2, 1e-12)
+    << "FAIL: analyticSegment - New segment";
+  // so does a heading set from outside, even one it already had
+  analytic.TimestepUpdate(1);
+  analytic.set_heading(analytic.get_heading());
+  analytic.TimestepUpdate(1);
+  EXPECT_EQ(analytic.get_segment_time(), 1)
+    << "FAIL: analyticSegment - Turned light kept its segment";
+}
+
+// Single and double precision populations stay close over a short run
+TEST(VehicleKernelTest, precisionsAgree) {
+  csci3081::population_params params;
+  params.n_vehicles = 64;
+  params.seed = 3;
+  csci3081::VehiclePopulation<float> single(params);
+  csci3081::VehiclePopulation<double> dual(params);
+  for (int step = 0; step < 20; ++step) {
+    single.Step(0.05f);
+    dual.Step(0.05);
+  }
+  for (size_t i = 0; i < dual.get_size(); ++i) {
+    csci3081::BasicPose<float> a = single.get_pose(i);
+    csci3081::BasicPose<double> b = dual.get_pose(i);
+    EXPECT_LT(dual.WrappedDistance(a.x, a.y, b.x, b.y), 0.1)
+      << "FAIL: precisionsAgree - vehicle " << i;
+  }
+}
+
+// Each lane of an ensemble steps exactly as its own population
+TEST(VehicleKernelTest, ensembleLanes) {
+  csci3081::population_params params;
+  params.n_vehicles = 64;
+  params.n_lights = 4;
+  params.seed = 5;
+  csci3081::VehicleEnsemble<double, 4> ensemble(params);
+  for (int step = 0; step < 20; ++step) {
+    ensemble.Step(0.05);
+  }
+  for (size_t lane = 0; lane < ensemble.get_lanes(); ++lane) {
+    params.seed = 5 + static_cast<unsigned int>(lane);
+    csci3081::VehiclePopulation<double> population(params);
+    for (int step = 0; step < 20; ++step) {
+      population.Step(0.05);
+    }
+    for (size_t i = 0; i < population.get_size(); ++i) {
+      EXPECT_EQ(ensemble.get_pose(lane, i).x, population.get_pose(i).x)
+        << "FAIL: ensembleLanes - lane " << lane << " vehicle " << i;
+      EXPECT_EQ(ensemble.get_pose(lane, i).theta,
+        population.get_pose(i).theta)
+        << "FAIL: ensembleLanes - lane " << lane << " vehicle " << i;
+    }
+  }
+}
+
+// Reordering along a Morton curve keeps ids and does not change the steps
+TEST(VehicleKernelTest, mortonOrder) {
+  csci3081::population_params params;
+  params.n_vehicles = 500;
+  params.x_dim = 500;
+  params.y_dim = 500;
+  params.neighbor_range = 40;
+  params.seed = 3;
+  csci3081::VehiclePopulation<double> unsorted(params);
+  params.sort_interval = 5;
+  csci3081::VehiclePopulation<double> sorted(params);
+  for (int step = 0; step < 30; ++step) {
+    unsorted.Step(0.05);
+    sorted.Step(0.05);
+  }
+
+  bool reordered = false;
+  unsigned int neighbors = 0;
+  for (uint32_t id = 0; id < params.n_vehicles; ++id) {
+    size_t index = sorted.get_index(id);
+    EXPECT_EQ(sorted.get_id(index), id) << "FAIL: mortonOrder - id map";
+    reordered = reordered || index != id;
+    neighbors += unsorted.get_neighbor_count(id);
+    EXPECT_EQ(sorted.get_neighbor_count(index),
+      unsorted.get_neighbor_count(id))
+      << "FAIL: mortonOrder - vehicle " << id << " counted differently";
+    EXPECT_EQ(sorted.get_pose(index).x, unsorted.get_pose(id).x)
+      << "FAIL: mortonOrder - vehicle " << id << " moved differently";
+    EXPECT_EQ(sorted.get_pose(index).y, unsorted.get_pose(id).y)
+      << "FAIL: mortonOrder - vehicle " << id << " moved differently";
+  }
+  EXPECT_TRUE(reordered) << "FAIL: mortonOrder - Not reordered";
+  EXPECT_GT(neighbors, 0u) << "FAIL: mortonOrder - No neighbors found";
+}
+
+// The falloff policies follow their curves, the tables to within their
+// sampling, and a population senses through the one it is given
+TEST(VehicleKernelTest, falloffModels) {
+  EXPECT_EQ(csci3081::PowerFalloff<double>()(1200, 37.5),
+    csci3081::SensorResponse(1200.0, 37.5, 1.08))
+    << "FAIL: falloffModels - Power is not the arena's response";
+  EXPECT_DOUBLE_EQ(csci3081::InverseSquareFalloff<double>()(100, 5), 4)
+    << "FAIL: falloffModels - Inverse square";
+  EXPECT_DOUBLE_EQ(csci3081::ExponentialFalloff<double>{50}(2, 50),
+    2 * std::exp(-1.0)) << "FAIL: falloffModels - Exponential";
+
+  csci3081::GaussianFalloff<float> gaussian{80};
+  csci3081::TabulatedFalloff<float> table =
+    csci3081::TabulatedFalloff<float>::Tabulate(gaussian, 500, 2048);
+  for (float distance = 0; distance < 600; distance += 7.3f) {
+    EXPECT_NEAR(table(10, distance), gaussian(10, std::min(distance, 500.0f)),
+      1e-3) << "FAIL: falloffModels - Table off at " << distance;
+  }
+
+  csci3081::TabulatedFalloff<double> piecewise({{100, 1}, {300, 0}}, 400,
+    401);
+  EXPECT_DOUBLE_EQ(piecewise(2, 50), 2)
+    << "FAIL: falloffModels - Not level before the first knot";
+  EXPECT_DOUBLE_EQ(piecewise(2, 250), 0.5)
+    << "FAIL: falloffModels - Not linear between knots";
+  EXPECT_DOUBLE_EQ(piecewise(2, 1000), 0)
+    << "FAIL: falloffModels - Not level past the table";
+
+  csci3081::population_params params;
+  params.n_vehicles = 64;
+  params.seed = 9;
+  csci3081::VehiclePopulation<double> power(params);
+  csci3081::VehiclePopulation<double, csci3081::PowerFalloff<double>>
+    squared(params, {2});
+  csci3081::VehiclePopulation<double, csci3081::InverseSquareFalloff<double>>
+    inverse_square(params);
+  for (int step = 0; step < 20; ++step) {
+    power.Step(0.05);
+    squared.Step(0.05);
+    inverse_square.Step(0.05);
+  }
+  bool differs = false;
+  for (size_t i = 0; i < params.n_vehicles; ++i) {
+    differs = differs || power.get_pose(i).x != squared.get_pose(i).x;
+    EXPECT_NEAR(squared.get_pose(i).x, inverse_square.get_pose(i).x, 1e-6)
+      << "FAIL: falloffModels - Vehicle " << i << " sensed differently";
+  }
+  EXPECT_TRUE(differs) << "FAIL: falloffModels - Falloff not used";
+}
+
+// Tables made from no knots, too few samples or no distance still give
+// finite readings
+TEST(VehicleKernelTest, tableEdgeCases) {
+  typedef csci3081::TabulatedFalloff<double>::knot knot;
+  csci3081::TabulatedFalloff<double> empty(std::vector<knot>(), 100);
+  EXPECT_EQ(empty(5, 0), 0) << "FAIL: tableEdgeCases - No knots not 0";
+  EXPECT_EQ(empty(5, 250), 0) << "FAIL: tableEdgeCases - No knots not 0";
+
+  csci3081::TabulatedFalloff<double> one({{0, 1}, {100, 0}}, 100, 1);
+  EXPECT_EQ(one.get_size(), 2u) << "FAIL: tableEdgeCases - Too few samples";
+  EXPECT_DOUBLE_EQ(one(2, 50), 1)
+    << "FAIL: tableEdgeCases - 2 samples not interpolated";
+  csci3081::TabulatedFalloff<double> none({{0, 1}, {100, 0}}, 100, 0);
+  EXPECT_EQ(none.get_size(), 2u) << "FAIL: tableEdgeCases - No samples";
+
+  csci3081::GaussianFalloff<double> gaussian{80};
+  double max_distances[] = {0, -10, std::nan("")};
+  for (double max_distance : max_distances) {
+    csci3081::TabulatedFalloff<double> flat =
+      csci3081::TabulatedFalloff<double>::Tabulate(gaussian, max_distance);
+    EXPECT_DOUBLE_EQ(flat(3, 0), 3) << "FAIL: tableEdgeCases - Max distance "
+                                    << max_distance << " not level";
+    EXPECT_DOUBLE_EQ(flat(3, 1e6), 3) << "FAIL: tableEdgeCases - Max "
+                                      << "distance " << max_distance
+                                      << " not level";
+    csci3081::TabulatedFalloff<double> knotted({{0, 0.5}, {10, 0}},
+      max_distance);
+    EXPECT_DOUBLE_EQ(knotted(2, 40), 1) << "FAIL: tableEdgeCases - Max "
+                                        << "distance " << max_distance
+                                        << " not the value at 0";
+  }
+}
+
+// An arena built with another falloff gives it to the sensors of every
+// robot, also of robots added later, and to the far field
+TEST(VehicleKernelTest, chosenFalloff) {
+  typedef csci3081::InverseSquareFalloff<double> InverseSquare;
+  csci3081::arena_params params;
+  params.n_Lights = 2;
+  params.n_Foods = 0;
+  params.seed = 3;
+  params.light_sensor_range = 200;
+  params.far_field_correction = true;
+  csci3081::Arena arena(&params);
+  arena.set_sensor_falloff(InverseSquare());
+  arena.AddRobot();
+  for (auto robot : arena.get_robots()) {
+    EXPECT_NE(dynamic_cast<csci3081::BasicLightSensor<InverseSquare> *>(
+      robot->get_left_lightsensor()), nullptr)
+      << "FAIL: chosenFalloff - Light sensor of robot " << robot->get_id();
+    EXPECT_NE(dynamic_cast<csci3081::BasicFoodSensor<InverseSquare> *>(
+      robot->get_right_foodsensor()), nullptr)
+      << "FAIL: chosenFalloff - Food sensor of robot " << robot->get_id();
+  }
+
+  csci3081::Sensor *sensor = arena.get_robots()[0]->get_left_lightsensor();
+  sensor->set_position(csci3081::Pose(100, 100));
+  sensor->Notify(csci3081::Pose(100, 120));
+  EXPECT_DOUBLE_EQ(sensor->get_reading(), 1200.0 / (20 * 20))
+    << "FAIL: chosenFalloff - Not an inverse square reading";
+
+  // both lights are out of range, so the robot only reads their far field
+  const std::vector<csci3081::Robot *> &robots = arena.get_robots();
+  for (size_t i = 0; i < robots.size(); ++i) {
+    robots[i]->set_position(100 + 80.0 * i, 700);
+  }
+  robots[0]->set_position(200, 200);
+  arena.get_lights()[0]->set_position(900, 600);
+  arena.get_lights()[1]->set_position(900, 650);
+  arena.AdvanceTime(0.05);
+  arena.AdvanceTime(0.05);
+  double far_field = csci3081::MeanFarReading(InverseSquare(), params.x_dim,
+    params.y_dim, params.light_sensor_range);
+  EXPECT_NEAR(robots[0]->get_last_light_reading(), 2 * 1200 * far_field,
+    1e-12) << "FAIL: chosenFalloff - Far field not from the falloff";
+}
+
+#endif